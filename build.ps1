@@ -60,11 +60,24 @@ $emccArgs = @(
     "-o", "web/public/main.js",
     "-s", "SHARED_MEMORY=1",
     "-s", "USE_PTHREADS=1",
+    # 미리 띄워 둘 pthread 수는 Module.diffPthreadPoolSize 가 있으면 그 값
+    # (web/public/diff-worker.js 는 워커마다 인스턴스를 따로 올리므로 0 으로 둠)
+    "-s", "PTHREAD_POOL_SIZE=Module.diffPthreadPoolSize??navigator.hardwareConcurrency",
     "-s", "EXPORTED_FUNCTIONS=$($env:EXPORTED_FUNCTIONS)",
     "-s", "EXPORTED_RUNTIME_METHODS=$($env:EXPORTED_RUNTIME_METHODS)",
     "-s", "ALLOW_MEMORY_GROWTH=1"
 )
 
+# DIFF_STATS=1 이면 단계별 측정 카운터(diff_get_stats)를 넣어서 빌드
+if ($env:DIFF_STATS -eq "1") {
+    $emccArgs += "-DDIFF_STATS"
+}
+
+# WASM_SIMD=0 이 아니면 simd128 을 켜서 빌드 (줄 / 단어 분할 스캐너가 16 바이트씩 비교)
+if ($env:WASM_SIMD -ne "0") {
+    $emccArgs += "-msimd128"
+}
+
 & $EMCC_CMD @emccArgs
 
 if ($LASTEXITCODE -ne 0) {
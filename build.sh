@@ -47,15 +47,31 @@ load_env
 
 EMCC_CMD="emcc"
 
-EXPORTED_FUNCTIONS="${EXPORTED_FUNCTIONS:-[\"_diff_text\",\"_malloc\",\"_free\"]}"
+EXPORTED_FUNCTIONS="${EXPORTED_FUNCTIONS:-[\"_diff_text\",\"_diff_text_ex\",\"_diff_text_binary\",\"_diff_set_threads\",\"_diff_stream_create\",\"_diff_stream_feed_base\",\"_diff_stream_feed_compare\",\"_diff_stream_finish\",\"_diff_stream_drain\",\"_diff_stream_destroy\",\"_diff_get_stats\",\"_diff_set_budget\",\"_diff_set_context\",\"_diff_create\",\"_diff_run\",\"_diff_result_ptr\",\"_diff_result_size\",\"_diff_result_degraded\",\"_diff_release\",\"_diff_index_create\",\"_diff_index_run\",\"_diff_index_run_batch\",\"_diff_index_result_ptr\",\"_diff_index_result_size\",\"_diff_index_memo_hits\",\"_diff_index_release\",\"_diff_lazy_create\",\"_diff_lazy_row_count\",\"_diff_lazy_ops\",\"_diff_lazy_rows\",\"_diff_lazy_rows_ptr\",\"_diff_lazy_degraded\",\"_diff_lazy_release\",\"_diff_delta_encode\",\"_diff_delta_ptr\",\"_diff_delta_apply\",\"_diff_delta_target_ptr\",\"_diff_incremental_create\",\"_diff_incremental_rows\",\"_diff_incremental_edit\",\"_diff_incremental_result_ptr\",\"_diff_incremental_row_count\",\"_diff_incremental_release\",\"_malloc\",\"_free\"]}"
 EXPORTED_RUNTIME_METHODS="${EXPORTED_RUNTIME_METHODS:-[\"ccall\",\"cwrap\",\"allocateUTF8\",\"UTF8ToString\"]}"
 
+# DIFF_STATS=1 이면 단계별 측정 카운터(diff_get_stats)를 넣어서 빌드
+STATS_FLAGS=""
+if [ "${DIFF_STATS:-0}" = "1" ]; then
+    STATS_FLAGS="-DDIFF_STATS"
+fi
+
+# WASM_SIMD=0 이 아니면 simd128 을 켜서 빌드 (줄 / 단어 분할 스캐너가 16 바이트씩 비교)
+SIMD_FLAGS="-msimd128"
+if [ "${WASM_SIMD:-1}" = "0" ]; then
+    SIMD_FLAGS=""
+fi
+
+# 미리 띄워 둘 pthread 수는 Module.diffPthreadPoolSize 가 있으면 그 값
+# (web/public/diff-worker.js 는 워커마다 인스턴스를 따로 올리므로 0 으로 둠)
+
 echo "${YELLOW}Build C++ code...${RESET}"
 
-$EMCC_CMD cpp/src/main.cpp -o web/public/main.js \
+$EMCC_CMD cpp/src/main.cpp -o web/public/main.js $STATS_FLAGS $SIMD_FLAGS \
   -pthread \
   -s SHARED_MEMORY=1 \
   -s USE_PTHREADS=1 \
+  -s PTHREAD_POOL_SIZE="Module.diffPthreadPoolSize??navigator.hardwareConcurrency" \
   -s EXPORTED_FUNCTIONS="$EXPORTED_FUNCTIONS" \
   -s EXPORTED_RUNTIME_METHODS="$EXPORTED_RUNTIME_METHODS" \
   -s ALLOW_MEMORY_GROWTH=1 &
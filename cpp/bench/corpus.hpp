@@ -0,0 +1,215 @@
+// ------------------------------------------------------------
+// 벤치마크용 합성 입력(corpus) 생성기
+// ------------------------------------------------------------
+// 고정된 seed 의 난수로 (기준, 변경) 텍스트 쌍을 만든다. 같은 빌드든 다른 빌드든
+// 같은 이름의 케이스는 항상 같은 바이트가 나오므로 결과를 그대로 비교할 수 있다.
+//
+//   - 크기       : 1k / 10k / 100k 줄
+//   - 편집 밀도  : 0.1% / 1% / 10% 줄 (단어 교체, 줄 삭제, 줄 추가)
+//   - 줄 길이    : 짧은 줄(단어 4개 안팎) / 긴 줄(단어 40개 안팎)
+//   - 한글       : 테스트 6 처럼 "창8:7 ..." 형식의 한글 문장
+//   - 병리적 입력 : 양쪽이 완전히 다른 입력, 몇 종류의 줄만 반복되는 입력
+// ------------------------------------------------------------
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+enum class CorpusText {
+    Ascii,
+    Korean,
+    Repeated,   // 4 종류의 줄만 반복
+};
+
+struct CorpusCase {
+    std::string name;
+    std::string base;
+    std::string changed;
+    size_t lines = 0;
+    double density = 0.0;  // 편집된 줄 비율 (AllDifferent 는 1)
+};
+
+// ------------------------------------------------------------
+// 줄 생성기
+// ------------------------------------------------------------
+class CorpusWriter {
+public:
+    explicit CorpusWriter(uint64_t seed) : random_(seed) {}
+
+    std::string line(CorpusText text, size_t words) {
+        switch (text) {
+            case CorpusText::Korean: return koreanLine(words);
+            case CorpusText::Repeated: return repeatedLine();
+            default: return asciiLine(words);
+        }
+    }
+
+    // std::uniform_*_distribution 은 표준 라이브러리마다 결과가 달라서 직접 변환
+    size_t below(size_t limit) { return static_cast<size_t>(random_() % limit); }
+    double unit() { return static_cast<double>(random_() >> 11) * 0x1.0p-53; }
+
+    // 줄 안의 단어 하나를 바꿈 (replace row + 토큰 diff 를 만들기 위함)
+    std::string modify(const std::string& line, CorpusText text) {
+        size_t spaces = 0;
+        for (char c : line) spaces += (c == ' ');
+        size_t target = below(spaces + 1);
+
+        std::string out;
+        size_t word = 0;
+        size_t i = 0;
+        while (i <= line.size()) {
+            size_t end = line.find(' ', i);
+            if (end == std::string::npos) end = line.size();
+            if (word > 0) out += ' ';
+            out += (word == target) ? this->word(text) : line.substr(i, end - i);
+            ++word;
+            i = end + 1;
+        }
+        return out;
+    }
+
+private:
+    std::mt19937_64 random_;
+
+    std::string word(CorpusText text) {
+        if (text == CorpusText::Korean) return koreanWord();
+        static const char* const words[] = {
+            "alpha", "beta", "gamma", "delta", "value", "return", "const", "int", "std::vector", "index",
+            "buffer", "result", "line", "token", "diff", "{", "}", "=", "+=", "if", "for", "while", "0", "1",
+        };
+        return words[below(sizeof(words) / sizeof(words[0]))];
+    }
+
+    std::string asciiLine(size_t words) {
+        size_t count = words / 2 + below(words + 1);
+        std::string out;
+        for (size_t w = 0; w < count; ++w) {
+            if (w) out += ' ';
+            out += word(CorpusText::Ascii);
+        }
+        // 줄마다 달라지도록 번호를 붙임 (실제 코드처럼 대부분의 줄이 유일)
+        out += " //" + std::to_string(below(1u << 30));
+        return out;
+    }
+
+    // UTF-8 한글 음절 (U+AC00 ~ U+D7A3)
+    void appendSyllable(std::string& out) {
+        uint32_t cp = 0xAC00 + static_cast<uint32_t>(below(11172));
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+
+    std::string koreanWord() {
+        std::string out;
+        size_t length = 1 + below(4);
+        for (size_t s = 0; s < length; ++s) appendSyllable(out);
+        return out;
+    }
+
+    std::string koreanLine(size_t words) {
+        std::string out = "창" + std::to_string(1 + below(50)) + ":" + std::to_string(1 + below(30));
+        size_t count = words / 2 + below(words + 1);
+        for (size_t w = 0; w < count; ++w) {
+            out += ' ';
+            out += koreanWord();
+        }
+        return out;
+    }
+
+    std::string repeatedLine() {
+        static const char* const lines[] = {"}", "", "    return 0;", "{"};
+        return lines[below(4)];
+    }
+};
+
+// ------------------------------------------------------------
+// 기준 텍스트를 만들고 density 비율만큼 줄을 고쳐 변경 텍스트를 만든다
+//   편집 하나는 단어 교체(50%), 줄 삭제(25%), 줄 추가(25%) 중 하나
+// ------------------------------------------------------------
+inline CorpusCase makeEditedCase(std::string name, CorpusText text, size_t lines, size_t words, double density,
+                                 uint64_t seed) {
+    CorpusWriter writer(seed);
+    CorpusCase c;
+    c.name = std::move(name);
+    c.lines = lines;
+    c.density = density;
+
+    for (size_t i = 0; i < lines; ++i) {
+        std::string line = writer.line(text, words);
+        c.base += line;
+        c.base += '\n';
+
+        if (writer.unit() >= density) {
+            c.changed += line;
+            c.changed += '\n';
+            continue;
+        }
+        double kind = writer.unit();
+        if (kind < 0.5) {
+            c.changed += writer.modify(line, text);
+            c.changed += '\n';
+        } else if (kind < 0.75) {
+            // 삭제
+        } else {
+            c.changed += line;
+            c.changed += '\n';
+            c.changed += writer.line(text, words);
+            c.changed += '\n';
+        }
+    }
+    return c;
+}
+
+// 양쪽에 같은 줄이 하나도 없는 입력
+inline CorpusCase makeAllDifferentCase(std::string name, size_t lines, size_t words, uint64_t seed) {
+    CorpusWriter writer(seed);
+    CorpusCase c;
+    c.name = std::move(name);
+    c.lines = lines;
+    c.density = 1.0;
+    for (size_t i = 0; i < lines; ++i) {
+        c.base += "a " + writer.line(CorpusText::Ascii, words) + '\n';
+        c.changed += "b " + writer.line(CorpusText::Ascii, words) + '\n';
+    }
+    return c;
+}
+
+// "short/10000/0.01" 형식의 케이스 이름
+inline std::string corpusCaseName(const char* kind, size_t lines, double density) {
+    char text[64];
+    std::snprintf(text, sizeof(text), "%s/%zu/%g", kind, lines, density);
+    return text;
+}
+
+// ------------------------------------------------------------
+// 전체 케이스 목록
+//   quick 이면 100k 줄 케이스를 빼서 CI 에서도 빨리 돌 수 있게 한다
+// ------------------------------------------------------------
+inline std::vector<CorpusCase> generateCorpus(bool quick) {
+    std::vector<CorpusCase> cases;
+    uint64_t seed = 1;
+
+    const size_t sizes[] = {1000, 10000, 100000};
+    const double densities[] = {0.001, 0.01, 0.1};
+    for (size_t lines : sizes) {
+        if (quick && lines > 10000) continue;
+        for (double density : densities) {
+            cases.push_back(makeEditedCase(corpusCaseName("short", lines, density), CorpusText::Ascii, lines, 4,
+                                           density, seed++));
+        }
+    }
+
+    size_t mid = quick ? 2000 : 10000;
+    cases.push_back(makeEditedCase(corpusCaseName("long", mid, 0.01), CorpusText::Ascii, mid, 40, 0.01, seed++));
+    cases.push_back(makeEditedCase(corpusCaseName("long", mid, 0.1), CorpusText::Ascii, mid, 40, 0.1, seed++));
+    cases.push_back(makeEditedCase(corpusCaseName("korean", mid, 0.1), CorpusText::Korean, mid, 12, 0.1, seed++));
+    cases.push_back(makeAllDifferentCase(corpusCaseName("all-different", mid, 1), mid, 6, seed++));
+    cases.push_back(makeEditedCase(corpusCaseName("repeated", 2000, 0.1), CorpusText::Repeated, 2000, 0, 0.1,
+                                   seed++));
+    return cases;
+}
@@ -0,0 +1,385 @@
+// ------------------------------------------------------------
+// diff 엔진 벤치마크
+// ------------------------------------------------------------
+//   diff_bench [--quick] [--filter=TEXT] [--iterations=N] [--threads=N]
+//              [--baseline=FILE] [--threshold=0.1] [--write-corpus=DIR]
+//
+// corpus.hpp 의 합성 입력마다 단계별로 따로 잰다.
+//   split               : 줄 분할 (splitLineViews)
+//   intern              : 줄 분할 + 줄 ID 부여 (internLines)
+//   intern/crlf, space  : 위와 같음, 줄 끝 '\r' 무시 / 공백 개수 + 대소문자 무시 정규화
+//   line_diff/<알고리즘> : 줄 단위 diff (runLineDiff, myers 는 myersDiff)
+//   tokens/word, char   : replace 줄의 토큰 diff JSON (makeWordTokensJSON)
+//   serialize/json      : row 목록 -> JSON (appendRowsJson)
+//   end_to_end/json     : diff_text_impl 전체
+//   end_to_end/folded   : diff_text_impl 전체, 같은 줄 접기(context 3)
+//   end_to_end/binary   : diff_text_binary_impl 전체
+//   end_to_end/index    : 미리 만든 BaseIndex 로 변경 텍스트만 diff (결과 기억 끔)
+//   end_to_end/lazy     : LazyDiffResult 생성 + 첫 화면(200 row) JSON
+//   incremental/edit    : 만들어 둔 IncrementalDiff 에서 가운데 한 줄 고치기 + 바뀐 row JSON
+//   delta/encode        : 기준 -> 변경 바이너리 델타 (DeltaEncoder, varint)
+//   delta/apply         : 위 델타를 기준에 적용 + 검사 값 확인 (applyDelta)
+//   delta/corrupt       : 헤더의 대상 길이가 깨진 델타를 거부 (applyDelta 가 Corrupt 를 돌려줘야 함)
+//
+// 결과는 한 줄에 JSON 객체 하나(JSON Lines)로 stdout 에 쓴다. 저장해 둔 결과를
+// --baseline 으로 넘기면 p50 이 threshold 보다 많이 느려진 항목을 stderr 에 알리고
+// 종료 코드 1 을 돌려준다.
+//
+// 최대 메모리는 operator new/delete 를 바꿔 측정 구간의 힙 사용량 최댓값을 잰다.
+// ------------------------------------------------------------
+#ifndef DIFF_NO_MAIN
+#define DIFF_NO_MAIN
+#endif
+#include "../src/main.cpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#include "corpus.hpp"
+
+// ------------------------------------------------------------
+// 힙 사용량 추적
+//   할당 앞 16바이트에 크기를 적어 두고 delete 때 빼 준다 (16바이트 정렬 유지)
+// ------------------------------------------------------------
+static std::atomic<size_t> heapCurrent{0};
+static std::atomic<size_t> heapPeak{0};
+
+void* operator new(size_t size) {
+    constexpr size_t header = 16;
+    void* block = std::malloc(size + header);
+    if (!block) throw std::bad_alloc();
+    *static_cast<size_t*>(block) = size;
+
+    size_t now = heapCurrent.fetch_add(size, std::memory_order_relaxed) + size;
+    size_t peak = heapPeak.load(std::memory_order_relaxed);
+    while (now > peak && !heapPeak.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {
+    }
+    return static_cast<char*>(block) + header;
+}
+
+void operator delete(void* ptr) noexcept {
+    if (!ptr) return;
+    void* block = static_cast<char*>(ptr) - 16;
+    heapCurrent.fetch_sub(*static_cast<size_t*>(block), std::memory_order_relaxed);
+    std::free(block);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+
+// ------------------------------------------------------------
+// 측정
+// ------------------------------------------------------------
+struct BenchConfig {
+    bool quick = false;
+    int iterations = 0;          // 0 = 자동 (최소 5회, 0.2초 이상, 최대 200회)
+    int threads = 1;
+    std::string filter;
+    std::string baselinePath;
+    double threshold = 0.1;      // baseline 대비 p50 이 이만큼(10%) 넘게 느려지면 회귀
+    std::string corpusDir;
+};
+
+struct BenchResult {
+    std::string caseName;
+    std::string bench;
+    size_t bytes = 0;
+    size_t lines = 0;
+    std::vector<double> samples;  // ms
+    size_t peakHeapBytes = 0;
+    const char* skipped = nullptr;
+};
+
+// 결과가 최적화로 사라지지 않도록 모아 두는 값
+static volatile size_t benchSink = 0;
+
+static double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t rank = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+template <typename Fn>
+static void measure(const BenchConfig& config, BenchResult& result, Fn&& fn) {
+    using Clock = std::chrono::steady_clock;
+    benchSink = benchSink + fn();  // 워밍업
+
+    size_t heapStart = heapCurrent.load();
+    heapPeak.store(heapStart);
+
+    const int minIterations = config.iterations > 0 ? config.iterations : 5;
+    const int maxIterations = config.iterations > 0 ? config.iterations : 200;
+    double total = 0.0;
+    for (int i = 0; i < maxIterations; ++i) {
+        auto start = Clock::now();
+        benchSink = benchSink + fn();
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        result.samples.push_back(ms);
+        total += ms;
+        if (i + 1 >= minIterations && total >= 200.0) break;
+    }
+    result.peakHeapBytes = heapPeak.load() - heapStart;
+}
+
+static void printResult(const BenchResult& result) {
+    if (result.skipped) {
+        std::printf("{\"case\":\"%s\",\"bench\":\"%s\",\"skipped\":\"%s\"}\n", result.caseName.c_str(),
+                    result.bench.c_str(), result.skipped);
+        return;
+    }
+    std::vector<double> sorted = result.samples;
+    std::sort(sorted.begin(), sorted.end());
+    double mean = 0.0;
+    for (double ms : sorted) mean += ms;
+    mean /= static_cast<double>(sorted.size());
+    double p50 = percentile(sorted, 0.5);
+    double mbPerSecond = p50 > 0.0 ? (static_cast<double>(result.bytes) / (1024.0 * 1024.0)) / (p50 / 1000.0) : 0.0;
+
+    std::printf("{\"case\":\"%s\",\"bench\":\"%s\",\"bytes\":%zu,\"lines\":%zu,\"iterations\":%zu,"
+                "\"min_ms\":%.4f,\"mean_ms\":%.4f,\"p50_ms\":%.4f,\"p90_ms\":%.4f,\"p99_ms\":%.4f,"
+                "\"mb_per_s\":%.2f,\"peak_heap_bytes\":%zu}\n",
+                result.caseName.c_str(), result.bench.c_str(), result.bytes, result.lines, sorted.size(),
+                sorted.front(), mean, p50, percentile(sorted, 0.9), percentile(sorted, 0.99), mbPerSecond,
+                result.peakHeapBytes);
+    std::fflush(stdout);
+}
+
+// ------------------------------------------------------------
+// baseline 비교
+//   같은 프로그램이 쓴 JSON Lines 만 읽으므로 필요한 키만 문자열로 찾는다
+// ------------------------------------------------------------
+static std::string jsonField(const std::string& line, const char* key) {
+    std::string pattern = std::string("\"") + key + "\":";
+    size_t at = line.find(pattern);
+    if (at == std::string::npos) return {};
+    at += pattern.size();
+    if (line[at] == '"') {
+        size_t end = line.find('"', at + 1);
+        return line.substr(at + 1, end - at - 1);
+    }
+    size_t end = line.find_first_of(",}", at);
+    return line.substr(at, end - at);
+}
+
+static std::map<std::string, double> loadBaseline(const std::string& path) {
+    std::map<std::string, double> baseline;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        std::string p50 = jsonField(line, "p50_ms");
+        if (p50.empty()) continue;
+        baseline[jsonField(line, "case") + " " + jsonField(line, "bench")] = std::atof(p50.c_str());
+    }
+    return baseline;
+}
+
+// ------------------------------------------------------------
+// 케이스 하나 실행
+// ------------------------------------------------------------
+// 기존 Myers 는 D 마다 V 를 저장하므로 (O(D^2) 메모리) 편집이 많은 큰 입력은 건너뜀
+static bool classicMyersFeasible(const CorpusCase& c) {
+    return static_cast<double>(c.lines) * c.density <= 2000.0;
+}
+
+static void runCase(const BenchConfig& config, const CorpusCase& c, std::vector<BenchResult>& results) {
+    const size_t bytes = c.base.size() + c.changed.size();
+    auto run = [&](const std::string& bench, auto&& fn, const char* skipped = nullptr) {
+        std::string fullName = c.name + " " + bench;
+        if (!config.filter.empty() && fullName.find(config.filter) == std::string::npos) return;
+
+        BenchResult result;
+        result.caseName = c.name;
+        result.bench = bench;
+        result.bytes = bytes;
+        result.lines = c.lines;
+        result.skipped = skipped;
+        if (!skipped) measure(config, result, fn);
+        printResult(result);
+        results.push_back(std::move(result));
+    };
+
+    run("split", [&] {
+        return splitLineViews(std::string_view(c.base)).size() + splitLineViews(std::string_view(c.changed)).size();
+    });
+    run("intern", [&] { return static_cast<size_t>(internLines(c.base.c_str(), c.changed.c_str()).idCount); });
+    auto internNormalized = [&](uint32_t normalize) {
+        return static_cast<size_t>(internLines(c.base.c_str(), c.changed.c_str(), normalize).idCount);
+    };
+    run("intern/crlf", [&] { return internNormalized(LINE_IGNORE_TRAILING_CR); });
+    run("intern/space", [&] { return internNormalized(LINE_IGNORE_SPACE_CHANGE | LINE_IGNORE_CASE); });
+
+    InternedLines lines = internLines(c.base.c_str(), c.changed.c_str());
+    const bool myersOk = classicMyersFeasible(c);
+    const std::pair<const char*, DiffAlgorithm> algorithms[] = {
+        {"line_diff/myers", DiffAlgorithm::Myers},
+        {"line_diff/myers-linear", DiffAlgorithm::MyersLinear},
+        {"line_diff/patience", DiffAlgorithm::Patience},
+        {"line_diff/histogram", DiffAlgorithm::Histogram},
+    };
+    for (const auto& [bench, algorithm] : algorithms) {
+        DiffOptions options;
+        options.algorithm = algorithm;
+        options.threads = config.threads;
+        bool skip = algorithm == DiffAlgorithm::Myers && !myersOk;
+        run(bench, [&] { return runLineDiff(lines, options).size(); }, skip ? "O(D^2) trace too large" : nullptr);
+    }
+
+    // 토큰 / 직렬화는 같은 row 목록을 사용 (선형 Myers 결과는 Myers 와 같음)
+    DiffOptions rowOptions;
+    rowOptions.algorithm = DiffAlgorithm::MyersLinear;
+    std::vector<DiffRow> rows = buildRows(runLineDiff(lines, rowOptions));
+    std::vector<std::pair<std::string_view, std::string_view>> replaced;
+    for (const DiffRow& row : rows) {
+        if (row.op == RowOp::Replace) replaced.emplace_back(lines.aLines[row.leftIndex], lines.bLines[row.rightIndex]);
+    }
+
+    run("tokens/word", [&] {
+        size_t total = 0;
+        for (const auto& [left, right] : replaced) total += makeWordTokensJSON(left, right, TokenMode::Word).size();
+        return total;
+    });
+    run("tokens/char", [&] {
+        size_t total = 0;
+        for (const auto& [left, right] : replaced) total += makeWordTokensJSON(left, right, TokenMode::Char).size();
+        return total;
+    });
+
+    std::string json;
+    run("serialize/json", [&] {
+        json.clear();
+        bool firstRow = true;
+        appendRowsJson(json, rows, lines.aLines, lines.bLines, firstRow);
+        return json.size();
+    });
+
+    const char* e2eSkip = myersOk ? nullptr : "O(D^2) trace too large";
+    run("end_to_end/json", [&] { return strlen(diff_text_impl(c.base.c_str(), c.changed.c_str())); }, e2eSkip);
+    DiffOptions folded;
+    folded.context = 3;
+    run("end_to_end/folded", [&] { return strlen(diff_text_impl(c.base.c_str(), c.changed.c_str(), folded)); },
+        e2eSkip);
+    run("end_to_end/binary",
+        [&] { return static_cast<size_t>(diff_text_binary_impl(c.base.c_str(), c.changed.c_str())[6]); }, e2eSkip);
+
+    BaseIndex index(c.base);
+    index.setMemoLimit(0);
+    run("end_to_end/index", [&] { return index.run(std::string_view(c.changed)) + index.resultSize(0); }, e2eSkip);
+    run("end_to_end/lazy", [&] {
+        LazyDiffResult lazy(c.base, c.changed);
+        return lazy.range(0, 200);
+    }, e2eSkip);
+
+    // 같은 줄을 번갈아 두 내용으로 바꾸므로 반복해도 결과 크기가 그대로
+    IncrementalDiff incremental(c.base, c.changed);
+    size_t editLine = lines.bLines.size() / 2;
+    bool edited = false;
+    run("incremental/edit", [&] {
+        edited = !edited;
+        std::string_view text = edited ? "incremental bench line\n" : "incremental bench line (again)\n";
+        return incremental.edit(INCREMENTAL_SIDE_CHANGED, editLine, editLine + 1, text);
+    });
+
+    DeltaEncoder deltaEncoder;
+    run("delta/encode", [&] { return deltaEncoder.encode(c.base, c.changed, DELTA_FLAG_VARINT).size(); });
+    // --filter 로 delta/encode 를 건너뛰어도 적용 / 거부 측정에는 델타가 필요
+    std::vector<uint8_t> delta = deltaEncoder.encode(c.base, c.changed, DELTA_FLAG_VARINT);
+    std::string rebuilt;
+    run("delta/apply", [&] {
+        return applyDelta(c.base, delta.data(), delta.size(), rebuilt) == DeltaStatus::Ok ? rebuilt.size() : 0;
+    });
+    std::vector<uint8_t> corrupt = delta;
+    corrupt[20] ^= 0x40;  // 대상 길이 + 256 GB
+    if (applyDelta(c.base, corrupt.data(), corrupt.size(), rebuilt) != DeltaStatus::Corrupt) {
+        std::fprintf(stderr, "%s: delta with a corrupt target length was not rejected\n", c.name.c_str());
+        std::exit(1);
+    }
+    run("delta/corrupt", [&] {
+        return static_cast<size_t>(applyDelta(c.base, corrupt.data(), corrupt.size(), rebuilt));
+    });
+}
+
+static void writeCorpus(const std::string& dir, const std::vector<CorpusCase>& cases) {
+    for (const CorpusCase& c : cases) {
+        std::string stem = c.name;
+        std::replace(stem.begin(), stem.end(), '/', '_');
+        std::ofstream(dir + "/" + stem + ".base.txt", std::ios::binary) << c.base;
+        std::ofstream(dir + "/" + stem + ".changed.txt", std::ios::binary) << c.changed;
+        std::fprintf(stderr, "wrote %s/%s.{base,changed}.txt\n", dir.c_str(), stem.c_str());
+    }
+}
+
+static bool parseBenchArgs(int argc, char** argv, BenchConfig& config) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&](const char* prefix) { return arg.substr(std::strlen(prefix)); };
+        if (arg == "--quick") config.quick = true;
+        else if (arg.rfind("--filter=", 0) == 0) config.filter = value("--filter=");
+        else if (arg.rfind("--iterations=", 0) == 0) config.iterations = std::atoi(value("--iterations=").c_str());
+        else if (arg.rfind("--threads=", 0) == 0) config.threads = std::atoi(value("--threads=").c_str());
+        else if (arg.rfind("--baseline=", 0) == 0) config.baselinePath = value("--baseline=");
+        else if (arg.rfind("--threshold=", 0) == 0) config.threshold = std::atof(value("--threshold=").c_str());
+        else if (arg.rfind("--write-corpus=", 0) == 0) config.corpusDir = value("--write-corpus=");
+        else {
+            std::fprintf(stderr,
+                         "usage: diff_bench [--quick] [--filter=TEXT] [--iterations=N] [--threads=N]\n"
+                         "                  [--baseline=FILE] [--threshold=0.1] [--write-corpus=DIR]\n");
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    BenchConfig config;
+    if (!parseBenchArgs(argc, argv, config)) return 2;
+
+    std::vector<CorpusCase> cases = generateCorpus(config.quick);
+    if (!config.corpusDir.empty()) {
+        writeCorpus(config.corpusDir, cases);
+        return 0;
+    }
+
+    std::vector<BenchResult> results;
+    for (const CorpusCase& c : cases) runCase(config, c, results);
+
+#if defined(__unix__) || defined(__APPLE__)
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    std::printf("{\"summary\":true,\"benchmarks\":%zu,\"max_rss_kb\":%ld}\n", results.size(),
+                static_cast<long>(usage.ru_maxrss));
+#endif
+
+    if (config.baselinePath.empty()) return 0;
+
+    std::map<std::string, double> baseline = loadBaseline(config.baselinePath);
+    int regressions = 0;
+    for (const BenchResult& result : results) {
+        if (result.skipped) continue;
+        auto it = baseline.find(result.caseName + " " + result.bench);
+        if (it == baseline.end() || it->second <= 0.0) continue;
+
+        std::vector<double> sorted = result.samples;
+        std::sort(sorted.begin(), sorted.end());
+        double p50 = percentile(sorted, 0.5);
+        if (p50 > it->second * (1.0 + config.threshold)) {
+            std::fprintf(stderr, "regression: %s %s p50 %.4f ms (baseline %.4f ms, +%.1f%%)\n",
+                         result.caseName.c_str(), result.bench.c_str(), p50, it->second,
+                         (p50 / it->second - 1.0) * 100.0);
+            ++regressions;
+        }
+    }
+    return regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,302 @@
+// ------------------------------------------------------------
+// 앵커(anchor) 기반 줄 단위 diff: Patience / Histogram
+// ------------------------------------------------------------
+// Patience  : 양쪽 구간에서 "딱 한 번씩만" 나오는 줄을 앵커 후보로 잡고,
+//             그 중 순서가 유지되는 가장 긴 열(LIS)을 앵커로 사용한다.
+// Histogram : 구간 안에서 가장 드물게 나오는 줄을 중심으로 같은 영역을
+//             앞뒤로 넓혀 앵커 영역으로 사용한다 (git 의 histogram diff).
+//
+// 두 방식 모두 앵커 사이 구간을 다시 나누고 (재귀 대신 작업 스택),
+// 앵커를 찾을 수 없는 구간만 fallback(Myers)으로 처리한다.
+// 입력은 줄 ID 배열(uint32_t), 결과는 LineMatch 목록이다.
+// ------------------------------------------------------------
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "edit_script.hpp"
+
+// ------------------------------------------------------------
+// 앞/뒤 공통 구간을 잘라내고 match 로 기록
+//   - 앞쪽 match 는 바로 out 에 추가
+//   - 뒤쪽 공통 줄 수를 반환 (호출자가 나중에 추가)
+// ------------------------------------------------------------
+inline int trimCommonEnds(const uint32_t* a, const uint32_t* b, int& aLo, int& aHi, int& bLo, int& bHi,
+                          std::vector<LineMatch>& out) {
+    while (aLo < aHi && bLo < bHi && a[aLo] == b[bLo]) {
+        out.push_back({aLo, bLo});
+        ++aLo;
+        ++bLo;
+    }
+    int suffix = 0;
+    while (aHi > aLo && bHi > bLo && a[aHi - 1] == b[bHi - 1]) {
+        --aHi;
+        --bHi;
+        ++suffix;
+    }
+    return suffix;
+}
+
+inline void appendSuffixMatches(int aHi, int bHi, int suffix, std::vector<LineMatch>& out) {
+    for (int i = 0; i < suffix; ++i) {
+        out.push_back({aHi + i, bHi + i});
+    }
+}
+
+// ------------------------------------------------------------
+// Patience / Histogram 공통 뼈대
+//   Fallback: void(int aLo, int aHi, int bLo, int bHi, vector<LineMatch>&)
+// ------------------------------------------------------------
+template <typename Fallback>
+class AnchoredDiff {
+public:
+    AnchoredDiff(const uint32_t* a, int n, const uint32_t* b, int m, uint32_t idCount, Fallback fallback)
+        : a_(a), b_(b), n_(n), m_(m), fallback_(fallback),
+          countA_(idCount, 0), countB_(idCount, 0), lastA_(idCount, -1), lastB_(idCount, -1),
+          prevA_(n, -1) {}
+
+    std::vector<LineMatch> patience() {
+        std::vector<LineMatch> out;
+        patienceRange(0, n_, 0, m_, out);
+        return out;
+    }
+
+    std::vector<LineMatch> histogram() {
+        std::vector<LineMatch> out;
+        histogramRange(0, n_, 0, m_, out);
+        return out;
+    }
+
+    // --------------------------------------------------------
+    // Patience diff: a[aLo, aHi), b[bLo, bHi) 의 같은 줄 쌍을 out 뒤에 추가
+    // --------------------------------------------------------
+    void patienceRange(int aLo, int aHi, int bLo, int bHi, std::vector<LineMatch>& out) {
+        runRanges(aLo, aHi, bLo, bHi, out, [&](int lo, int hi, int bStart, int bEnd) {
+            std::vector<LineMatch> anchors = findUniqueAnchors(lo, hi, bStart, bEnd);
+            if (anchors.empty()) {
+                fallback_(lo, hi, bStart, bEnd, out);
+                return;
+            }
+            // 뒤 구간부터 쌓아야 앞 구간부터 꺼내짐
+            pushRange(anchors.back().aIndex + 1, hi, anchors.back().bIndex + 1, bEnd);
+            for (size_t k = anchors.size(); k-- > 0;) {
+                pushMatches(anchors[k].aIndex, anchors[k].bIndex, 1);
+                int x = k > 0 ? anchors[k - 1].aIndex + 1 : lo;
+                int y = k > 0 ? anchors[k - 1].bIndex + 1 : bStart;
+                pushRange(x, anchors[k].aIndex, y, anchors[k].bIndex);
+            }
+        });
+    }
+
+    // --------------------------------------------------------
+    // Histogram diff: a[aLo, aHi), b[bLo, bHi) 의 같은 줄 쌍을 out 뒤에 추가
+    // --------------------------------------------------------
+    void histogramRange(int aLo, int aHi, int bLo, int bHi, std::vector<LineMatch>& out) {
+        runRanges(aLo, aHi, bLo, bHi, out, [&](int lo, int hi, int bStart, int bEnd) {
+            LineMatch start{};
+            int length = 0;
+            if (!findRarestRegion(lo, hi, bStart, bEnd, start, length)) {
+                fallback_(lo, hi, bStart, bEnd, out);
+                return;
+            }
+            pushRange(start.aIndex + length, hi, start.bIndex + length, bEnd);
+            pushMatches(start.aIndex, start.bIndex, length);
+            pushRange(lo, start.aIndex, bStart, start.bIndex);
+        });
+    }
+
+    // 양쪽에서 한 번씩만 나오는 줄 중 순서가 유지되는 가장 긴 열 (patience sorting)
+    std::vector<LineMatch> findUniqueAnchors(int aLo, int aHi, int bLo, int bHi) {
+        countRange(aLo, aHi, bLo, bHi);
+
+        std::vector<LineMatch> candidates;
+        for (int i = aLo; i < aHi; ++i) {
+            uint32_t id = a_[i];
+            if (countA_[id] == 1 && countB_[id] == 1) {
+                candidates.push_back({i, lastB_[id]});
+            }
+        }
+        resetCounts();
+
+        if (candidates.empty()) {
+            return candidates;
+        }
+
+        // tails[k] : 길이 k+1 인 증가열의 마지막 후보 번호
+        std::vector<int> tails;
+        std::vector<int> prev(candidates.size(), -1);
+        for (int c = 0; c < static_cast<int>(candidates.size()); ++c) {
+            int bIndex = candidates[c].bIndex;
+            auto it = std::lower_bound(tails.begin(), tails.end(), bIndex,
+                                       [&](int t, int value) { return candidates[t].bIndex < value; });
+            if (it != tails.begin()) prev[c] = *(it - 1);
+            if (it == tails.end()) {
+                tails.push_back(c);
+            } else {
+                *it = c;
+            }
+        }
+
+        std::vector<LineMatch> anchors(tails.size());
+        for (int c = tails.back(), k = static_cast<int>(tails.size()) - 1; c >= 0; c = prev[c], --k) {
+            anchors[k] = candidates[c];
+        }
+        return anchors;
+    }
+
+private:
+    // histogram 에서 이 횟수보다 자주 나오는 줄은 앵커로 쓰지 않음 (git 과 같은 값)
+    static constexpr int MAX_CHAIN_LENGTH = 64;
+
+    const uint32_t* a_;
+    const uint32_t* b_;
+    int n_;
+    int m_;
+    Fallback fallback_;
+
+    // 줄 ID 별 등장 횟수 / 마지막 위치 (구간마다 쓰고 touched_ 로 되돌림)
+    std::vector<int> countA_;
+    std::vector<int> countB_;
+    std::vector<int> lastA_;
+    std::vector<int> lastB_;
+    std::vector<int> prevA_;  // 같은 ID 의 이전 등장 위치 (a 쪽 체인)
+    std::vector<uint32_t> touched_;
+
+    // 아직 처리하지 않은 구간 / 같은 줄 묶음
+    //   재귀 대신 직접 쌓으므로 앵커로 나뉜 구간이 아무리 많아도 호출 스택이 깊어지지 않음
+    struct RangeTask {
+        int aLo;
+        int aHi;
+        int bLo;
+        int bHi;
+        bool matches;  // true 면 (aLo, bLo) 부터 aHi - aLo 쌍을 같은 줄로 추가
+    };
+    std::vector<RangeTask> tasks_;
+
+    void pushRange(int aLo, int aHi, int bLo, int bHi) { tasks_.push_back({aLo, aHi, bLo, bHi, false}); }
+    void pushMatches(int aIndex, int bIndex, int length) {
+        tasks_.push_back({aIndex, aIndex + length, bIndex, bIndex + length, true});
+    }
+
+    // 구간을 하나씩 꺼내 앞/뒤 공통 줄을 잘라낸 뒤 split(aLo, aHi, bLo, bHi) 로 나눔
+    //   split 은 바로 정해지는 match 를 out 에 넣거나, 나눈 구간을 뒤에서부터 pushRange / pushMatches
+    //   (tasks_ 의 시작 위치를 기억해 두므로 fallback 안에서 다시 불러도 됨)
+    template <typename Split>
+    void runRanges(int aLo, int aHi, int bLo, int bHi, std::vector<LineMatch>& out, Split split) {
+        const size_t base = tasks_.size();
+        pushRange(aLo, aHi, bLo, bHi);
+        while (tasks_.size() > base) {
+            RangeTask task = tasks_.back();
+            tasks_.pop_back();
+            if (task.matches) {
+                for (int i = 0; i < task.aHi - task.aLo; ++i) out.push_back({task.aLo + i, task.bLo + i});
+                continue;
+            }
+            int suffix = trimCommonEnds(a_, b_, task.aLo, task.aHi, task.bLo, task.bHi, out);
+            if (suffix > 0) pushMatches(task.aHi, task.bHi, suffix);
+            if (task.aLo < task.aHi && task.bLo < task.bHi) split(task.aLo, task.aHi, task.bLo, task.bHi);
+        }
+    }
+
+    void countRange(int aLo, int aHi, int bLo, int bHi) {
+        for (int i = aLo; i < aHi; ++i) {
+            uint32_t id = a_[i];
+            if (countA_[id] == 0 && countB_[id] == 0) touched_.push_back(id);
+            ++countA_[id];
+            prevA_[i] = lastA_[id];
+            lastA_[id] = i;
+        }
+        for (int j = bLo; j < bHi; ++j) {
+            uint32_t id = b_[j];
+            if (countA_[id] == 0 && countB_[id] == 0) touched_.push_back(id);
+            ++countB_[id];
+            lastB_[id] = j;
+        }
+    }
+
+    void resetCounts() {
+        for (uint32_t id : touched_) {
+            countA_[id] = 0;
+            countB_[id] = 0;
+            lastA_[id] = -1;
+            lastB_[id] = -1;
+        }
+        touched_.clear();
+    }
+
+    // 가장 드물게 나오는 줄을 포함하는 공통 영역 찾기
+    //   - 영역 안 줄들의 최소 등장 횟수가 작을수록, 같으면 길수록 우선
+    bool findRarestRegion(int aLo, int aHi, int bLo, int bHi, LineMatch& bestStart, int& bestLength) {
+        countRange(aLo, aHi, bLo, bHi);
+
+        int bestCount = MAX_CHAIN_LENGTH + 1;
+        bestLength = 0;
+
+        for (int j = bLo; j < bHi;) {
+            uint32_t id = b_[j];
+            int count = countA_[id];
+            if (count == 0 || count > bestCount) {
+                ++j;
+                continue;
+            }
+
+            int nextJ = j + 1;
+            for (int i = lastA_[id]; i >= aLo; i = prevA_[i]) {
+                int as = i;
+                int bs = j;
+                int ae = i + 1;
+                int be = j + 1;
+                int regionCount = count;
+
+                while (as > aLo && bs > bLo && a_[as - 1] == b_[bs - 1]) {
+                    --as;
+                    --bs;
+                    regionCount = std::min(regionCount, countA_[a_[as]]);
+                }
+                while (ae < aHi && be < bHi && a_[ae] == b_[be]) {
+                    regionCount = std::min(regionCount, countA_[a_[ae]]);
+                    ++ae;
+                    ++be;
+                }
+
+                int length = ae - as;
+                if (regionCount < bestCount || (regionCount == bestCount && length > bestLength)) {
+                    bestCount = regionCount;
+                    bestLength = length;
+                    bestStart = {as, bs};
+                }
+                nextJ = std::max(nextJ, be);
+            }
+            j = nextJ;
+        }
+
+        resetCounts();
+        return bestLength > 0;
+    }
+};
+
+template <typename Fallback>
+std::vector<LineMatch> patienceDiff(const uint32_t* a, int n, const uint32_t* b, int m, uint32_t idCount,
+                                    Fallback fallback) {
+    AnchoredDiff<Fallback> engine(a, n, b, m, idCount, fallback);
+    return engine.patience();
+}
+
+template <typename Fallback>
+std::vector<LineMatch> histogramDiff(const uint32_t* a, int n, const uint32_t* b, int m, uint32_t idCount,
+                                     Fallback fallback) {
+    AnchoredDiff<Fallback> engine(a, n, b, m, idCount, fallback);
+    return engine.histogram();
+}
+
+// ------------------------------------------------------------
+// 전체 구간에서 양쪽에 한 번씩만 나오는 줄로 만든 앵커 열 (증가 순서)
+// ------------------------------------------------------------
+inline std::vector<LineMatch> findUniqueLineAnchors(const uint32_t* a, int n, const uint32_t* b, int m,
+                                                    uint32_t idCount) {
+    auto noFallback = [](int, int, int, int, std::vector<LineMatch>&) {};
+    AnchoredDiff<decltype(noFallback)> engine(a, n, b, m, idCount, noFallback);
+    return engine.findUniqueAnchors(0, n, 0, m);
+}
@@ -0,0 +1,258 @@
+// ------------------------------------------------------------
+// 기준 파일 인덱스: 기준 하나 vs 비교 파일 여러 개
+// ------------------------------------------------------------
+// diff_text() 는 부를 때마다 기준 텍스트를 다시 나누고 해시한다. 같은 기준을
+// 여러 버전과 비교할 때는 BaseIndex 를 한 번 만들어 두고 비교 텍스트만 넣는다.
+//
+// 인덱스가 들고 있는 것 (만든 뒤에는 바뀌지 않음)
+//   - 기준 텍스트 복사본과 그 위의 줄 string_view
+//   - 줄 해시 테이블(LineInterner)과 줄 ID 배열
+//   - 줄 ID 별 기준 안 등장 횟수 (등장 맵)
+//
+// 비교 텍스트의 줄은 테이블을 바꾸지 않는 find() 로만 찾는다. 기준에 없는 줄은
+// 어차피 같은 줄이 될 수 없으므로 ID 를 주지 않고 바로 걸러낸다. 그래서 여러 비교
+// 텍스트를 동시에 처리해도 인덱스는 읽기만 한다.
+//
+// 결과 JSON 은 비교 텍스트의 해시를 키로 기억해 두었다가(최근 memoLimit 개),
+// 같은 내용이 다시 들어오면 diff 없이 그대로 돌려준다.
+//
+//   BaseIndex index(baseText, options);
+//   index.run({textA, textB, textC});        // options.threads 로 병렬 처리
+//   index.result(1) / index.resultSize(1)    // 다음 run() 전까지 유효
+// ------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "diff_core.hpp"
+#include "line_index.hpp"
+#include "worker_pool.hpp"
+
+class BaseIndex {
+public:
+    // 기억해 두는 결과 수 기본값
+    static constexpr size_t DEFAULT_MEMO_LIMIT = 32;
+
+    // baseText 는 복사해 두므로 호출 뒤에 버려도 된다
+    explicit BaseIndex(std::string_view baseText, const DiffOptions& options = DiffOptions())
+        : text_(baseText), options_(options) {
+        splitLineViews(text_, lines_);
+        interner_.reset(lines_.size(), options_.normalize);
+        ids_.reserve(lines_.size());
+        for (std::string_view line : lines_) ids_.push_back(interner_.intern(line));
+
+        idCount_ = static_cast<uint32_t>(interner_.size());
+        counts_.assign(idCount_, 0);
+        for (uint32_t id : ids_) ++counts_[id];
+
+        allOrigins_.resize(lines_.size());
+        for (size_t i = 0; i < lines_.size(); ++i) allOrigins_[i] = static_cast<int>(i);
+    }
+
+    // 줄 view 가 text_ 를 가리키므로 복사 / 이동하지 않음
+    BaseIndex(const BaseIndex&) = delete;
+    BaseIndex& operator=(const BaseIndex&) = delete;
+
+    const DiffOptions& options() const { return options_; }
+    size_t lineCount() const { return lines_.size(); }
+    uint32_t idCount() const { return idCount_; }
+
+    // 줄 ID (기준에 없는 줄이면 idCount())
+    uint32_t lookup(std::string_view line) const {
+        uint32_t id = interner_.find(line);
+        return id == LineInterner::NOT_FOUND ? idCount_ : id;
+    }
+
+    // 줄 ID 가 기준에 몇 번 나오는지
+    uint32_t occurrences(uint32_t id) const { return id < idCount_ ? counts_[id] : 0; }
+
+    // 0 이면 결과를 기억하지 않음 (넘치는 만큼 오래된 것부터 버림)
+    void setMemoLimit(size_t limit) {
+        memoLimit_ = limit;
+        trimMemo();
+    }
+
+    // 비교 텍스트마다 diff_text 와 같은 형식의 JSON 을 만들고 결과 수를 반환
+    //   - options().threads 가 1 이 아니면 비교 텍스트들을 작업자 풀에 나눠 처리
+    //   - 이번 호출 안에서 같은 내용이 여러 번 나와도 한 번만 계산
+    size_t run(const std::vector<std::string_view>& compareTexts) {
+        const size_t count = compareTexts.size();
+        results_.assign(count, nullptr);
+
+        // 1) 기억해 둔 결과 / 같은 호출 안의 중복을 먼저 채움
+        std::vector<uint64_t> hashes(count);
+        std::vector<size_t> pending;
+        std::unordered_map<uint64_t, size_t> firstInRun;
+        std::vector<std::pair<size_t, size_t>> duplicates;  // (i, 같은 내용의 앞 번호)
+        for (size_t i = 0; i < count; ++i) {
+            std::string_view text = compareTexts[i];
+            hashes[i] = hashBytes(text.data(), text.size());
+            if ((results_[i] = findMemo(hashes[i], text))) {
+                ++memoHits_;
+                continue;
+            }
+            auto [it, inserted] = firstInRun.try_emplace(hashes[i], i);
+            if (!inserted && compareTexts[it->second] == text) {
+                duplicates.emplace_back(i, it->second);
+                ++memoHits_;
+                continue;
+            }
+            pending.push_back(i);
+        }
+
+        // 2) 나머지를 계산. 여러 개를 나눠 돌릴 때는 풀이 바쁘므로 각 diff 는 단일 스레드
+        int threads = (options_.threads == 1) ? 1 : resolveThreadCount(options_.threads);
+        if (threads > 1 && pending.size() > 1) {
+            DiffOptions single = options_;
+            single.threads = 1;
+            std::shared_ptr<WorkerPool> pool = sharedWorkerPool(threads);
+            size_t poolSize = static_cast<size_t>(pool->size());
+            if (workers_.size() < poolSize) workers_.resize(poolSize);
+            pool->parallelFor(pending.size(), [&](size_t k, int worker) {
+                size_t i = pending[k];
+                results_[i] = diffOne(compareTexts[i], single, worker);
+            });
+        } else {
+            if (workers_.empty()) workers_.resize(1);
+            for (size_t i : pending) results_[i] = diffOne(compareTexts[i], options_, 0);
+        }
+
+        for (const auto& [i, first] : duplicates) results_[i] = results_[first];
+        for (size_t i : pending) storeMemo(hashes[i], compareTexts[i], results_[i]);
+        return count;
+    }
+
+    // 비교 텍스트 하나
+    size_t run(std::string_view compareText) { return run(std::vector<std::string_view>{compareText}); }
+
+    // 마지막 run() 의 i 번째 결과 ('\0' 으로 끝남, 범위 밖이면 nullptr)
+    const char* result(size_t i) const { return i < results_.size() ? results_[i]->c_str() : nullptr; }
+    size_t resultSize(size_t i) const { return i < results_.size() ? results_[i]->size() : 0; }
+    size_t resultCount() const { return results_.size(); }
+
+    // 기억해 둔 결과로 diff 를 건너뛴 횟수 (누적)
+    size_t memoHits() const { return memoHits_; }
+
+private:
+    using ResultPtr = std::shared_ptr<const std::string>;
+
+    // 작업자마다 하나 (실행 사이에 용량 재사용)
+    struct Worker {
+        std::vector<std::string_view> bLines;
+        std::vector<uint8_t> seen;
+        LineDiffScratch scratch;
+        std::vector<DiffRow> rows;
+    };
+
+    struct MemoEntry {
+        std::string text;  // 해시가 우연히 같은 다른 내용과 구분하기 위한 원본
+        ResultPtr json;
+    };
+
+    std::string text_;
+    DiffOptions options_;
+    std::vector<std::string_view> lines_;
+    LineInterner interner_;
+    std::vector<uint32_t> ids_;
+    std::vector<uint32_t> counts_;  // 줄 ID -> 기준 안 등장 횟수
+    std::vector<int> allOrigins_;   // 0, 1, 2, ... (기준 줄이 하나도 걸러지지 않을 때)
+    uint32_t idCount_ = 0;
+
+    std::vector<Worker> workers_;
+    std::vector<ResultPtr> results_;
+
+    std::unordered_map<uint64_t, MemoEntry> memo_;
+    std::deque<uint64_t> memoOrder_;  // 넣은 순서 (오래된 것부터 버림)
+    size_t memoLimit_ = DEFAULT_MEMO_LIMIT;
+    size_t memoHits_ = 0;
+
+    // 인덱스는 읽기만 하고 workers_[worker] 만 쓰므로 작업자끼리 동시에 불러도 된다
+    ResultPtr diffOne(std::string_view compareText, const DiffOptions& options, int worker) {
+        Worker& w = workers_[static_cast<size_t>(worker)];
+        splitLineViews(compareText, w.bLines);
+        filterAgainstBase(w);
+
+        const std::vector<IndexedEdit>& edits = runFilteredLineDiff(
+            idCount_, static_cast<int>(lines_.size()), static_cast<int>(w.bLines.size()), options, w.scratch);
+        buildRows(edits, w.rows);
+
+        auto json = std::make_shared<std::string>();
+        json->reserve(text_.size() + compareText.size() + w.rows.size() * 48 + 32);
+        *json += "{\n  \"rows\": [\n";
+        appendResultRowsJson(*json, w.rows, lines_, w.bLines, options);
+        appendRowsJsonEnd(*json, w.scratch.degraded);
+        return json;
+    }
+
+    // filterUnmatchedLines 와 같은 결과를 인덱스로 구함
+    //   - 비교 줄은 find() 로 찾고, 기준에 없으면 바로 버림
+    //   - 기준 줄은 비교 쪽에 나온 ID 만 남기는데, 등장 횟수로 남을 줄 수를 미리 알 수 있어서
+    //     전부 남으면 기준 ID 배열을 그대로 복사한다
+    void filterAgainstBase(Worker& w) const {
+        FilteredIds& a = w.scratch.a;
+        FilteredIds& b = w.scratch.b;
+        w.seen.assign(idCount_, 0);
+
+        b.ids.clear();
+        b.origin.clear();
+        b.ids.reserve(w.bLines.size());
+        b.origin.reserve(w.bLines.size());
+        size_t keptA = 0;
+        for (size_t j = 0; j < w.bLines.size(); ++j) {
+            uint32_t id = lookup(w.bLines[j]);
+            if (id == idCount_) continue;
+            b.ids.push_back(id);
+            b.origin.push_back(static_cast<int>(j));
+            if (!w.seen[id]) {
+                w.seen[id] = 1;
+                keptA += counts_[id];
+            }
+        }
+
+        if (keptA == ids_.size()) {
+            a.ids.assign(ids_.begin(), ids_.end());
+            a.origin.assign(allOrigins_.begin(), allOrigins_.end());
+            return;
+        }
+        a.ids.clear();
+        a.origin.clear();
+        a.ids.reserve(keptA);
+        a.origin.reserve(keptA);
+        for (size_t i = 0; i < ids_.size(); ++i) {
+            if (w.seen[ids_[i]]) {
+                a.ids.push_back(ids_[i]);
+                a.origin.push_back(static_cast<int>(i));
+            }
+        }
+    }
+
+    ResultPtr findMemo(uint64_t hash, std::string_view text) const {
+        auto it = memo_.find(hash);
+        if (it == memo_.end() || it->second.text != text) return nullptr;
+        return it->second.json;
+    }
+
+    void storeMemo(uint64_t hash, std::string_view text, const ResultPtr& json) {
+        if (memoLimit_ == 0) return;
+        auto [it, inserted] = memo_.try_emplace(hash);
+        it->second.text.assign(text.data(), text.size());
+        it->second.json = json;
+        if (inserted) memoOrder_.push_back(hash);
+        trimMemo();
+    }
+
+    void trimMemo() {
+        while (memoOrder_.size() > memoLimit_) {
+            memo_.erase(memoOrder_.front());
+            memoOrder_.pop_front();
+        }
+    }
+};
@@ -0,0 +1,134 @@
+// ------------------------------------------------------------
+// 바이너리 diff 결과 형식
+// ------------------------------------------------------------
+// JSON 문자열 대신 uint32_t(리틀 엔디언) 배열 하나에 결과를 담는다.
+// 텍스트는 복사하지 않고 호출자가 넘긴 입력 버퍼 기준 (offset, length) 만 기록하므로
+// JS 에서는 Uint32Array 로 바로 읽고, 필요한 부분만 입력 바이트에서 디코딩하면 된다.
+//
+//   [헤더] 8 words
+//     0: magic      'DFB1' (0x31424644)
+//     1: version    1
+//     2: rowCount
+//     3: tokenCount
+//     4: rowsOffset    (word 단위, 헤더 시작 기준)
+//     5: tokensOffset  (word 단위)
+//     6: totalWords    (헤더 포함 전체 길이)
+//     7: degraded      예산(diff_budget.hpp) 때문에 최소 diff 가 아닐 수 있으면
+//                      DIFF_DEGRADED_* 비트, 아니면 0 (이전에는 항상 0 인 예약 칸)
+//
+//   [row] rowCount x 7 words
+//     op, leftOffset, leftLength, rightOffset, rightLength, tokenStart, tokenCount
+//       op: 0 = equal, 1 = delete, 2 = insert, 3 = replace
+//       left*  : 기준 텍스트 버퍼 기준 바이트 위치/길이 (없으면 0, 0)
+//       right* : 변경 텍스트 버퍼 기준 바이트 위치/길이 (없으면 0, 0)
+//       token* : replace 인 경우 토큰 테이블에서의 시작 번호/개수
+//
+//   [token] tokenCount x 5 words
+//     op, leftOffset, leftLength, rightOffset, rightLength
+//       op: 0 = equal, 1 = delete, 2 = insert
+// ------------------------------------------------------------
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+constexpr uint32_t BINARY_RESULT_MAGIC = 0x31424644u;  // "DFB1"
+constexpr uint32_t BINARY_RESULT_VERSION = 1;
+constexpr uint32_t BINARY_HEADER_WORDS = 8;
+constexpr uint32_t BINARY_ROW_WORDS = 7;
+constexpr uint32_t BINARY_TOKEN_WORDS = 5;
+
+// 헤더 8 words (BinaryResultWriter 와 row 를 바로 내보내는 CLI 가 같이 사용)
+inline void fillBinaryResultHeader(uint32_t* header, uint32_t rowCount, uint32_t tokenCount, uint32_t degraded) {
+    uint32_t tokensOffset = BINARY_HEADER_WORDS + rowCount * BINARY_ROW_WORDS;
+    header[0] = BINARY_RESULT_MAGIC;
+    header[1] = BINARY_RESULT_VERSION;
+    header[2] = rowCount;
+    header[3] = tokenCount;
+    header[4] = BINARY_HEADER_WORDS;
+    header[5] = tokensOffset;
+    header[6] = tokensOffset + tokenCount * BINARY_TOKEN_WORDS;
+    header[7] = degraded;
+}
+
+// text 의 origin 기준 (offset, length) 를 out[0], out[1] 에 (빈 텍스트는 0, 0)
+inline void binarySpan(uint32_t* out, const char* origin, std::string_view text) {
+    out[0] = text.empty() ? 0 : static_cast<uint32_t>(text.data() - origin);
+    out[1] = static_cast<uint32_t>(text.size());
+}
+
+// token 한 개 (SpillBuffer 에 그대로 넣을 수 있는 고정 크기)
+struct BinaryToken {
+    uint32_t words[BINARY_TOKEN_WORDS];
+};
+
+inline BinaryToken makeBinaryToken(uint32_t op, const char* baseText, std::string_view left,
+                                   const char* changedText, std::string_view right) {
+    BinaryToken token;
+    token.words[0] = op;
+    binarySpan(token.words + 1, baseText, left);
+    binarySpan(token.words + 3, changedText, right);
+    return token;
+}
+
+// ------------------------------------------------------------
+// 바이너리 결과 작성기
+//   - row 와 token 을 따로 모았다가 finish() 에서 한 배열로 이어 붙인다
+//     (결과를 한 버퍼로 돌려주는 diff_text_binary 용, CLI 는 writeBinaryDiff 에서 바로 내보냄)
+//   - 내부 버퍼는 호출 사이에 재사용 (clear 만 하고 용량 유지)
+// ------------------------------------------------------------
+class BinaryResultWriter {
+public:
+    void begin(const char* baseText, const char* changedText, size_t expectedRows) {
+        baseText_ = baseText;
+        changedText_ = changedText;
+        rows_.clear();
+        tokens_.clear();
+        rows_.reserve(expectedRows * BINARY_ROW_WORDS);
+    }
+
+    void addRow(uint32_t op, std::string_view left, std::string_view right) {
+        rows_.push_back(op);
+        pushSpan(rows_, baseText_, left);
+        pushSpan(rows_, changedText_, right);
+        rows_.push_back(tokenCount());
+        rows_.push_back(0);
+    }
+
+    // 마지막으로 추가한 row 에 토큰 추가
+    void addToken(uint32_t op, std::string_view left, std::string_view right) {
+        tokens_.push_back(op);
+        pushSpan(tokens_, baseText_, left);
+        pushSpan(tokens_, changedText_, right);
+        rows_.back() += 1;
+    }
+
+    const uint32_t* finish(uint32_t degraded = 0) {
+        uint32_t header[BINARY_HEADER_WORDS];
+        fillBinaryResultHeader(header, static_cast<uint32_t>(rows_.size() / BINARY_ROW_WORDS), tokenCount(),
+                               degraded);
+
+        buffer_.clear();
+        buffer_.reserve(header[6]);
+        buffer_.insert(buffer_.end(), header, header + BINARY_HEADER_WORDS);
+        buffer_.insert(buffer_.end(), rows_.begin(), rows_.end());
+        buffer_.insert(buffer_.end(), tokens_.begin(), tokens_.end());
+        return buffer_.data();
+    }
+
+private:
+    const char* baseText_ = nullptr;
+    const char* changedText_ = nullptr;
+    std::vector<uint32_t> rows_;
+    std::vector<uint32_t> tokens_;
+    std::vector<uint32_t> buffer_;
+
+    uint32_t tokenCount() const { return static_cast<uint32_t>(tokens_.size() / BINARY_TOKEN_WORDS); }
+
+    static void pushSpan(std::vector<uint32_t>& out, const char* origin, std::string_view text) {
+        uint32_t span[2];
+        binarySpan(span, origin, text);
+        out.insert(out.end(), span, span + 2);
+    }
+};
@@ -0,0 +1,176 @@
+// ------------------------------------------------------------
+// 비트 병렬(bit-parallel) LCS
+// ------------------------------------------------------------
+// 단어/글자 단위 diff 는 (n+1) x (m+1) 크기의 int DP 표를 만들어 LCS 를 구했다.
+// 여기서는 Allison-Dix / Hyyrö 방식으로 DP 한 행을 비트 벡터 하나로 표현한다.
+//
+//   V_i 의 j 번째 비트가 0  <=>  dp[i][j + 1] == dp[i][j] + 1
+//   V_0 = 111...1,  U = V & Match[a_i],  V_i = (V + U) | (V - U)
+//
+// 그래서 dp[i][j] = (V_i 의 앞쪽 j 비트 중 0 의 개수) 이고, 한 행을 64 토큰 단위로
+// 한 번에 계산한다. U 는 항상 V 의 부분집합이라 V - U = V & ~Match 로 빌림 없이 구해지고,
+// 워드 사이로 넘어가는 것은 덧셈의 carry 하나뿐이다 (x86-64 는 ADC 명령 사용).
+//
+// 역추적은 저장해 둔 행 비트 벡터(n x ceil(m / 64) 워드)로 dp 값을 그때그때 계산하므로
+// 기존 DP 역추적과 같은 경로(같은 토큰 정렬 결과)를 만든다.
+// ------------------------------------------------------------
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+// 64비트 덧셈 + carry (carry 는 0 또는 1)
+inline uint64_t addWithCarry(uint64_t x, uint64_t y, unsigned char& carry) {
+#if defined(__x86_64__) || defined(_M_X64)
+    unsigned long long sum;
+    carry = _addcarry_u64(carry, x, y, &sum);
+    return sum;
+#elif defined(__clang__)
+    unsigned long long carryOut;
+    unsigned long long sum = __builtin_addcll(x, y, carry, &carryOut);
+    carry = static_cast<unsigned char>(carryOut);
+    return sum;
+#else
+    uint64_t sum = x + y;
+    unsigned char overflow = sum < x;
+    uint64_t result = sum + carry;
+    carry = overflow | (result < sum);
+    return result;
+#endif
+}
+
+inline int popcount64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(x);
+#else
+    int count = 0;
+    for (; x; x &= x - 1) ++count;
+    return count;
+#endif
+}
+
+// ------------------------------------------------------------
+// 토큰 ID 배열 두 개의 LCS 정렬
+//   a, b 는 0 ~ idCount-1 범위의 ID (같은 내용이면 같은 ID)
+//   결과는 'M' (같은 토큰), 'D' (a 에만 있음), 'I' (b 에만 있음) 의 순서열로,
+//   기존 DP 역추적(dp[i][j-1] >= dp[i-1][j] 이면 삽입 먼저)과 같은 정렬을 돌려준다.
+// ------------------------------------------------------------
+class BitParallelLcs {
+public:
+    // 행 비트 벡터 전체 크기 상한 (워드 수, 128MB). 넘으면 전체 삭제 + 전체 추가로 처리
+    static constexpr size_t MAX_ROW_WORDS = size_t{16} << 20;
+
+    std::vector<char> align(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b, uint32_t idCount) {
+        std::vector<char> ops;
+        align(a, b, idCount, ops);
+        return ops;
+    }
+
+    // ops 를 비우고 결과를 채움 (호출자가 버퍼를 재사용할 때)
+    void align(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b, uint32_t idCount,
+               std::vector<char>& ops) {
+        const int n = static_cast<int>(a.size());
+        const int m = static_cast<int>(b.size());
+        words_ = static_cast<size_t>(m + 63) / 64;
+        ops.clear();
+
+        if ((static_cast<size_t>(n) + 1) * words_ > MAX_ROW_WORDS) {
+            ops.assign(static_cast<size_t>(n), 'D');
+            ops.insert(ops.end(), static_cast<size_t>(m), 'I');
+            return;
+        }
+
+        buildMatchIndex(b, idCount);
+        computeRows(a);
+
+        // 역추적
+        ops.reserve(static_cast<size_t>(n + m));
+        int i = n;
+        int j = m;
+        while (i > 0 || j > 0) {
+            if (i > 0 && j > 0 && a[i - 1] == b[j - 1]) {
+                ops.push_back('M');
+                --i;
+                --j;
+            } else if (j > 0 && (i == 0 || lcsAt(i, j - 1) >= lcsAt(i - 1, j))) {
+                ops.push_back('I');
+                --j;
+            } else {
+                ops.push_back('D');
+                --i;
+            }
+        }
+        std::reverse(ops.begin(), ops.end());
+    }
+
+private:
+    size_t words_ = 0;
+    std::vector<uint64_t> rows_;      // (n + 1) 행 x words_ 워드, 행 i = V_i
+    std::vector<uint64_t> match_;     // 현재 a 토큰의 Match 비트 (한 행 분량)
+    std::vector<int> matchStart_;     // ID -> positions_ 시작 위치 (CSR)
+    std::vector<int> positions_;      // ID 별 b 안의 위치 목록
+    std::vector<int> fill_;           // buildMatchIndex 작업 버퍼
+
+    // b 안에서 각 ID 가 나오는 위치 목록 (ID 별로 모아 둠)
+    void buildMatchIndex(const std::vector<uint32_t>& b, uint32_t idCount) {
+        matchStart_.assign(static_cast<size_t>(idCount) + 1, 0);
+        for (uint32_t id : b) ++matchStart_[id + 1];
+        for (size_t k = 1; k < matchStart_.size(); ++k) matchStart_[k] += matchStart_[k - 1];
+
+        positions_.resize(b.size());
+        fill_.assign(matchStart_.begin(), matchStart_.end() - 1);
+        for (int j = 0; j < static_cast<int>(b.size()); ++j) {
+            positions_[fill_[b[j]]++] = j;
+        }
+    }
+
+    void computeRows(const std::vector<uint32_t>& a) {
+        const size_t n = a.size();
+        rows_.assign((n + 1) * words_, ~uint64_t{0});
+        match_.assign(words_, 0);
+
+        for (size_t i = 0; i < n; ++i) {
+            const uint64_t* prev = rows_.data() + i * words_;
+            uint64_t* next = rows_.data() + (i + 1) * words_;
+
+            int begin = matchStart_[a[i]];
+            int end = matchStart_[a[i] + 1];
+            if (begin == end) {
+                // b 에 없는 토큰: 행이 그대로
+                std::copy(prev, prev + words_, next);
+                continue;
+            }
+
+            for (int k = begin; k < end; ++k) {
+                match_[positions_[k] >> 6] |= uint64_t{1} << (positions_[k] & 63);
+            }
+
+            unsigned char carry = 0;
+            for (size_t w = 0; w < words_; ++w) {
+                uint64_t v = prev[w];
+                uint64_t u = v & match_[w];
+                next[w] = addWithCarry(v, u, carry) | (v & ~match_[w]);
+            }
+
+            for (int k = begin; k < end; ++k) {
+                match_[positions_[k] >> 6] = 0;
+            }
+        }
+    }
+
+    // dp[i][j] = V_i 의 앞쪽 j 비트 중 0 의 개수
+    int lcsAt(int i, int j) const {
+        const uint64_t* row = rows_.data() + static_cast<size_t>(i) * words_;
+        int ones = 0;
+        int full = j >> 6;
+        for (int w = 0; w < full; ++w) ones += popcount64(row[w]);
+        int rest = j & 63;
+        if (rest) ones += popcount64(row[full] & ((uint64_t{1} << rest) - 1));
+        return j - ones;
+    }
+};
@@ -0,0 +1,124 @@
+// ------------------------------------------------------------
+// 범프(bump) 할당기
+// ------------------------------------------------------------
+// 한 번의 diff 실행 동안만 쓰는 메모리(row 목록, 결과 JSON)를 큰 덩어리(chunk)
+// 에서 포인터만 앞으로 밀어 가며 잘라 준다. 개별 해제는 하지 않고 reset() 으로
+// 한꺼번에 되돌린다.
+//
+// reset() 은 메모리를 돌려주지 않는다. 덩어리가 여러 개였다면 그 합만큼의 덩어리
+// 하나로 합쳐 두므로, 비슷한 크기의 입력을 반복해서 처리하면 두 번째 실행부터는
+// 새로 할당하지 않는다.
+//
+//   ArenaAllocator<T> 로 std::vector / std::basic_string 을 arena 위에 만들 수 있다.
+//   (컨테이너는 reset() 전에 먼저 없애야 함)
+// ------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+class BumpArena {
+public:
+    static constexpr size_t MIN_CHUNK_BYTES = 64 * 1024;
+
+    BumpArena() = default;
+    BumpArena(const BumpArena&) = delete;
+    BumpArena& operator=(const BumpArena&) = delete;
+
+    void* allocate(size_t bytes, size_t align) {
+        if (!chunks_.empty()) {
+            Chunk& chunk = chunks_.back();
+            size_t offset = alignUp(chunk.used, align);
+            if (offset + bytes <= chunk.size) {
+                chunk.used = offset + bytes;
+                return chunk.data.get() + offset;
+            }
+        }
+
+        // 새 덩어리: 직전 덩어리의 2배 이상 (덩어리 수가 log 로만 늘도록)
+        size_t size = chunks_.empty() ? MIN_CHUNK_BYTES : chunks_.back().size * 2;
+        if (size < bytes + align) size = bytes + align;
+        addChunk(size);
+
+        Chunk& chunk = chunks_.back();
+        size_t offset = alignUp(0, align);
+        chunk.used = offset + bytes;
+        return chunk.data.get() + offset;
+    }
+
+    // 전부 해제한 것으로 되돌림. 덩어리가 여러 개면 합친 크기 하나로 바꿔 둔다
+    void reset() {
+        if (chunks_.size() > 1) {
+            size_t total = capacity();
+            chunks_.clear();
+            addChunk(total);
+        }
+        if (!chunks_.empty()) chunks_.back().used = 0;
+    }
+
+    // 지금까지 확보한 전체 크기
+    size_t capacity() const {
+        size_t total = 0;
+        for (const Chunk& chunk : chunks_) total += chunk.size;
+        return total;
+    }
+
+    size_t chunkCount() const { return chunks_.size(); }
+
+private:
+    struct Chunk {
+        std::unique_ptr<std::byte[]> data;
+        size_t size = 0;
+        size_t used = 0;
+    };
+
+    std::vector<Chunk> chunks_;
+
+    static size_t alignUp(size_t offset, size_t align) { return (offset + align - 1) & ~(align - 1); }
+
+    void addChunk(size_t size) {
+        // new std::byte[] 는 max_align_t 정렬을 보장하므로 offset 정렬만 맞추면 됨
+        chunks_.push_back(Chunk{std::unique_ptr<std::byte[]>(new std::byte[size]), size, 0});
+    }
+};
+
+// ------------------------------------------------------------
+// 표준 컨테이너용 할당기 (deallocate 는 아무 일도 하지 않음)
+// ------------------------------------------------------------
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(BumpArena& arena) noexcept : arena_(&arena) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.arena()) {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(arena_->allocate(count * sizeof(T), alignof(T)));
+    }
+    void deallocate(T*, size_t) noexcept {}
+
+    BumpArena* arena() const noexcept { return arena_; }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept {
+        return arena_ == other.arena();
+    }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const noexcept {
+        return arena_ != other.arena();
+    }
+
+private:
+    BumpArena* arena_;
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
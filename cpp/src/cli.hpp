@@ -0,0 +1,920 @@
+// ------------------------------------------------------------
+// 네이티브 CLI
+// ------------------------------------------------------------
+//   diff [옵션] <기준 파일> <변경 파일>
+//   diff [옵션] <기준 디렉터리> <변경 디렉터리>
+//
+// 두 파일을 메모리 맵(mapped_file.hpp)으로 열고, 줄은 맵 위의 string_view 로만
+// 나누므로 입력을 복사하지 않는다. 결과는 고정 크기 버퍼에 모았다가 stdout 으로
+// 바로바로 내보내서 큰 파일이어도 전체 출력을 std::string 하나에 담지 않는다.
+//
+//   --format=unified (기본) : 표준 unified diff (-U N 으로 문맥 줄 수 지정)
+//   --format=json           : diff_text() 와 같은 {"rows": [...]} JSON
+//                             (--fold=N 이면 변경 앞뒤 N 줄만 남기고 같은 줄은 skip row 로 접음)
+//   --format=binary         : diff_text_binary() 와 같은 DFB1 바이너리
+//   --delta[=varint|fixed]  : 기준에서 변경 파일을 다시 만드는 DFD1 델타 (delta_patch.hpp)
+//
+// --apply 이면 두 번째 경로를 델타 파일로 보고, 기준에 적용한 결과를 stdout 으로 낸다.
+//
+// --strip-trailing-cr / -w / -b / -i 는 diff(1) 과 같은 뜻으로 줄 비교만 정규화하고
+// (DiffOptions::normalize), 출력에는 원문 줄이 그대로 나간다.
+//
+// --out-of-core[=MB] 이면 파일을 맵하지 않고 줄 레코드(위치, 길이, 해시)만 창 단위로
+// 들고 diff 하며, 출력할 줄만 파일에서 다시 읽는다 (out_of_core.hpp). 메모리는 입력 크기와
+// 상관없이 MB (기본 256) 안에서 움직이고, 출력은 unified 만 지원한다.
+//
+// --max-cost / --max-memory / --time-limit 로 줄 diff 비용 상한(diff_budget.hpp)을 주면
+// 상한에 걸렸을 때 최소가 아닐 수 있는 결과를 내고 stderr 에 경고를 남긴다.
+//
+// 두 경로가 모두 디렉터리면 아래 파일 / 디렉터리를 상대 경로로 짝 맞춰 재귀로 비교한다
+// (runTreeDiff). 같은 파일은 크기 / 바이트 비교로 먼저 거르고, 나머지는 작업 훔치기
+// 스케줄러(work_stealing.hpp)로 나눠 diff 한 뒤 경로 순서대로 unified diff 를 내보낸다.
+// --summary=FILE 이면 파일별 상태 / 크기 / 걸린 시간을 JSON 으로 남긴다.
+//
+// 종료 코드는 diff(1) 과 같다: 0 = 같음, 1 = 다름, 2 = 오류
+// ------------------------------------------------------------
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "binary_result.hpp"
+#include "delta_patch.hpp"
+#include "diff_core.hpp"
+#include "mapped_file.hpp"
+#include "out_of_core.hpp"
+#include "tree_diff.hpp"
+#include "work_stealing.hpp"
+
+// ------------------------------------------------------------
+// stdout 출력 버퍼 (일정 크기가 넘으면 fwrite 로 비움)
+//   file 이 nullptr 이면 비우지 않고 모으기만 한다 (raw() 로 꺼냄)
+// ------------------------------------------------------------
+class OutputBuffer {
+public:
+    static constexpr size_t FLUSH_BYTES = size_t{1} << 16;
+
+    explicit OutputBuffer(FILE* file) : file_(file) {
+        if (file_) buffer_.reserve(FLUSH_BYTES * 2);
+    }
+    ~OutputBuffer() { flush(); }
+
+    void write(std::string_view text) {
+        buffer_.append(text.data(), text.size());
+        if (buffer_.size() >= FLUSH_BYTES) flush();
+    }
+
+    void write(char c) {
+        buffer_.push_back(c);
+        if (buffer_.size() >= FLUSH_BYTES) flush();
+    }
+
+    // appendRowJson 등 Out 템플릿 인자로 바로 넘길 수 있도록 std::string 과 같은 이름으로도 받음
+    //   (쓰는 도중에도 FLUSH_BYTES 마다 비워지므로 결과 전체를 메모리에 모으지 않음)
+    OutputBuffer& operator+=(std::string_view text) {
+        write(text);
+        return *this;
+    }
+    OutputBuffer& operator+=(char c) {
+        write(c);
+        return *this;
+    }
+    void append(const char* data, size_t length) { write(std::string_view(data, length)); }
+
+    // file 이 nullptr 일 때 모은 결과를 꺼냄
+    std::string& raw() { return buffer_; }
+
+    void flush() {
+        if (file_ && !buffer_.empty()) {
+            std::fwrite(buffer_.data(), 1, buffer_.size(), file_);
+            buffer_.clear();
+        }
+    }
+
+private:
+    FILE* file_;
+    std::string buffer_;
+};
+
+enum class CliFormat {
+    Unified,
+    Json,
+    Binary,
+    Delta,
+};
+
+struct CliOptions {
+    CliFormat format = CliFormat::Unified;
+    int context = 3;
+    DiffOptions diff;
+    const char* basePath = nullptr;
+    const char* changedPath = nullptr;
+    const char* summaryPath = nullptr;  // 디렉터리 비교 요약 JSON ("-" 이면 stderr)
+    size_t outOfCoreBytes = 0;          // 0 이 아니면 out-of-core 모드의 메모리 상한
+    uint32_t deltaFlags = DELTA_FLAG_VARINT;
+    bool applyDelta = false;            // 두 번째 경로가 델타 파일 (--apply)
+};
+
+inline void printCliUsage(FILE* out) {
+    std::fputs("usage: diff [options] <base file> <changed file>\n"
+               "       diff [options] <base dir> <changed dir>\n"
+               "\n"
+               "  -u, -U N, --unified=N    unified diff with N lines of context (default 3)\n"
+               "  --format=unified|json|binary\n"
+               "  --json, --binary         same as --format=json / --format=binary\n"
+               "  --delta[=varint|fixed]   binary delta that rebuilds <changed file> from <base file>\n"
+               "  --apply                  write <base file> patched with the delta file given second\n"
+               "  --algorithm=NAME         myers (default), myers-linear, patience, histogram\n"
+               "  --trim-common            strip common leading/trailing lines first (myers variants)\n"
+               "  --tokens=word|char       token unit inside replaced lines (json / binary)\n"
+               "  --fold=N                 json: fold unchanged lines into skip rows, keeping N context\n"
+               "  --strip-trailing-cr      ignore a carriage return at the end of each line\n"
+               "  -w, --ignore-all-space   ignore all white space when comparing lines\n"
+               "  -b, --ignore-space-change  ignore changes in the amount of white space\n"
+               "  -i, --ignore-case        ignore ASCII case differences\n"
+               "  --threads=N              worker threads for large inputs / directory files (0 = all cores)\n"
+               "  -r, --recursive          accepted for diff(1) compatibility (directories always recurse)\n"
+               "  --summary=FILE           directories: per-file status and timing as JSON (- = stderr)\n"
+               "  --out-of-core[=MB]       diff files larger than memory, using about MB megabytes (default 256)\n"
+               "  --max-cost=N             give up on a minimal diff past edit cost N per search\n"
+               "  --max-memory=MB          cap the Myers search state at MB megabytes\n"
+               "  --time-limit=MS          stop searching after MS milliseconds (rest is delete/insert)\n"
+               "  --demo                   run the built-in sample cases\n"
+               "  -h, --help               show this help\n",
+               out);
+}
+
+// 음이 아닌 정수 옵션 값
+inline bool parseCliCount(const char* text, int& value) {
+    if (!text || !*text) return false;
+    char* end = nullptr;
+    long parsed = std::strtol(text, &end, 10);
+    if (*end != '\0' || parsed < 0 || parsed > 1000000) return false;
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+// 인자 해석. 실패하면 error 에 이유를 남기고 false
+inline bool parseCliOptions(int argc, char** argv, CliOptions& options, std::string& error) {
+    std::vector<const char*> paths;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        auto valueOf = [&](std::string_view prefix) { return argv[i] + prefix.size(); };
+
+        if (arg == "-u") {
+            options.format = CliFormat::Unified;
+        } else if (arg == "-U" || arg.rfind("-U", 0) == 0 || arg.rfind("--unified=", 0) == 0) {
+            const char* value = (arg == "-U") ? (i + 1 < argc ? argv[++i] : nullptr)
+                                : (arg[1] == 'U') ? valueOf("-U") : valueOf("--unified=");
+            if (!parseCliCount(value, options.context)) {
+                error = "invalid context length";
+                return false;
+            }
+            options.format = CliFormat::Unified;
+        } else if (arg == "--json" || arg == "--format=json") {
+            options.format = CliFormat::Json;
+        } else if (arg == "--binary" || arg == "--format=binary") {
+            options.format = CliFormat::Binary;
+        } else if (arg == "--delta" || arg.rfind("--delta=", 0) == 0) {
+            std::string_view encoding = (arg == "--delta") ? "varint" : valueOf("--delta=");
+            if (encoding == "varint") options.deltaFlags = DELTA_FLAG_VARINT;
+            else if (encoding == "fixed") options.deltaFlags = 0;
+            else {
+                error = "unknown delta encoding: " + std::string(encoding);
+                return false;
+            }
+            options.format = CliFormat::Delta;
+        } else if (arg == "--apply") {
+            options.applyDelta = true;
+        } else if (arg == "--format=unified") {
+            options.format = CliFormat::Unified;
+        } else if (arg.rfind("--algorithm=", 0) == 0) {
+            std::string_view name = valueOf("--algorithm=");
+            if (name == "myers") options.diff.algorithm = DiffAlgorithm::Myers;
+            else if (name == "myers-linear") options.diff.algorithm = DiffAlgorithm::MyersLinear;
+            else if (name == "patience") options.diff.algorithm = DiffAlgorithm::Patience;
+            else if (name == "histogram") options.diff.algorithm = DiffAlgorithm::Histogram;
+            else {
+                error = "unknown algorithm: " + std::string(name);
+                return false;
+            }
+        } else if (arg == "--trim-common") {
+            options.diff.trimCommon = true;
+        } else if (arg.rfind("--tokens=", 0) == 0) {
+            std::string_view mode = valueOf("--tokens=");
+            if (mode == "word") options.diff.tokenMode = TokenMode::Word;
+            else if (mode == "char") options.diff.tokenMode = TokenMode::Char;
+            else {
+                error = "unknown token mode: " + std::string(mode);
+                return false;
+            }
+        } else if (arg.rfind("--fold=", 0) == 0) {
+            if (!parseCliCount(valueOf("--fold="), options.diff.context)) {
+                error = "invalid fold context length";
+                return false;
+            }
+            options.format = CliFormat::Json;
+        } else if (arg == "--strip-trailing-cr") {
+            options.diff.normalize |= LINE_IGNORE_TRAILING_CR;
+        } else if (arg == "-w" || arg == "--ignore-all-space") {
+            options.diff.normalize |= LINE_IGNORE_ALL_SPACE;
+        } else if (arg == "-b" || arg == "--ignore-space-change") {
+            options.diff.normalize |= LINE_IGNORE_SPACE_CHANGE;
+        } else if (arg == "-i" || arg == "--ignore-case") {
+            options.diff.normalize |= LINE_IGNORE_CASE;
+        } else if (arg == "-r" || arg == "--recursive") {
+            // 디렉터리는 항상 재귀로 비교
+        } else if (arg.rfind("--summary=", 0) == 0) {
+            options.summaryPath = valueOf("--summary=");
+        } else if (arg.rfind("--threads=", 0) == 0) {
+            if (!parseCliCount(valueOf("--threads="), options.diff.threads)) {
+                error = "invalid thread count";
+                return false;
+            }
+        } else if (arg == "--out-of-core" || arg.rfind("--out-of-core=", 0) == 0) {
+            int megabytes = static_cast<int>(OutOfCoreBudget::DEFAULT_MEGABYTES);
+            if (arg != "--out-of-core" &&
+                (!parseCliCount(valueOf("--out-of-core="), megabytes) ||
+                 static_cast<size_t>(megabytes) < OutOfCoreBudget::MIN_MEGABYTES)) {
+                error = "invalid out-of-core memory limit (at least " +
+                        std::to_string(OutOfCoreBudget::MIN_MEGABYTES) + " MB)";
+                return false;
+            }
+            options.outOfCoreBytes = static_cast<size_t>(megabytes) << 20;
+        } else if (arg.rfind("--max-cost=", 0) == 0) {
+            if (!parseCliCount(valueOf("--max-cost="), options.diff.budget.maxCost)) {
+                error = "invalid edit cost";
+                return false;
+            }
+        } else if (arg.rfind("--max-memory=", 0) == 0) {
+            int megabytes = 0;
+            if (!parseCliCount(valueOf("--max-memory="), megabytes)) {
+                error = "invalid memory limit";
+                return false;
+            }
+            options.diff.budget.maxMemoryBytes = static_cast<size_t>(megabytes) << 20;
+        } else if (arg.rfind("--time-limit=", 0) == 0) {
+            int milliseconds = 0;
+            if (!parseCliCount(valueOf("--time-limit="), milliseconds)) {
+                error = "invalid time limit";
+                return false;
+            }
+            options.diff.budget.timeLimitMs = milliseconds;
+        } else if (arg.size() > 1 && arg[0] == '-') {
+            error = "unknown option: " + std::string(arg);
+            return false;
+        } else {
+            paths.push_back(argv[i]);
+        }
+    }
+
+    if (paths.size() != 2) {
+        error = "expected two files";
+        return false;
+    }
+    options.basePath = paths[0];
+    options.changedPath = paths[1];
+    return true;
+}
+
+// ------------------------------------------------------------
+// unified diff
+//   - 파일 끝의 '\n' 뒤 빈 조각은 줄로 세지 않는다 (diff(1) 과 같은 줄 수)
+//   - '\n' 없이 끝나는 마지막 줄은 따로 ID 를 붙여 '\n' 으로 끝나는 같은 내용의
+//     줄과 다르게 비교하고, 출력 뒤에 "\ No newline at end of file" 을 붙인다
+// ------------------------------------------------------------
+inline std::vector<std::string_view> splitFileLines(std::string_view text, bool& missingNewline) {
+    std::vector<std::string_view> lines = splitLineViews(text);
+    missingNewline = !text.empty() && text.back() != '\n';
+    if (!missingNewline) lines.pop_back();
+    return lines;
+}
+
+// "@@ -a,b +c,d @@" 의 한쪽 범위 (GNU diff 와 같은 표기)
+inline void writeHunkRange(OutputBuffer& out, size_t start, size_t count) {
+    char text[48];
+    if (count == 0) {
+        std::snprintf(text, sizeof(text), "%zu,0", start);
+    } else if (count == 1) {
+        std::snprintf(text, sizeof(text), "%zu", start + 1);
+    } else {
+        std::snprintf(text, sizeof(text), "%zu,%zu", start + 1, count);
+    }
+    out.write(text);
+}
+
+inline bool writeUnifiedDiff(OutputBuffer& out, const CliOptions& options, std::string_view baseText,
+                             std::string_view changedText, uint32_t& degraded) {
+    bool aMissingNewline = false;
+    bool bMissingNewline = false;
+    std::vector<std::string_view> aLines = splitFileLines(baseText, aMissingNewline);
+    std::vector<std::string_view> bLines = splitFileLines(changedText, bMissingNewline);
+    InternedLines lines = internLineViews(std::move(aLines), std::move(bLines), options.diff.normalize);
+
+    if (aMissingNewline) {
+        lines.aIds.back() = lines.idCount++;
+    }
+    if (bMissingNewline) {
+        bool sameLastLine =
+            aMissingNewline && equalNormalizedLines(lines.aLines.back(), lines.bLines.back(), options.diff.normalize);
+        lines.bIds.back() = sameLastLine ? lines.aIds.back() : lines.idCount++;
+    }
+
+    std::vector<IndexedEdit> edits = runLineDiff(lines, options.diff, &degraded);
+    const size_t context = static_cast<size_t>(options.context);
+    const int aLast = static_cast<int>(lines.aLines.size()) - 1;
+    const int bLast = static_cast<int>(lines.bLines.size()) - 1;
+
+    bool headerWritten = false;
+    size_t aPos = 0;  // edits[k] 앞까지 지나온 기준 줄 수
+    size_t bPos = 0;
+    size_t k = 0;
+    auto advance = [&](const IndexedEdit& e) {
+        if (e.op != '+') ++aPos;
+        if (e.op != '-') ++bPos;
+    };
+
+    while (k < edits.size()) {
+        size_t first = k;
+        while (first < edits.size() && edits[first].op == ' ') ++first;
+        if (first == edits.size()) break;
+
+        // 같은 줄이 2 * context 개 이하로 떨어진 변경은 한 hunk 로 묶음
+        size_t last = first;
+        for (size_t s = first + 1; s < edits.size() && s - last - 1 <= 2 * context; ++s) {
+            if (edits[s].op != ' ') last = s;
+        }
+        size_t start = first >= context ? first - context : 0;
+        size_t end = std::min(edits.size(), last + context + 1);
+
+        for (; k < start; ++k) advance(edits[k]);
+
+        size_t aCount = 0;
+        size_t bCount = 0;
+        for (size_t s = start; s < end; ++s) {
+            if (edits[s].op != '+') ++aCount;
+            if (edits[s].op != '-') ++bCount;
+        }
+
+        if (!headerWritten) {
+            out.write("--- ");
+            out.write(options.basePath);
+            out.write("\n+++ ");
+            out.write(options.changedPath);
+            out.write('\n');
+            headerWritten = true;
+        }
+        out.write("@@ -");
+        writeHunkRange(out, aPos, aCount);
+        out.write(" +");
+        writeHunkRange(out, bPos, bCount);
+        out.write(" @@\n");
+
+        for (; k < end; ++k) {
+            const IndexedEdit& e = edits[k];
+            bool noNewline;
+            out.write(e.op);
+            if (e.op == '+') {
+                out.write(lines.bLines[e.bIndex]);
+                noNewline = bMissingNewline && e.bIndex == bLast;
+            } else {
+                out.write(lines.aLines[e.aIndex]);
+                noNewline = aMissingNewline && e.aIndex == aLast;
+            }
+            out.write('\n');
+            if (noNewline) out.write("\\ No newline at end of file\n");
+            advance(e);
+        }
+    }
+    return headerWritten;
+}
+
+// ------------------------------------------------------------
+// out-of-core unified diff (--out-of-core)
+//   OutOfCoreDiff 가 흘려보내는 편집으로 writeUnifiedDiff 와 같은 hunk 를 만든다.
+//   - hunk 앞 문맥은 마지막 context 개의 같은 줄만 들고 있음
+//   - hunk 머리("@@ ... @@")의 줄 수를 먼저 써야 하므로 hunk 안의 레코드는 SpillBuffer 에
+//     모았다가, hunk 가 닫힐 때 줄 텍스트를 파일에서 가져와 씀
+//   - hunk 뒤 같은 줄이 2 * context 개를 넘으면 hunk 를 닫음
+// ------------------------------------------------------------
+class OutOfCoreUnifiedWriter {
+public:
+    // SpillBuffer 에 모아 두는 hunk 한 줄
+    struct HunkLine {
+        LineRecord line;  // ' ' / '-' 는 기준 줄, '+' 는 변경 줄
+        char op;
+    };
+
+    OutOfCoreUnifiedWriter(OutputBuffer& out, const CliOptions& options, LineFetcher& base, LineFetcher& changed,
+                           size_t spillItems)
+        : out_(out), options_(options), context_(static_cast<size_t>(options.context)), base_(base),
+          changed_(changed), hunk_(spillItems) {}
+
+    void add(char op, const LineRecord& line) {
+        if (failed_) return;
+        if (op == ' ') {
+            if (inHunk_) {
+                trailing_.push_back(line);
+                if (trailing_.size() > 2 * context_) closeHunk();
+            } else {
+                before_.push_back(line);
+                if (before_.size() > context_) before_.pop_front();
+            }
+            ++aPos_;
+            ++bPos_;
+            return;
+        }
+
+        if (!inHunk_) {
+            aStart_ = aPos_ - before_.size();
+            bStart_ = bPos_ - before_.size();
+            aCount_ = bCount_ = 0;
+            for (const LineRecord& equal : before_) pushLine(' ', equal);
+            before_.clear();
+            inHunk_ = true;
+        } else {
+            for (const LineRecord& equal : trailing_) pushLine(' ', equal);
+            trailing_.clear();
+        }
+        pushLine(op, line);
+        if (op == '-') ++aPos_;
+        else ++bPos_;
+    }
+
+    // 남은 hunk 를 닫음. 쓰다가 읽기 / 임시 파일 오류가 났으면 false
+    bool finish(std::string& error) {
+        if (inHunk_ && !failed_) closeHunk();
+        if (failed_) error = error_;
+        return !failed_;
+    }
+
+    bool different() const { return headerWritten_; }
+
+private:
+
+    OutputBuffer& out_;
+    const CliOptions& options_;
+    size_t context_;
+    LineFetcher& base_;
+    LineFetcher& changed_;
+    SpillBuffer<HunkLine> hunk_;
+    std::deque<LineRecord> before_;     // hunk 밖: 마지막 context 개의 같은 줄
+    std::vector<LineRecord> trailing_;  // hunk 안: 마지막 변경 뒤의 같은 줄 (2 * context 개까지)
+    bool inHunk_ = false;
+    bool headerWritten_ = false;
+    bool failed_ = false;
+    std::string error_;
+    uint64_t aPos_ = 0;  // 지금까지 지나온 기준 줄 수
+    uint64_t bPos_ = 0;
+    uint64_t aStart_ = 0;
+    uint64_t bStart_ = 0;
+    uint64_t aCount_ = 0;
+    uint64_t bCount_ = 0;
+
+    void pushLine(char op, const LineRecord& line) {
+        hunk_.push({line, op});
+        if (op != '+') ++aCount_;
+        if (op != '-') ++bCount_;
+    }
+
+    void closeHunk() {
+        size_t keep = std::min(trailing_.size(), context_);
+        for (size_t i = 0; i < keep; ++i) pushLine(' ', trailing_[i]);
+        before_.assign(trailing_.end() - std::min(trailing_.size() - keep, context_), trailing_.end());
+        trailing_.clear();
+        inHunk_ = false;
+
+        if (!headerWritten_) {
+            out_.write("--- ");
+            out_.write(options_.basePath);
+            out_.write("\n+++ ");
+            out_.write(options_.changedPath);
+            out_.write('\n');
+            headerWritten_ = true;
+        }
+        out_.write("@@ -");
+        writeHunkRange(out_, aStart_, aCount_);
+        out_.write(" +");
+        writeHunkRange(out_, bStart_, bCount_);
+        out_.write(" @@\n");
+
+        bool readOk = true;
+        bool spillOk = hunk_.forEach([&](const HunkLine& entry) {
+            if (!readOk) return;
+            LineFetcher& file = (entry.op == '+') ? changed_ : base_;
+            out_.write(entry.op);
+            readOk = file.read(entry.line, [&](std::string_view piece) { out_.write(piece); });
+            out_.write('\n');
+            if (entry.line.flags & LINE_RECORD_NO_NEWLINE) out_.write("\\ No newline at end of file\n");
+            if (!readOk) error_ = file.error();
+        });
+        if (!spillOk || hunk_.failed()) error_ = "cannot write temporary file";
+        failed_ = !readOk || !spillOk || hunk_.failed();
+        hunk_.clear();
+    }
+};
+
+// ------------------------------------------------------------
+// JSON: diff_text() 와 같은 형식
+//   row 를 OutputBuffer 에 바로 써서 FLUSH_BYTES 마다 내보냄 (접기도 같은 방식)
+// ------------------------------------------------------------
+inline bool writeJsonDiff(OutputBuffer& out, const CliOptions& options, std::string_view baseText,
+                          std::string_view changedText, uint32_t& degraded) {
+    InternedLines lines =
+        internLineViews(splitLineViews(baseText), splitLineViews(changedText), options.diff.normalize);
+    std::vector<DiffRow> rows = buildRows(runLineDiff(lines, options.diff, &degraded));
+
+    out.write("{\n  \"rows\": [\n");
+    appendResultRowsJson(out, rows, lines.aLines, lines.bLines, options.diff);
+    appendRowsJsonEnd(out, degraded);
+    out.write('\n');
+
+    return std::any_of(rows.begin(), rows.end(), [](const DiffRow& row) { return row.op != RowOp::Equal; });
+}
+
+// ------------------------------------------------------------
+// 바이너리: diff_text_binary() 와 같은 DFB1 형식 (offset 은 각 파일 시작 기준)
+//   헤더에 토큰 수가 들어가므로 먼저 replace row 의 토큰만 SpillBuffer 에 모으고
+//   (상한을 넘으면 임시 파일), 헤더 -> row -> 토큰 순으로 OutputBuffer 에 바로 쓴다
+//   임시 파일을 쓰거나 읽지 못하면 error 에 이유를 남긴다
+// ------------------------------------------------------------
+inline bool writeBinaryDiff(OutputBuffer& out, const CliOptions& options, std::string_view baseText,
+                            std::string_view changedText, uint32_t& degraded, std::string& error) {
+    static constexpr size_t TOKENS_IN_MEMORY = size_t{1} << 16;
+
+    InternedLines lines =
+        internLineViews(splitLineViews(baseText), splitLineViews(changedText), options.diff.normalize);
+    std::vector<DiffRow> rows = buildRows(runLineDiff(lines, options.diff, &degraded));
+    auto leftOf = [&](const DiffRow& row) {
+        return (row.leftIndex >= 0) ? lines.aLines[row.leftIndex] : std::string_view();
+    };
+    auto rightOf = [&](const DiffRow& row) {
+        return (row.rightIndex >= 0) ? lines.bLines[row.rightIndex] : std::string_view();
+    };
+    auto writeWords = [&](const uint32_t* words, size_t count) {
+        out.write(std::string_view(reinterpret_cast<const char*>(words), count * sizeof(uint32_t)));
+    };
+
+    SpillBuffer<BinaryToken> tokens(TOKENS_IN_MEMORY);
+    std::vector<uint32_t> tokenCounts;  // replace row 마다 토큰 수 (row 순서)
+    bool different = false;
+    for (const DiffRow& row : rows) {
+        different |= row.op != RowOp::Equal;
+        if (row.op != RowOp::Replace) continue;
+        std::string_view leftText = leftOf(row);
+        std::string_view rightText = rightOf(row);
+        std::vector<AlignedToken> aligned = alignTokens(leftText, rightText, options.diff.tokenMode);
+        for (const AlignedToken& t : aligned) {
+            uint32_t tokenOp = (t.op == 'M') ? 0 : (t.op == 'D') ? 1 : 2;
+            tokens.push(makeBinaryToken(tokenOp, baseText.data(), t.left, changedText.data(), t.right));
+        }
+        tokenCounts.push_back(static_cast<uint32_t>(aligned.size()));
+    }
+    if (tokens.failed()) {
+        error = "cannot write temporary file";
+        return different;
+    }
+
+    uint32_t header[BINARY_HEADER_WORDS];
+    fillBinaryResultHeader(header, static_cast<uint32_t>(rows.size()), static_cast<uint32_t>(tokens.size()),
+                           degraded);
+    writeWords(header, BINARY_HEADER_WORDS);
+
+    uint32_t tokenStart = 0;
+    size_t replaceIndex = 0;
+    for (const DiffRow& row : rows) {
+        uint32_t tokenCount = (row.op == RowOp::Replace) ? tokenCounts[replaceIndex++] : 0;
+        uint32_t words[BINARY_ROW_WORDS];
+        words[0] = static_cast<uint32_t>(row.op);
+        binarySpan(words + 1, baseText.data(), leftOf(row));
+        binarySpan(words + 3, changedText.data(), rightOf(row));
+        words[5] = tokenStart;
+        words[6] = tokenCount;
+        writeWords(words, BINARY_ROW_WORDS);
+        tokenStart += tokenCount;
+    }
+
+    if (!tokens.forEach([&](const BinaryToken& token) { writeWords(token.words, BINARY_TOKEN_WORDS); })) {
+        error = "cannot read temporary file";
+    }
+    return different;
+}
+
+// ------------------------------------------------------------
+// 델타: 기준에서 변경 파일을 다시 만드는 DFD1 바이트 (형식은 delta_patch.hpp)
+// ------------------------------------------------------------
+inline bool writeDeltaDiff(OutputBuffer& out, const CliOptions& options, std::string_view baseText,
+                           std::string_view changedText, uint32_t& degraded) {
+    DeltaEncoder encoder;
+    const std::vector<uint8_t>& delta = encoder.encode(baseText, changedText, options.deltaFlags, options.diff);
+    degraded |= encoder.degraded();
+    out.write(std::string_view(reinterpret_cast<const char*>(delta.data()), delta.size()));
+    return baseText != changedText;
+}
+
+// --apply: 기준 + 델타 -> stdout (검사 값이 맞을 때만 내보냄)
+inline int runApplyDelta(const CliOptions& options, std::string_view baseText, std::string_view deltaBytes) {
+    std::string target;
+    DeltaStatus status =
+        applyDelta(baseText, reinterpret_cast<const uint8_t*>(deltaBytes.data()), deltaBytes.size(), target);
+    if (status != DeltaStatus::Ok) {
+        std::fprintf(stderr, "diff: %s: %s\n", options.changedPath, deltaStatusName(status));
+        return 2;
+    }
+    std::fwrite(target.data(), 1, target.size(), stdout);
+    return std::fflush(stdout) != 0 ? 2 : 0;
+}
+
+// 예산에 걸려 결과가 최소 diff 가 아닐 수 있으면 stderr 에 이유를 남김
+inline void printDegradedWarning(uint32_t degraded) {
+    if (!degraded) return;
+    std::string reasons;
+    for (uint32_t reason : {DIFF_DEGRADED_COST, DIFF_DEGRADED_MEMORY, DIFF_DEGRADED_TIME}) {
+        if (!(degraded & reason)) continue;
+        if (!reasons.empty()) reasons += ", ";
+        reasons += degradedReasonName(reason);
+    }
+    std::fprintf(stderr, "diff: budget exceeded (%s), output may not be minimal\n", reasons.c_str());
+}
+
+inline int runOutOfCoreDiff(const CliOptions& options) {
+    if (options.format != CliFormat::Unified || options.applyDelta) {
+        std::fprintf(stderr, "diff: --out-of-core supports unified output only\n");
+        return 2;
+    }
+    if (options.diff.normalize != 0) {
+        std::fprintf(stderr, "diff: --out-of-core does not support white space / case options\n");
+        return 2;
+    }
+
+    OutOfCoreBudget budget = OutOfCoreBudget::fromBytes(options.outOfCoreBytes);
+    std::string error;
+    LineFetcher baseFile;
+    LineFetcher changedFile;
+    if (!baseFile.open(options.basePath, budget.blockBytes, error) ||
+        !changedFile.open(options.changedPath, budget.blockBytes, error)) {
+        std::fprintf(stderr, "diff: %s\n", error.c_str());
+        return 2;
+    }
+
+    OutputBuffer out(stdout);
+    OutOfCoreUnifiedWriter writer(out, options, baseFile, changedFile,
+                                  budget.spillBytes / sizeof(OutOfCoreUnifiedWriter::HunkLine));
+    OutOfCoreDiff engine(options.diff, budget);
+    bool ok = engine.run(options.basePath, options.changedPath,
+                         [&](char op, const LineRecord& line) { writer.add(op, line); }, error);
+    ok = ok && writer.finish(error);
+    out.flush();
+    if (!ok) {
+        std::fprintf(stderr, "diff: %s\n", error.c_str());
+        return 2;
+    }
+    if (std::fflush(stdout) != 0) return 2;
+    printDegradedWarning(engine.degraded());
+    return writer.different() ? 1 : 0;
+}
+
+// ------------------------------------------------------------
+// 디렉터리 비교
+//   - 짝이 맞은 파일은 크기가 큰 것부터 스케줄러에 넣고, 파일 하나의 diff 는 단일 스레드
+//     (스레드는 파일 사이에 나눠 쓰고, 큰 파일 하나가 나머지를 막지 않게 함)
+//   - 파일별 출력은 메모리에 모았다가, 앞 경로가 다 끝난 것부터 경로 순서대로 내보냄
+// ------------------------------------------------------------
+struct TreeFileResult {
+    std::string output;  // unified diff 또는 "Only in ..." / "File ... is a ..." 줄
+    std::string error;
+    double ms = 0.0;
+    int worker = -1;  // 처리한 스레드 (diff 하지 않은 항목은 -1)
+    uint32_t degraded = 0;
+};
+
+// 한쪽에만 있는 파일 / 디렉터리 (diff(1) 과 같은 "Only in <디렉터리>: <이름>")
+inline std::string treeOnlyInLine(const std::string& path) {
+    std::filesystem::path full(path);
+    return "Only in " + full.parent_path().string() + ": " + full.filename().string() + "\n";
+}
+
+// 한쪽은 파일, 한쪽은 디렉터리 (diff(1) 과 같은 "File <기준> is a ... while file <변경> is a ...")
+inline std::string treeTypeMismatchLine(const TreeEntry& entry) {
+    auto kind = [](bool directory, uint64_t size) {
+        return directory ? "directory" : size == 0 ? "regular empty file" : "regular file";
+    };
+    return "File " + entry.basePath + " is a " + kind(entry.baseIsDirectory, entry.baseSize) + " while file " +
+           entry.changedPath + " is a " + kind(entry.changedIsDirectory, entry.changedSize) + "\n";
+}
+
+inline void writeTreeSummary(FILE* file, const std::vector<TreeEntry>& entries,
+                             const std::vector<TreeFileResult>& results, int threads, size_t steals, double totalMs) {
+    std::string json = "{\n  \"threads\": " + std::to_string(threads) + ",\n  \"steals\": " +
+                       std::to_string(steals) + ",\n";
+    char number[32];
+    std::snprintf(number, sizeof(number), "%.3f", totalMs);
+    json += "  \"total_ms\": ";
+    json += number;
+    json += ",\n  \"files\": [\n";
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const TreeEntry& entry = entries[i];
+        const TreeFileResult& result = results[i];
+        if (i > 0) json += ",\n";
+        json += "    {\"path\":\"";
+        appendEscapedJson(json, entry.relativePath);
+        json += "\",\"status\":\"";
+        json += treeEntryStatusName(entry.status);
+        json += "\",\"base_size\":" + std::to_string(entry.baseSize);
+        json += ",\"changed_size\":" + std::to_string(entry.changedSize);
+        std::snprintf(number, sizeof(number), "%.3f", result.ms);
+        json += ",\"ms\":";
+        json += number;
+        json += ",\"worker\":" + std::to_string(result.worker);
+        if (result.degraded) json += ",\"degraded\":true";
+        json += '}';
+    }
+    json += "\n  ]\n}\n";
+    std::fwrite(json.data(), 1, json.size(), file);
+}
+
+inline int runTreeDiff(const CliOptions& options) {
+    using Clock = std::chrono::steady_clock;
+    auto elapsedMs = [](Clock::time_point from) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - from).count();
+    };
+    const Clock::time_point treeStart = Clock::now();
+
+    if (options.format != CliFormat::Unified) {
+        std::fprintf(stderr, "diff: directory comparison supports unified output only\n");
+        return 2;
+    }
+
+    std::vector<TreeEntry> entries;
+    std::string error;
+    if (!pairTreeFiles(options.basePath, options.changedPath, entries, error)) {
+        std::fprintf(stderr, "diff: %s\n", error.c_str());
+        return 2;
+    }
+
+    std::vector<TreeFileResult> results(entries.size());
+    std::vector<uint8_t> finished(entries.size(), 0);
+    std::vector<size_t> order;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const TreeEntry& entry = entries[i];
+        if (entry.status == TreeEntryStatus::Modified) {
+            order.push_back(i);
+            continue;
+        }
+        results[i].output = entry.status == TreeEntryStatus::TypeMismatch ? treeTypeMismatchLine(entry)
+                            : entry.status == TreeEntryStatus::OnlyBase   ? treeOnlyInLine(entry.basePath)
+                                                                          : treeOnlyInLine(entry.changedPath);
+        finished[i] = 1;
+    }
+    auto fileSize = [&](size_t i) { return std::max(entries[i].baseSize, entries[i].changedSize); };
+    std::stable_sort(order.begin(), order.end(), [&](size_t x, size_t y) { return fileSize(x) > fileSize(y); });
+
+    // 앞 경로가 모두 끝난 항목부터 차례로 출력 (printMutex 를 잡고 호출)
+    std::mutex printMutex;
+    size_t nextToPrint = 0;
+    auto printReady = [&] {
+        for (; nextToPrint < entries.size() && finished[nextToPrint]; ++nextToPrint) {
+            TreeFileResult& result = results[nextToPrint];
+            if (!result.error.empty()) std::fprintf(stderr, "diff: %s\n", result.error.c_str());
+            std::fwrite(result.output.data(), 1, result.output.size(), stdout);
+            std::string().swap(result.output);
+        }
+    };
+
+    CliOptions fileOptions = options;
+    fileOptions.diff.threads = 1;
+    WorkStealingScheduler scheduler(options.diff.threads);
+    scheduler.run(order, [&](size_t i, int worker) {
+        const Clock::time_point fileStart = Clock::now();
+        TreeEntry& entry = entries[i];
+        TreeFileResult& result = results[i];
+
+        MappedFile baseFile;
+        MappedFile changedFile;
+        if (!baseFile.open(entry.basePath.c_str(), result.error) ||
+            !changedFile.open(entry.changedPath.c_str(), result.error)) {
+            entry.status = TreeEntryStatus::Error;
+        } else if (sameContent(baseFile.view(), changedFile.view())) {
+            entry.status = TreeEntryStatus::Identical;
+        } else {
+            CliOptions pairOptions = fileOptions;
+            pairOptions.basePath = entry.basePath.c_str();
+            pairOptions.changedPath = entry.changedPath.c_str();
+            OutputBuffer out(nullptr);
+            bool different = writeUnifiedDiff(out, pairOptions, baseFile.view(), changedFile.view(), result.degraded);
+            entry.status = different ? TreeEntryStatus::Modified : TreeEntryStatus::Identical;
+            result.output = std::move(out.raw());
+        }
+        result.ms = elapsedMs(fileStart);
+        result.worker = worker;
+
+        std::lock_guard<std::mutex> lock(printMutex);
+        finished[i] = 1;
+        printReady();
+    });
+    printReady();
+    if (std::fflush(stdout) != 0) return 2;
+
+    bool different = false;
+    bool failed = false;
+    uint32_t degraded = 0;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        different |= entries[i].status != TreeEntryStatus::Identical && entries[i].status != TreeEntryStatus::Error;
+        failed |= entries[i].status == TreeEntryStatus::Error;
+        degraded |= results[i].degraded;
+    }
+
+    if (options.summaryPath) {
+        bool toStderr = std::strcmp(options.summaryPath, "-") == 0;
+        FILE* summary = toStderr ? stderr : std::fopen(options.summaryPath, "wb");
+        if (!summary) {
+            std::fprintf(stderr, "diff: %s: cannot write summary\n", options.summaryPath);
+            return 2;
+        }
+        writeTreeSummary(summary, entries, results, scheduler.size(), scheduler.steals(), elapsedMs(treeStart));
+        if (!toStderr) std::fclose(summary);
+    }
+
+    printDegradedWarning(degraded);
+    return failed ? 2 : different ? 1 : 0;
+}
+
+inline int runCli(int argc, char** argv) {
+    CliOptions options;
+    std::string error;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "-h") == 0 || std::strcmp(argv[i], "--help") == 0) {
+            printCliUsage(stdout);
+            return 0;
+        }
+    }
+    if (!parseCliOptions(argc, argv, options, error)) {
+        std::fprintf(stderr, "diff: %s\n", error.c_str());
+        printCliUsage(stderr);
+        return 2;
+    }
+
+    std::error_code ec;
+    bool baseIsDirectory = std::filesystem::is_directory(options.basePath, ec);
+    bool changedIsDirectory = std::filesystem::is_directory(options.changedPath, ec);
+    if (baseIsDirectory && changedIsDirectory) {
+        if (options.outOfCoreBytes || options.applyDelta) {
+            std::fprintf(stderr, "diff: %s compares two files\n", options.applyDelta ? "--apply" : "--out-of-core");
+            return 2;
+        }
+        return runTreeDiff(options);
+    }
+    if (baseIsDirectory || changedIsDirectory) {
+        std::fprintf(stderr, "diff: cannot compare a directory with a file\n");
+        return 2;
+    }
+    if (options.outOfCoreBytes) {
+        return runOutOfCoreDiff(options);
+    }
+
+    MappedFile baseFile;
+    MappedFile changedFile;
+    if (!baseFile.open(options.basePath, error) || !changedFile.open(options.changedPath, error)) {
+        std::fprintf(stderr, "diff: %s\n", error.c_str());
+        return 2;
+    }
+
+    if (options.applyDelta) {
+        return runApplyDelta(options, baseFile.view(), changedFile.view());
+    }
+
+    OutputBuffer out(stdout);
+    bool different = false;
+    uint32_t degraded = 0;
+    switch (options.format) {
+        case CliFormat::Unified:
+            different = writeUnifiedDiff(out, options, baseFile.view(), changedFile.view(), degraded);
+            break;
+        case CliFormat::Json:
+            different = writeJsonDiff(out, options, baseFile.view(), changedFile.view(), degraded);
+            break;
+        case CliFormat::Binary:
+            different = writeBinaryDiff(out, options, baseFile.view(), changedFile.view(), degraded, error);
+            break;
+        case CliFormat::Delta:
+            different = writeDeltaDiff(out, options, baseFile.view(), changedFile.view(), degraded);
+            break;
+    }
+    out.flush();
+    if (!error.empty()) {
+        std::fprintf(stderr, "diff: %s\n", error.c_str());
+        return 2;
+    }
+    if (std::fflush(stdout) != 0) return 2;
+    printDegradedWarning(degraded);
+    return different ? 1 : 0;
+}
@@ -0,0 +1,350 @@
+// ------------------------------------------------------------
+// 바이너리 델타 (기준 -> 대상 패치) 와 패치 적용
+// ------------------------------------------------------------
+// 스냅샷을 이전 스냅샷과의 차이로만 저장하기 위한 형식. JSON rows 처럼 같은 줄의 텍스트를
+// 담지 않고, 대상 텍스트를 "기준의 바이트 구간 복사" 와 "새 바이트 삽입" 의 나열로 적는다.
+// 모든 값은 리틀 엔디언.
+//
+//   [헤더] 40 bytes
+//      0: magic          'DFD1' (0x31444644)
+//      4: version        1
+//      5: flags          DELTA_FLAG_VARINT
+//      6: (예약)          0
+//      8: baseLength     u64
+//     16: targetLength   u64
+//     24: baseChecksum   u64  hashBytes(기준 전체), 다른 기준에 적용하는 것을 막음
+//     32: targetChecksum u64  hashBytes(대상 전체), 적용 결과 검증
+//
+//   [op] 헤더 뒤부터 끝까지
+//     DELTA_FLAG_VARINT : varint(length << 1 | kind)
+//                         kind 0 (copy)   : zigzag varint(기준 위치 - 직전 copy 의 끝)
+//                         kind 1 (insert) : length 바이트의 원문
+//     고정 폭           : u8 kind, u64 length
+//                         copy   : u64 기준 위치
+//                         insert : length 바이트의 원문
+//
+// 인코더는 줄 diff 결과로 op 를 만든다.
+//   - 같은 줄 -> 기준의 그 줄 복사 (연속된 줄은 copy 하나로 합침)
+//   - 추가된 줄도 기준 어딘가에 같은 줄이 있으면 (옮겨진 블록) 복사로 적고,
+//     그 외에는 insert 로 원문을 담음 (연속된 insert 는 하나로 합침)
+//   - 삭제된 줄은 아무것도 적지 않음
+// 줄 비교는 바이트 그대로 (정규화 없음) 이고, '\n' 까지 포함한 구간을 복사한다.
+//
+// 적용은 op 를 한 번 훑으며 대상 뒤에 이어 붙이고 (applyDelta), 기준 / 대상 검사 값을
+// 확인한다. 잘못된 패치는 범위를 넘기 전에 DeltaStatus 로 멈춘다 (헤더의 대상 길이도
+// op 로 만들 수 있는 길이인지 먼저 본다).
+// ------------------------------------------------------------
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "diff_core.hpp"
+
+constexpr uint32_t DELTA_MAGIC = 0x31444644u;  // "DFD1"
+constexpr uint8_t DELTA_VERSION = 1;
+constexpr size_t DELTA_HEADER_BYTES = 40;
+constexpr uint32_t DELTA_FLAG_VARINT = 1u << 0;
+
+// 옮겨진 줄을 insert 대신 copy 로 적는 최소 길이 (짧은 줄은 원문이 copy op 보다 작거나 비슷함)
+constexpr size_t DELTA_MIN_MOVED_COPY_BYTES = 16;
+
+enum class DeltaStatus {
+    Ok = 0,
+    BadHeader = 1,         // magic / version 이 다르거나 헤더가 잘림
+    BaseMismatch = 2,      // 기준 길이 / 검사 값이 패치를 만든 기준과 다름
+    Corrupt = 3,           // op 가 잘렸거나 기준 / 대상 범위를 넘음
+    ChecksumMismatch = 4,  // 적용 결과의 검사 값이 다름
+};
+
+inline const char* deltaStatusName(DeltaStatus status) {
+    switch (status) {
+        case DeltaStatus::Ok: return "ok";
+        case DeltaStatus::BadHeader: return "not a delta (bad header)";
+        case DeltaStatus::BaseMismatch: return "delta was made from a different base";
+        case DeltaStatus::Corrupt: return "corrupt delta";
+        case DeltaStatus::ChecksumMismatch: return "target checksum mismatch";
+    }
+    return "unknown";
+}
+
+// ------------------------------------------------------------
+// 델타 작성기
+//   줄 분할 / diff / 출력 버퍼를 멤버로 들고 있어 같은 객체로 반복 호출하면 버퍼를 재사용한다
+//   (결과는 다음 encode 전까지 유효)
+// ------------------------------------------------------------
+class DeltaEncoder {
+public:
+    const std::vector<uint8_t>& encode(std::string_view base, std::string_view target, uint32_t flags,
+                                       const DiffOptions& options = DiffOptions()) {
+        flags_ = flags & DELTA_FLAG_VARINT;
+        out_.assign(DELTA_HEADER_BYTES, 0);
+        pending_ = Pending::None;
+        baseBegin_ = base.data();
+        lastCopyEnd_ = 0;
+
+        DiffOptions exact = options;
+        exact.normalize = 0;
+        InternedLines lines = internLineViews(splitLineViews(base), splitLineViews(target));
+        // 마지막 조각은 '\n' 이 없으므로 양쪽 마지막 조각이 똑같을 때만 같은 줄로 봄
+        //   (그래야 같은 ID 의 줄은 '\n' 까지 포함한 바이트 구간이 같음)
+        bool sameLast = lines.aLines.back() == lines.bLines.back();
+        lines.aIds.back() = lines.idCount++;
+        lines.bIds.back() = sameLast ? lines.aIds.back() : lines.idCount++;
+
+        const std::vector<IndexedEdit>& edits = runLineDiff(lines, exact, scratch_);
+        degraded_ = scratch_.degraded;
+
+        firstBaseLine_.assign(lines.idCount, -1);
+        for (int i = static_cast<int>(lines.aIds.size()) - 1; i >= 0; --i) firstBaseLine_[lines.aIds[i]] = i;
+
+        const int aSize = static_cast<int>(lines.aIds.size());
+        int nextBaseLine = 0;  // 직전 copy 가 끝난 다음 기준 줄
+        for (const IndexedEdit& e : edits) {
+            if (e.op == ' ') {
+                copy(lineSpan(base, lines.aLines, e.aIndex));
+                nextBaseLine = e.aIndex + 1;
+            } else if (e.op == '+') {
+                uint32_t id = lines.bIds[e.bIndex];
+                std::string_view line = lineSpan(target, lines.bLines, e.bIndex);
+                // 직전 copy 를 그대로 이어 갈 수 있으면 길이와 상관없이 copy
+                int from = (nextBaseLine < aSize && lines.aIds[nextBaseLine] == id) ? nextBaseLine
+                           : line.size() >= DELTA_MIN_MOVED_COPY_BYTES                  ? firstBaseLine_[id]
+                                                                                       : -1;
+                if (from >= 0) {
+                    copy(lineSpan(base, lines.aLines, from));
+                    nextBaseLine = from + 1;
+                } else {
+                    insert(line);
+                }
+            }
+        }
+        flush();
+
+        writeHeader(base, target);
+        return out_;
+    }
+
+    const std::vector<uint8_t>& result() const { return out_; }
+    uint32_t degraded() const { return degraded_; }
+
+private:
+    enum class Pending { None, Copy, Insert };
+
+    uint32_t flags_ = 0;
+    std::vector<uint8_t> out_;
+    LineDiffScratch scratch_;
+    std::vector<int> firstBaseLine_;  // 줄 ID -> 그 줄이 처음 나오는 기준 줄 번호
+    uint32_t degraded_ = 0;
+
+    // 아직 쓰지 않은 op (text 의 연속 구간)
+    Pending pending_ = Pending::None;
+    const char* pendingBegin_ = nullptr;
+    size_t pendingLength_ = 0;
+    const char* baseBegin_ = nullptr;  // copy 의 기준 위치 = pendingBegin_ - baseBegin_
+    uint64_t lastCopyEnd_ = 0;
+
+    // i 번째 줄을 '\n' 까지 포함한 구간으로 (마지막 조각에는 '\n' 이 없음)
+    static std::string_view lineSpan(std::string_view text, const std::vector<std::string_view>& lines, int i) {
+        std::string_view line = lines[i];
+        size_t offset = static_cast<size_t>(line.data() - text.data());
+        return text.substr(offset, line.size() + (static_cast<size_t>(i) + 1 < lines.size() ? 1 : 0));
+    }
+
+    void copy(std::string_view span) {
+        if (span.empty()) return;
+        if (pending_ == Pending::Copy && pendingBegin_ + pendingLength_ == span.data()) {
+            pendingLength_ += span.size();
+            return;
+        }
+        flush();
+        pending_ = Pending::Copy;
+        pendingBegin_ = span.data();
+        pendingLength_ = span.size();
+    }
+
+    void insert(std::string_view span) {
+        if (span.empty()) return;
+        if (pending_ == Pending::Insert && pendingBegin_ + pendingLength_ == span.data()) {
+            pendingLength_ += span.size();
+            return;
+        }
+        flush();
+        pending_ = Pending::Insert;
+        pendingBegin_ = span.data();
+        pendingLength_ = span.size();
+    }
+
+    void flush() {
+        if (pending_ == Pending::None) return;
+        uint64_t length = pendingLength_;
+        uint8_t kind = pending_ == Pending::Insert ? 1 : 0;
+        if (flags_ & DELTA_FLAG_VARINT) {
+            putVarint((length << 1) | kind);
+        } else {
+            out_.push_back(kind);
+            putFixed(length);
+        }
+        if (pending_ == Pending::Copy) {
+            uint64_t offset = static_cast<uint64_t>(pendingBegin_ - baseBegin_);
+            if (flags_ & DELTA_FLAG_VARINT) {
+                int64_t delta = static_cast<int64_t>(offset - lastCopyEnd_);
+                putVarint((static_cast<uint64_t>(delta) << 1) ^ static_cast<uint64_t>(delta >> 63));
+            } else {
+                putFixed(offset);
+            }
+            lastCopyEnd_ = offset + length;
+        } else {
+            out_.insert(out_.end(), pendingBegin_, pendingBegin_ + pendingLength_);
+        }
+        pending_ = Pending::None;
+    }
+
+    void putVarint(uint64_t value) {
+        while (value >= 0x80) {
+            out_.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out_.push_back(static_cast<uint8_t>(value));
+    }
+
+    void putFixed(uint64_t value) {
+        for (int i = 0; i < 8; ++i) out_.push_back(static_cast<uint8_t>(value >> (i * 8)));
+    }
+
+    void writeHeader(std::string_view base, std::string_view target) {
+        auto put = [&](size_t at, uint64_t value, int bytes) {
+            for (int i = 0; i < bytes; ++i) out_[at + i] = static_cast<uint8_t>(value >> (i * 8));
+        };
+        put(0, DELTA_MAGIC, 4);
+        put(4, DELTA_VERSION, 1);
+        put(5, flags_, 1);
+        put(8, base.size(), 8);
+        put(16, target.size(), 8);
+        put(24, hashBytes(base.data(), base.size()), 8);
+        put(32, hashBytes(target.data(), target.size()), 8);
+    }
+};
+
+// ------------------------------------------------------------
+// 패치 적용: 기준 + 델타 -> target
+//   op 를 한 번 훑으며 target 뒤에 이어 붙이고, 끝나면 대상 검사 값을 확인
+//   - 헤더의 targetLength 만 믿고 크기를 잡지 않는다 (op 로 만들 수 없는 길이는 Corrupt,
+//     미리 잡는 용량도 델타 + 기준 크기까지). 비트 하나만 깨져도 수백 GB 를 요청할 수 있음
+//   실패하면 target 내용은 정해져 있지 않다
+// ------------------------------------------------------------
+class DeltaReader {
+public:
+    DeltaReader(const uint8_t* data, size_t length) : pos_(data), end_(data + length) {}
+
+    bool fixed(uint64_t& value, int bytes) {
+        if (end_ - pos_ < bytes) return false;
+        value = 0;
+        for (int i = 0; i < bytes; ++i) value |= static_cast<uint64_t>(pos_[i]) << (i * 8);
+        pos_ += bytes;
+        return true;
+    }
+
+    bool varint(uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64 && pos_ < end_; shift += 7) {
+            uint8_t byte = *pos_++;
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+
+    // 원문 length 바이트 (남은 바이트보다 길면 nullptr)
+    const uint8_t* bytes(uint64_t length) {
+        if (static_cast<uint64_t>(end_ - pos_) < length) return nullptr;
+        const uint8_t* start = pos_;
+        pos_ += length;
+        return start;
+    }
+
+    bool done() const { return pos_ == end_; }
+    size_t remaining() const { return static_cast<size_t>(end_ - pos_); }
+
+private:
+    const uint8_t* pos_;
+    const uint8_t* end_;
+};
+
+inline DeltaStatus applyDelta(std::string_view base, const uint8_t* delta, size_t deltaLength, std::string& target) {
+    DeltaReader reader(delta, deltaLength);
+    uint64_t magic, version, flags, reserved, baseLength, targetLength, baseChecksum, targetChecksum;
+    if (!reader.fixed(magic, 4) || !reader.fixed(version, 1) || !reader.fixed(flags, 1) ||
+        !reader.fixed(reserved, 2) || !reader.fixed(baseLength, 8) || !reader.fixed(targetLength, 8) ||
+        !reader.fixed(baseChecksum, 8) || !reader.fixed(targetChecksum, 8) || magic != DELTA_MAGIC ||
+        version != DELTA_VERSION) {
+        return DeltaStatus::BadHeader;
+    }
+    if (baseLength != base.size() || baseChecksum != hashBytes(base.data(), base.size())) {
+        return DeltaStatus::BaseMismatch;
+    }
+
+    // op 바이트로 만들 수 있는 최대 길이: insert 원문은 남은 바이트 이하,
+    // copy 는 op 하나(varint 2 바이트 이상, 고정 폭 17 바이트)에 기준 길이까지
+    const bool varint = (flags & DELTA_FLAG_VARINT) != 0;
+    const uint64_t opBytes = reader.remaining();
+    const uint64_t copyOps = opBytes / (varint ? 2 : 17);
+    uint64_t maxCopied = UINT64_MAX;
+    if (base.empty()) {
+        maxCopied = 0;
+    } else if (copyOps <= UINT64_MAX / base.size()) {
+        maxCopied = copyOps * base.size();
+    }
+    if (targetLength > target.max_size() || targetLength - std::min(targetLength, opBytes) > maxCopied) {
+        return DeltaStatus::Corrupt;
+    }
+
+    target.clear();
+    target.reserve(static_cast<size_t>(std::min<uint64_t>(targetLength, opBytes + base.size())));
+    uint64_t written = 0;
+    uint64_t lastCopyEnd = 0;
+    while (!reader.done()) {
+        uint64_t length;
+        uint64_t kind;
+        if (varint) {
+            uint64_t head;
+            if (!reader.varint(head)) return DeltaStatus::Corrupt;
+            kind = head & 1;
+            length = head >> 1;
+        } else if (!reader.fixed(kind, 1) || kind > 1 || !reader.fixed(length, 8)) {
+            return DeltaStatus::Corrupt;
+        }
+        if (length > targetLength - written) return DeltaStatus::Corrupt;
+
+        const char* source;
+        if (kind == 0) {
+            uint64_t offset;
+            if (varint) {
+                uint64_t zigzag;
+                if (!reader.varint(zigzag)) return DeltaStatus::Corrupt;
+                int64_t delta = static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+                offset = lastCopyEnd + static_cast<uint64_t>(delta);
+            } else if (!reader.fixed(offset, 8)) {
+                return DeltaStatus::Corrupt;
+            }
+            if (offset > base.size() || length > base.size() - offset) return DeltaStatus::Corrupt;
+            source = base.data() + offset;
+            lastCopyEnd = offset + length;
+        } else {
+            const uint8_t* literal = reader.bytes(length);
+            if (!literal) return DeltaStatus::Corrupt;
+            source = reinterpret_cast<const char*>(literal);
+        }
+        target.append(source, static_cast<size_t>(length));
+        written += length;
+    }
+
+    if (written != targetLength) return DeltaStatus::Corrupt;
+    if (targetChecksum != hashBytes(target.data(), target.size())) return DeltaStatus::ChecksumMismatch;
+    return DeltaStatus::Ok;
+}
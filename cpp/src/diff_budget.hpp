@@ -0,0 +1,95 @@
+// ------------------------------------------------------------
+// 줄 단위 diff 의 비용 예산 (GNU diff 의 "too expensive" 휴리스틱과 같은 방식)
+// ------------------------------------------------------------
+// 완전히 다른 큰 두 파일을 Myers 로 비교하면 D 가 n + m 에 가까워져 시간이
+// O((n + m) * D), 기존 Myers 는 메모리도 O(D^2) 로 늘어난다. 예산을 주면
+//
+//   - maxCost        : Myers 탐색 한 번에서 D 를 이 값까지만 늘린다.
+//                      넘으면 지금까지 가장 멀리 간 대각선의 끝점에서 구간을 나눠
+//                      양쪽을 따로 diff 한다 (결과는 유효하지만 최소가 아닐 수 있음)
+//   - maxMemoryBytes : Myers 탐색 상태(trace, V 배열)가 이 크기를 넘으면 더 늘리지 않음
+//   - timeLimitMs    : 줄 diff 시작부터 이 시간이 지나면 남은 구간은 탐색 없이
+//                      (앞/뒤 공통 줄만 맞추고) 삭제 + 추가로 처리
+//
+// 예산 때문에 결과가 달라질 수 있었으면 그 이유를 DIFF_DEGRADED_* 비트로 남긴다.
+// 예산이 없으면(기본값) 엔진은 BudgetState 없이 기존과 똑같이 동작한다.
+// ------------------------------------------------------------
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// 결과가 최소 diff 가 아닐 수 있는 이유 (비트 조합)
+constexpr uint32_t DIFF_DEGRADED_COST = 1u << 0;
+constexpr uint32_t DIFF_DEGRADED_MEMORY = 1u << 1;
+constexpr uint32_t DIFF_DEGRADED_TIME = 1u << 2;
+
+// 이유 비트 -> 이름 (JSON 의 "degraded" 배열, CLI 경고에 사용)
+inline const char* degradedReasonName(uint32_t reason) {
+    switch (reason) {
+        case DIFF_DEGRADED_COST: return "cost";
+        case DIFF_DEGRADED_MEMORY: return "memory";
+        default: return "time";
+    }
+}
+
+struct DiffBudget {
+    int maxCost = 0;            // 0 = 제한 없음
+    size_t maxMemoryBytes = 0;  // 0 = 제한 없음
+    double timeLimitMs = 0.0;   // 0 = 제한 없음
+
+    bool limited() const { return maxCost > 0 || maxMemoryBytes > 0 || timeLimitMs > 0.0; }
+};
+
+// ------------------------------------------------------------
+// 실행 한 번의 예산 사용량 (병렬 diff 의 작업자들이 같이 쓰므로 atomic)
+// ------------------------------------------------------------
+class BudgetState {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit BudgetState(const DiffBudget& budget)
+        : budget_(budget),
+          deadline_(Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                                       std::chrono::duration<double, std::milli>(budget.timeLimitMs))) {}
+
+    // 탐색 한 번에서 허용하는 D (0 = 제한 없음)
+    int maxCost() const { return budget_.maxCost; }
+
+    // 시간이나 메모리가 바닥났으면 true (남은 구간은 탐색하지 말 것)
+    bool exhausted() {
+        if (reasons_.load(std::memory_order_relaxed) & (DIFF_DEGRADED_MEMORY | DIFF_DEGRADED_TIME)) return true;
+        if (budget_.timeLimitMs > 0.0 && Clock::now() >= deadline_) {
+            degrade(DIFF_DEGRADED_TIME);
+            return true;
+        }
+        return false;
+    }
+
+    // 탐색 상태 bytes 만큼 쓰기 전에 호출. 상한을 넘으면 false (사용량은 그대로)
+    bool reserve(size_t bytes) {
+        if (budget_.maxMemoryBytes == 0) return true;
+        size_t used = memoryUsed_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        if (used > budget_.maxMemoryBytes) {
+            memoryUsed_.fetch_sub(bytes, std::memory_order_relaxed);
+            degrade(DIFF_DEGRADED_MEMORY);
+            return false;
+        }
+        return true;
+    }
+
+    void release(size_t bytes) {
+        if (budget_.maxMemoryBytes > 0) memoryUsed_.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    void degrade(uint32_t reason) { reasons_.fetch_or(reason, std::memory_order_relaxed); }
+    uint32_t degraded() const { return reasons_.load(std::memory_order_relaxed); }
+
+private:
+    DiffBudget budget_;
+    Clock::time_point deadline_;
+    std::atomic<size_t> memoryUsed_{0};
+    std::atomic<uint32_t> reasons_{0};
+};
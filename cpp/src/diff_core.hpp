@@ -0,0 +1,1081 @@
+// ------------------------------------------------------------
+// diff 핵심 파이프라인
+// ------------------------------------------------------------
+//   줄 ID 배열 -> (Myers / 선형 Myers / Patience / Histogram) -> 편집 스크립트
+//   -> row 목록(equal / delete / insert / replace) -> JSON
+//
+// diff_text(), 스트리밍 세션 등 모든 진입점이 같은 파이프라인을 사용한다.
+// ------------------------------------------------------------
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "anchored_diff.hpp"
+#include "bit_lcs.hpp"
+#include "diff_budget.hpp"
+#include "diff_stats.hpp"
+#include "edit_script.hpp"
+#include "line_index.hpp"
+#include "myers_linear.hpp"
+#include "sequence_diff.hpp"
+#include "simd_scan.hpp"
+#include "worker_pool.hpp"
+
+// ------------------------------------------------------------
+// 줄 단위 diff 에 사용할 알고리즘
+//   Myers       : 기존 구현 (D 마다 V 를 trace 에 저장)
+//   MyersLinear : 선형 공간 Myers (middle snake + 분할 정복)
+//   Patience    : 양쪽에 한 번씩만 나오는 줄을 앵커로 재귀 분할
+//   Histogram   : 가장 드물게 나오는 줄을 앵커로 재귀 분할
+// ------------------------------------------------------------
+enum class DiffAlgorithm {
+    Myers = 0,
+    MyersLinear = 1,
+    Patience = 2,
+    Histogram = 3,
+};
+
+// replace 줄 안의 토큰 단위
+//   Word : 띄어쓰기 기준 단어
+//   Char : 글자 (UTF-8 코드 포인트), 같은 종류가 이어지면 하나의 토큰으로 합침
+enum class TokenMode {
+    Word = 0,
+    Char = 1,
+};
+
+// diff_text_ex 의 flags 비트
+constexpr int DIFF_FLAG_TRIM_COMMON = 1 << 0;  // 앞/뒤 공통 줄을 먼저 잘라냄
+constexpr int DIFF_FLAG_CHAR_TOKENS = 1 << 1;  // replace 줄의 토큰을 글자 단위로
+constexpr int DIFF_FLAG_IGNORE_CR = 1 << 2;            // 줄 끝 '\r' 무시 (CRLF == LF)
+constexpr int DIFF_FLAG_IGNORE_ALL_SPACE = 1 << 3;     // 공백 모두 무시
+constexpr int DIFF_FLAG_IGNORE_SPACE_CHANGE = 1 << 4;  // 공백 개수 차이와 줄 끝 공백 무시
+constexpr int DIFF_FLAG_IGNORE_CASE = 1 << 5;          // ASCII 대소문자 무시
+
+// ------------------------------------------------------------
+// diff 실행 옵션
+// ------------------------------------------------------------
+struct DiffOptions {
+    DiffAlgorithm algorithm = DiffAlgorithm::Myers;
+    bool trimCommon = false;  // Myers 계열에서 앞/뒤 공통 줄을 먼저 잘라냄
+    int threads = 1;          // 1 = 단일 스레드, 0 = 하드웨어 스레드 수, 2 이상 = 병렬
+    TokenMode tokenMode = TokenMode::Word;
+    DiffBudget budget;        // 줄 diff 비용 상한 (diff_budget.hpp, 기본: 제한 없음)
+    int context = -1;         // 0 이상이면 JSON 에서 변경 앞뒤 context 줄만 남기고 같은 줄은 skip 으로 접음
+    uint32_t normalize = 0;   // 줄 비교 정규화 LINE_IGNORE_* 비트 (line_index.hpp), row 에는 원문이 나감
+};
+
+// C API 의 (algorithm, flags) 정수 값을 DiffOptions 로 변환
+inline DiffOptions makeDiffOptions(int algorithm, int flags, int threads = 1,
+                                   const DiffBudget& budget = DiffBudget(), int context = -1) {
+    DiffOptions options;
+    if (algorithm >= 0 && algorithm <= static_cast<int>(DiffAlgorithm::Histogram)) {
+        options.algorithm = static_cast<DiffAlgorithm>(algorithm);
+    }
+    options.trimCommon = (flags & DIFF_FLAG_TRIM_COMMON) != 0;
+    options.tokenMode = (flags & DIFF_FLAG_CHAR_TOKENS) ? TokenMode::Char : TokenMode::Word;
+    if (flags & DIFF_FLAG_IGNORE_CR) options.normalize |= LINE_IGNORE_TRAILING_CR;
+    if (flags & DIFF_FLAG_IGNORE_ALL_SPACE) options.normalize |= LINE_IGNORE_ALL_SPACE;
+    if (flags & DIFF_FLAG_IGNORE_SPACE_CHANGE) options.normalize |= LINE_IGNORE_SPACE_CHANGE;
+    if (flags & DIFF_FLAG_IGNORE_CASE) options.normalize |= LINE_IGNORE_CASE;
+    options.threads = threads;
+    options.budget = budget;
+    options.context = context;
+    return options;
+}
+
+// 기존 myersDiff 의 trace 에서 대각선 하나가 차지하는 바이트 (MyersScratch::trace 의 int 하나)
+constexpr size_t MYERS_TRACE_ENTRY_BYTES = sizeof(int);
+
+// ------------------------------------------------------------
+// 기존 myersDiff 의 작업 버퍼
+//   trace : D 마다 V(k -> x) 를 k = -D, -D + 2, ..., D 순서로 이어 붙인 배열
+//           (D 번째 줄은 D * (D + 1) / 2 에서 시작, 길이 D + 1)
+//   edits : 편집 스크립트
+//   같은 객체를 다시 넘기면 clear() 만 하고 용량을 재사용한다
+// ------------------------------------------------------------
+struct MyersScratch {
+    std::vector<int> trace;
+    std::vector<IndexedEdit> edits;
+};
+
+// trace 의 D 번째 줄에서 대각선 k 의 x (그 줄에 없는 대각선이면 defaultValue)
+inline int myersTraceAt(const std::vector<int>& trace, int d, int k, int defaultValue) {
+    if (k < -d || k > d || ((k + d) & 1)) return defaultValue;
+    return trace[static_cast<size_t>(d) * (d + 1) / 2 + static_cast<size_t>((k + d) / 2)];
+}
+
+// ------------------------------------------------------------
+// Myers 알고리즘: 줄 단위 diff
+//   - a, b 는 줄 ID 배열 (정수 비교)
+//   - budget 이 있으면 D 가 maxCost 를 넘거나 시간 / 메모리(trace)가 바닥날 때
+//     가장 멀리 간 끝점까지만 역추적하고, 나머지는 LinearMyers 에 같은 예산으로 맡긴다
+//   - 결과는 scratch.edits (다음 호출 전까지 유효)
+// ------------------------------------------------------------
+template <typename Seq>
+const std::vector<IndexedEdit>& myersDiff(const Seq& a, int n, const Seq& b, int m, MyersScratch& scratch,
+                                          BudgetState* budget = nullptr) {
+    std::vector<int>& trace = scratch.trace;
+    std::vector<IndexedEdit>& edits = scratch.edits;
+    trace.clear();
+    edits.clear();
+
+    if (n == 0 && m == 0) {
+        return edits;
+    }
+
+    int maxD = n + m;
+    bool finished = false;
+    int finalD = 0;
+    bool stopped = false;   // 예산 때문에 (n, m) 전에 멈춤
+    size_t reserved = 0;    // budget 에 잡아 둔 trace 크기
+
+    for (int d = 0; d <= maxD; ++d) {
+        if (budget && d >= 1) {
+            size_t bytes = static_cast<size_t>(d + 1) * MYERS_TRACE_ENTRY_BYTES;
+            if (budget->maxCost() > 0 && d > budget->maxCost()) {
+                budget->degrade(DIFF_DEGRADED_COST);
+                stopped = true;
+            } else if (budget->exhausted() || !budget->reserve(bytes)) {
+                stopped = true;
+            } else {
+                reserved += bytes;
+            }
+            if (stopped) {
+                finalD = d - 1;
+                break;
+            }
+        }
+
+        size_t rowStart = static_cast<size_t>(d) * (d + 1) / 2;
+        trace.resize(rowStart + static_cast<size_t>(d) + 1);
+        DIFF_STATS_ADD(MyersSteps, d + 1);
+
+        for (int k = -d; k <= d; k += 2) {
+            int xStart;
+
+            if (d == 0) {
+                xStart = 0;
+            } else if (k == -d) {
+                xStart = myersTraceAt(trace, d - 1, k + 1, 0);         // 아래에서(삽입)
+            } else if (k == d) {
+                xStart = myersTraceAt(trace, d - 1, k - 1, 0) + 1;     // 오른쪽에서(삭제)
+            } else {
+                int xFromRight = myersTraceAt(trace, d - 1, k - 1, 0) + 1; // 삭제
+                int xFromDown  = myersTraceAt(trace, d - 1, k + 1, 0);     // 삽입
+                xStart = (xFromRight > xFromDown) ? xFromRight : xFromDown;
+            }
+
+            int yStart = xStart - k;
+            int x = xStart;
+            int y = yStart;
+
+            // "뱀(snake)" : 같은 줄이 연속되는 구간
+            while (x < n && y < m && a[x] == b[y]) {
+                ++x;
+                ++y;
+            }
+
+            trace[rowStart + static_cast<size_t>((k + d) / 2)] = x;
+
+            // 끝점(n, m)에 도달했으면 종료
+            if (x >= n && y >= m) {
+                finished = true;
+                finalD = d;
+                break;
+            }
+        }
+
+        if (finished) break;
+    }
+
+    // ---------- 역추적(backtracking) ----------
+    int x = n;
+    int y = m;
+
+    // 멈췄으면 마지막 D 의 끝점 중 x + y 가 가장 큰 점에서 시작 (같으면 k 가 작은 쪽)
+    if (stopped) {
+        int best = -1;
+        for (int k = -finalD; k <= finalD; k += 2) {
+            int vx = myersTraceAt(trace, finalD, k, 0);
+            int vy = vx - k;
+            if (vx <= n && vy >= 0 && vy <= m && vx + vy > best) {
+                best = vx + vy;
+                x = vx;
+                y = vy;
+            }
+        }
+    }
+    const int stopX = x;
+    const int stopY = y;
+
+    for (int d = finalD; d > 0; --d) {
+        int k = x - y;
+        int vPrevKm1 = myersTraceAt(trace, d - 1, k - 1, -1);
+        int vPrevKp1 = myersTraceAt(trace, d - 1, k + 1, -1);
+
+        int prevK;
+        if (k == -d || (k != d && vPrevKm1 < vPrevKp1)) {
+            // 아래에서 올라옴 (삽입)
+            prevK = k + 1;
+        } else {
+            // 오른쪽에서 옴 (삭제)
+            prevK = k - 1;
+        }
+
+        int xStart = myersTraceAt(trace, d - 1, prevK, 0);
+        int yStart = xStart - prevK;
+
+        // 뱀 구간: 같은 줄들
+        while (x > xStart && y > yStart) {
+            --x;
+            --y;
+            edits.push_back({' ', x, y});
+        }
+
+        // 한 칸짜리 편집(삭제 또는 삽입)
+        if (xStart < x) {
+            --x;
+            edits.push_back({'-', x, -1}); // 삭제
+        } else if (yStart < y) {
+            --y;
+            edits.push_back({'+', -1, y}); // 삽입
+        }
+    }
+
+    // 앞부분에 남은 같은 줄들
+    while (x > 0 && y > 0) {
+        --x;
+        --y;
+        edits.push_back({' ', x, y});
+    }
+
+    std::reverse(edits.begin(), edits.end());
+    if (budget) budget->release(reserved);
+
+    if (stopped) {
+        LinearMyers<Seq> rest(a, n, b, m, budget);
+        edits = rest.runFrom(std::move(edits), stopX, stopY);
+    }
+    return edits;
+}
+
+template <typename Seq>
+std::vector<IndexedEdit> myersDiff(const Seq& a, int n, const Seq& b, int m, BudgetState* budget = nullptr) {
+    MyersScratch scratch;
+    myersDiff(a, n, b, m, scratch, budget);
+    return std::move(scratch.edits);
+}
+
+// ------------------------------------------------------------
+// Patience / Histogram 이 앵커를 못 찾은 구간을 Myers 로 처리하는 fallback
+// ------------------------------------------------------------
+//   myers 가 있으면 기존 Myers 의 trace / 편집 버퍼를 거기서 재사용 (LineDiffScratch::myers)
+struct MyersRangeFallback {
+    const uint32_t* a;
+    const uint32_t* b;
+    DiffAlgorithm algorithm;
+    BudgetState* budget = nullptr;
+    MyersScratch* myers = nullptr;
+
+    void operator()(int aLo, int aHi, int bLo, int bHi, std::vector<LineMatch>& matches) const {
+        if (algorithm == DiffAlgorithm::Myers) {
+            MyersScratch local;
+            MyersScratch& scratch = myers ? *myers : local;
+            appendMatches(aLo, bLo, myersDiff(a + aLo, aHi - aLo, b + bLo, bHi - bLo, scratch, budget), matches);
+        } else {
+            appendMatches(aLo, bLo, myersDiffLinear(a + aLo, aHi - aLo, b + bLo, bHi - bLo, budget), matches);
+        }
+    }
+
+    static void appendMatches(int aLo, int bLo, const std::vector<IndexedEdit>& script,
+                              std::vector<LineMatch>& matches) {
+        for (const IndexedEdit& e : script) {
+            if (e.op == ' ') matches.push_back({aLo + e.aIndex, bLo + e.bIndex});
+        }
+    }
+};
+
+// ------------------------------------------------------------
+// 걸러낸 ID 배열의 한 구간에 선택한 알고리즘을 실행
+//   - Patience / Histogram 엔진(줄 ID 수만큼의 표)은 처음 쓸 때 한 번만 만든다
+// ------------------------------------------------------------
+class RangeDiffer {
+public:
+    RangeDiffer(const FilteredIds& a, const FilteredIds& b, uint32_t idCount, const DiffOptions& options,
+                BudgetState* budget = nullptr, MyersScratch* myers = nullptr)
+        : a_(a), b_(b), idCount_(idCount), options_(options),
+          fallback_{a.ids.data(), b.ids.data(), options.algorithm, budget, myers} {}
+
+    // a[aLo, aHi), b[bLo, bHi) 의 같은 줄 쌍을 matches 뒤에 추가
+    void run(int aLo, int aHi, int bLo, int bHi, std::vector<LineMatch>& matches) {
+        switch (options_.algorithm) {
+            case DiffAlgorithm::Patience:
+                anchored().patienceRange(aLo, aHi, bLo, bHi, matches);
+                break;
+            case DiffAlgorithm::Histogram:
+                anchored().histogramRange(aLo, aHi, bLo, bHi, matches);
+                break;
+            default:
+                if (options_.trimCommon) {
+                    int suffix = trimCommonEnds(a_.ids.data(), b_.ids.data(), aLo, aHi, bLo, bHi, matches);
+                    fallback_(aLo, aHi, bLo, bHi, matches);
+                    appendSuffixMatches(aHi, bHi, suffix, matches);
+                } else {
+                    fallback_(aLo, aHi, bLo, bHi, matches);
+                }
+                break;
+        }
+    }
+
+private:
+    const FilteredIds& a_;
+    const FilteredIds& b_;
+    uint32_t idCount_;
+    DiffOptions options_;
+    MyersRangeFallback fallback_;
+    std::unique_ptr<AnchoredDiff<MyersRangeFallback>> anchored_;
+
+    AnchoredDiff<MyersRangeFallback>& anchored() {
+        if (!anchored_) {
+            anchored_ = std::make_unique<AnchoredDiff<MyersRangeFallback>>(
+                a_.ids.data(), static_cast<int>(a_.ids.size()), b_.ids.data(), static_cast<int>(b_.ids.size()),
+                idCount_, fallback_);
+        }
+        return *anchored_;
+    }
+};
+
+// 병렬 모드를 쓰기 시작하는 (걸러낸) 줄 수. 이보다 작으면 스레드 비용이 더 큼
+constexpr int PARALLEL_MIN_LINES = 8192;
+
+// ------------------------------------------------------------
+// 병렬 줄 단위 diff
+//   1) 양쪽에 한 번씩만 나오는 줄의 앵커 열(patience LIS)로 입력을 독립 구간들로 나누고
+//   2) 구간들을 작업량(줄 수)이 비슷한 묶음으로 모아 작업자 풀에서 처리한 뒤
+//   3) 묶음 순서대로 이어 붙인다 (구간 사이에 앵커 match 를 끼워 넣음)
+//   앵커는 항상 같은 줄 쌍으로 고정되므로 결과는 유효한 diff 이지만,
+//   단일 스레드 Myers 와는 (patience 처럼) 조금 다를 수 있다.
+// ------------------------------------------------------------
+inline std::vector<LineMatch> parallelMatches(const FilteredIds& a, const FilteredIds& b, uint32_t idCount,
+                                              const DiffOptions& options, int threads, BudgetState* budget = nullptr) {
+    int n = static_cast<int>(a.ids.size());
+    int m = static_cast<int>(b.ids.size());
+    std::vector<LineMatch> anchors = findUniqueLineAnchors(a.ids.data(), n, b.ids.data(), m, idCount);
+
+    // 구간 k: 앵커 k-1 바로 뒤 ~ 앵커 k 바로 앞 (마지막 구간은 끝까지)
+    size_t regionCount = anchors.size() + 1;
+    auto regionStart = [&](size_t k) {
+        return k == 0 ? LineMatch{0, 0} : LineMatch{anchors[k - 1].aIndex + 1, anchors[k - 1].bIndex + 1};
+    };
+    auto regionEnd = [&](size_t k) { return k == anchors.size() ? LineMatch{n, m} : anchors[k]; };
+
+    // 묶음 경계: batchBegin[i] ~ batchBegin[i + 1] 번 구간
+    size_t targetWork = static_cast<size_t>(n + m) / (static_cast<size_t>(threads) * 4) + 1;
+    std::vector<size_t> batchBegin{0};
+    size_t work = 0;
+    for (size_t k = 0; k < regionCount; ++k) {
+        LineMatch s = regionStart(k);
+        LineMatch e = regionEnd(k);
+        work += static_cast<size_t>((e.aIndex - s.aIndex) + (e.bIndex - s.bIndex)) + 1;
+        if (work >= targetWork && k + 1 < regionCount) {
+            batchBegin.push_back(k + 1);
+            work = 0;
+        }
+    }
+    batchBegin.push_back(regionCount);
+
+    size_t batchCount = batchBegin.size() - 1;
+    std::vector<std::vector<LineMatch>> results(batchCount);
+    std::shared_ptr<WorkerPool> pool = sharedWorkerPool(threads);
+
+    // 작업자마다 RangeDiffer 하나 (Patience / Histogram 표를 묶음마다 새로 만들지 않도록)
+    std::vector<std::unique_ptr<RangeDiffer>> differs(static_cast<size_t>(pool->size()));
+    pool->parallelFor(batchCount, [&](size_t i, int worker) {
+        std::unique_ptr<RangeDiffer>& differ = differs[static_cast<size_t>(worker)];
+        if (!differ) differ = std::make_unique<RangeDiffer>(a, b, idCount, options, budget);
+        for (size_t k = batchBegin[i]; k < batchBegin[i + 1]; ++k) {
+            LineMatch s = regionStart(k);
+            LineMatch e = regionEnd(k);
+            differ->run(s.aIndex, e.aIndex, s.bIndex, e.bIndex, results[i]);
+            if (k < anchors.size()) results[i].push_back(anchors[k]);
+        }
+    });
+
+    std::vector<LineMatch> matches;
+    size_t total = 0;
+    for (const auto& part : results) total += part.size();
+    matches.reserve(total);
+    for (const auto& part : results) matches.insert(matches.end(), part.begin(), part.end());
+    return matches;
+}
+
+// ------------------------------------------------------------
+// 줄 ID 배열 위에서 줄 단위 diff 실행
+//   1) 상대 파일에 없는 줄은 미리 빼고
+//   2) 남은 ID 배열로 선택한 알고리즘을 실행해 같은 줄 쌍을 구한 뒤
+//      (options.threads 가 1 이 아니고 입력이 충분히 크면 병렬로)
+//   3) 원본 줄 번호 기준 편집 스크립트로 복원
+//
+// LineDiffScratch 를 넘기면 걸러낸 배열 / 같은 줄 쌍 / 편집 스크립트 / 기존 Myers trace 버퍼를 재사용한다
+// (결과는 scratch.edits, 다음 호출 전까지 유효)
+//
+// options.budget 이 있으면 이번 호출 전체에 그 예산을 적용하고, 결과가 최소 diff 가
+// 아닐 수 있는 이유를 scratch.degraded (DIFF_DEGRADED_* 비트) 에 남긴다
+// ------------------------------------------------------------
+struct LineDiffScratch {
+    FilteredIds a;
+    FilteredIds b;
+    std::vector<uint8_t> seen;
+    std::vector<LineMatch> matches;
+    std::vector<LineMatch> expanded;
+    std::vector<IndexedEdit> edits;
+    MyersScratch myers;  // 단일 스레드 기존 Myers 의 trace (병렬 작업자는 각자 잡음)
+    uint32_t degraded = 0;
+};
+
+// scratch.a / scratch.b 에 이미 걸러 둔 ID 배열로 2), 3) 만 실행
+//   (BaseIndex 처럼 걸러내기를 따로 하는 호출자용, aSize / bSize 는 원본 줄 수)
+inline const std::vector<IndexedEdit>& runFilteredLineDiff(uint32_t idCount, int aSize, int bSize,
+                                                           const DiffOptions& options, LineDiffScratch& scratch) {
+    const FilteredIds& a = scratch.a;
+    const FilteredIds& b = scratch.b;
+    int n = static_cast<int>(a.ids.size());
+    int m = static_cast<int>(b.ids.size());
+    int threads = (options.threads == 1) ? 1 : resolveThreadCount(options.threads);
+
+    std::optional<BudgetState> budget;
+    if (options.budget.limited()) budget.emplace(options.budget);
+    BudgetState* state = budget ? &*budget : nullptr;
+
+    std::vector<LineMatch>& matches = scratch.matches;
+    matches.clear();
+    if (threads > 1 && n + m >= PARALLEL_MIN_LINES) {
+        matches = parallelMatches(a, b, idCount, options, threads, state);
+    } else {
+        RangeDiffer differ(a, b, idCount, options, state, &scratch.myers);
+        differ.run(0, n, 0, m, matches);
+    }
+    scratch.degraded = state ? state->degraded() : 0;
+
+    expandFilteredMatches(matches, a, b, aSize, bSize, scratch.expanded, scratch.edits);
+    DIFF_STATS_EDITS(scratch.edits);
+    return scratch.edits;
+}
+
+inline const std::vector<IndexedEdit>& runLineDiff(const InternedLines& lines, const DiffOptions& options,
+                                                   LineDiffScratch& scratch) {
+    filterUnmatchedLines(lines, scratch.a, scratch.b, scratch.seen);
+    return runFilteredLineDiff(lines.idCount, static_cast<int>(lines.aLines.size()),
+                               static_cast<int>(lines.bLines.size()), options, scratch);
+}
+
+inline std::vector<IndexedEdit> runLineDiff(const InternedLines& lines, const DiffOptions& options,
+                                            uint32_t* degraded = nullptr) {
+    LineDiffScratch scratch;
+    runLineDiff(lines, options, scratch);
+    if (degraded) *degraded |= scratch.degraded;
+    return std::move(scratch.edits);
+}
+
+// ------------------------------------------------------------
+// JSON 문자열에서 필요한 문자들을 이스케이프
+//   - "  -> \"
+//   - \  -> \\
+//   - 줄바꿈, 탭 등은 \n, \t 등으로 변환
+//   Out 은 std::string / ArenaString 처럼 append(const char*, size_t) 가 있는 문자열.
+//   이스케이프할 필요가 없는 구간은 한 번에 복사한다.
+// ------------------------------------------------------------
+template <typename Out>
+inline void appendEscapedJson(Out& out, std::string_view s) {
+    size_t runStart = 0;
+    for (size_t i = 0; i < s.size(); ++i) {
+        const char* escaped;
+        switch (s[i]) {
+            case '\"': escaped = "\\\""; break;
+            case '\\': escaped = "\\\\"; break;
+            case '\b': escaped = "\\b"; break;
+            case '\f': escaped = "\\f"; break;
+            case '\n': escaped = "\\n"; break;
+            case '\r': escaped = "\\r"; break;
+            case '\t': escaped = "\\t"; break;
+            default: continue;
+        }
+        out.append(s.data() + runStart, i - runStart);
+        out.append(escaped, 2);
+        runStart = i + 1;
+    }
+    out.append(s.data() + runStart, s.size() - runStart);
+}
+
+inline std::string escapeJson(std::string_view s) {
+    std::string out;
+    out.reserve(s.size());
+    appendEscapedJson(out, s);
+    return out;
+}
+
+// ------------------------------------------------------------
+// 공백(스페이스) 기준으로 "단어"들을 잘라내는 함수
+//   "Second Modified" -> ["Second", "Modified"]
+//   - 각 단어는 원본 줄을 가리키는 string_view
+//   - result 를 비우고 채우는 버전은 토큰 정렬 버퍼를 재사용할 때 사용
+// ------------------------------------------------------------
+inline void splitWordsBySpace(std::string_view line, std::vector<std::string_view>& result) {
+    result.clear();
+    size_t wordStart = 0;
+
+    // 공백 위치는 SIMD 스캐너로 찾고, 연속된 공백 사이의 빈 단어는 건너뜀
+    forEachByte(line, ' ', [&](size_t space) {
+        if (space > wordStart) {
+            result.push_back(line.substr(wordStart, space - wordStart));
+        }
+        wordStart = space + 1;
+    });
+
+    if (line.size() > wordStart) {
+        result.push_back(line.substr(wordStart));
+    }
+}
+
+inline std::vector<std::string_view> splitWordsBySpace(std::string_view line) {
+    std::vector<std::string_view> result;
+    splitWordsBySpace(line, result);
+    return result;
+}
+
+// ------------------------------------------------------------
+// UTF-8 글자 단위로 자르는 함수
+//   - 코드 포인트 하나에 뒤따르는 결합 문자 / 이체 선택자 / 피부색 / 한글 중성·종성 자모,
+//     ZWJ 로 이어진 다음 코드 포인트, 국기(지역 표시 문자 두 개)를 한 글자로 묶음
+//     (화면에서 한 글자로 보이는 grapheme cluster 의 근사)
+//   - 잘못된 바이트는 1바이트짜리 글자로 취급
+// ------------------------------------------------------------
+constexpr uint32_t UTF8_ZWJ = 0x200D;
+
+// pos 의 코드 포인트 (length 에 바이트 수)
+//   이어지는 바이트가 모자라거나 10xxxxxx 가 아니면 잘못된 바이트로 보고 그 바이트 값과 1
+inline uint32_t decodeUtf8At(std::string_view line, size_t pos, size_t& length) {
+    unsigned char lead = static_cast<unsigned char>(line[pos]);
+    uint32_t cp = lead;
+    length = 1;
+    if ((lead >> 5) == 0x6) {
+        length = 2;
+        cp = lead & 0x1F;
+    } else if ((lead >> 4) == 0xE) {
+        length = 3;
+        cp = lead & 0x0F;
+    } else if ((lead >> 3) == 0x1E) {
+        length = 4;
+        cp = lead & 0x07;
+    }
+    if (length == 1 || pos + length > line.size()) {
+        length = 1;
+        return lead;
+    }
+    for (size_t k = 1; k < length; ++k) {
+        unsigned char next = static_cast<unsigned char>(line[pos + k]);
+        if ((next & 0xC0) != 0x80) {
+            length = 1;
+            return lead;
+        }
+        cp = (cp << 6) | (next & 0x3F);
+    }
+    return cp;
+}
+
+// 앞 글자에 붙어 한 글자로 보이는 코드 포인트
+inline bool isClusterExtender(uint32_t cp) {
+    return (cp >= 0x0300 && cp <= 0x036F) || (cp >= 0x1AB0 && cp <= 0x1AFF) || (cp >= 0x1DC0 && cp <= 0x1DFF) ||
+           (cp >= 0x20D0 && cp <= 0x20FF) || (cp >= 0xFE00 && cp <= 0xFE0F) || (cp >= 0xFE20 && cp <= 0xFE2F) ||
+           (cp >= 0x1160 && cp <= 0x11FF) || (cp >= 0xD7B0 && cp <= 0xD7FF) || (cp >= 0x1F3FB && cp <= 0x1F3FF) ||
+           (cp >= 0xE0100 && cp <= 0xE01EF) || cp == UTF8_ZWJ;
+}
+
+inline bool isRegionalIndicator(uint32_t cp) { return cp >= 0x1F1E6 && cp <= 0x1F1FF; }
+
+// pos 에서 시작하는 글자의 끝 위치
+inline size_t utf8ClusterEnd(std::string_view line, size_t pos) {
+    size_t length;
+    uint32_t cp = decodeUtf8At(line, pos, length);
+    size_t end = pos + length;
+    bool joinNext = cp == UTF8_ZWJ;
+    bool flagOpen = isRegionalIndicator(cp);
+    while (end < line.size()) {
+        uint32_t next = decodeUtf8At(line, end, length);
+        bool pairsFlag = flagOpen && isRegionalIndicator(next);
+        if (!joinNext && !pairsFlag && !isClusterExtender(next)) break;
+        joinNext = next == UTF8_ZWJ;
+        flagOpen = false;
+        end += length;
+    }
+    return end;
+}
+
+// pos 바로 앞 코드 포인트 (pos > 0)
+inline uint32_t decodeUtf8Before(std::string_view line, size_t pos) {
+    size_t start = pos - 1;
+    while (start > 0 && pos - start < 4 && (static_cast<unsigned char>(line[start]) & 0xC0) == 0x80) --start;
+    size_t length;
+    uint32_t cp = decodeUtf8At(line, start, length);
+    return start + length == pos ? cp : static_cast<unsigned char>(line[pos - 1]);
+}
+
+// pos 가 글자 경계인지 (앞에서부터 다시 자르지 않고 주변 바이트만 봄)
+//   - 올바른 UTF-8 이면 splitUtf8Chars 로 자른 경계와 같은 답
+//   - 잘못된 UTF-8 의 외톨이 이어지는 바이트(10xxxxxx)는 경계여도 아니라고 답하므로,
+//     호출자는 경계를 찾을 때까지 한 바이트씩 옮기며 확인한다
+inline bool isUtf8ClusterStart(std::string_view line, size_t pos) {
+    if (pos == 0 || pos >= line.size()) return true;
+    if ((static_cast<unsigned char>(line[pos]) & 0xC0) == 0x80) return false;
+    size_t length;
+    uint32_t cp = decodeUtf8At(line, pos, length);
+    uint32_t before = decodeUtf8Before(line, pos);
+    if (isClusterExtender(cp) || before == UTF8_ZWJ) return false;
+    if (!isRegionalIndicator(cp) || !isRegionalIndicator(before)) return true;
+
+    // 지역 표시 문자가 이어지면 첫 문자부터 둘씩 짝을 지으므로 짝수 개 뒤인지 확인
+    //   (첫 문자가 ZWJ 뒤에 붙으면 그다음 문자부터 짝을 지음)
+    size_t runStart = pos - 4;
+    while (runStart > 0 && isRegionalIndicator(decodeUtf8Before(line, runStart))) runStart -= 4;
+    if (runStart > 0 && decodeUtf8Before(line, runStart) == UTF8_ZWJ) runStart += 4;
+    return (pos - runStart) / 4 % 2 == 0;
+}
+
+inline void splitUtf8Chars(std::string_view line, std::vector<std::string_view>& result) {
+    result.clear();
+    result.reserve(line.size());
+
+    size_t i = 0;
+    while (i < line.size()) {
+        size_t end = utf8ClusterEnd(line, i);
+        result.push_back(line.substr(i, end - i));
+        i = end;
+    }
+}
+
+inline std::vector<std::string_view> splitUtf8Chars(std::string_view line) {
+    std::vector<std::string_view> result;
+    splitUtf8Chars(line, result);
+    return result;
+}
+
+// 단어 단위 정렬 정보를 담는 구조체
+struct AlignedToken {
+    std::string_view left;   // 기준 텍스트쪽 단어 (없으면 "")
+    std::string_view right;  // 변경 텍스트쪽 단어 (없으면 "")
+    char op;            // 'M' = match(equal), 'D' = delete(left만), 'I' = insert(right만)
+};
+
+// string_view 두 개가 메모리상 바로 이어지면 하나로 합침
+inline bool extendAdjacent(std::string_view& run, std::string_view next) {
+    if (run.empty()) {
+        run = next;
+        return true;
+    }
+    if (next.empty()) return true;
+    if (run.data() + run.size() != next.data()) return false;
+    run = std::string_view(run.data(), run.size() + next.size());
+    return true;
+}
+
+// ------------------------------------------------------------
+// 한 줄(oldLine, newLine)에 대해 단어 / 글자 단위 diff 를 계산
+//   - 단어 / 글자 토큰(string_view)을 시퀀스 diff 엔진(sequence_diff.hpp)으로 정렬
+//     (작으면 비트 병렬 LCS, 토큰 수의 곱이 LCS_MAX_CELLS 를 넘으면 선형 공간 Myers)
+//   - 결과 토큰은 원본 줄을 가리키는 string_view
+//   - 글자 단위에서는 같은 종류(M / D / I)가 이어지는 글자들을 한 토큰으로 합침
+//
+// 글자 단위는 띄어쓰기 없는 긴 줄에서도 빠르도록
+//   1) 양쪽이 같은 앞 / 뒤를 SIMD 로 바이트 비교해 잘라내고 (글자 경계까지 물림)
+//   2) 남은 가운데만 글자로 잘라 정렬한다
+//
+// 토큰 목록과 정렬 엔진(ID 배열, 해시 테이블, LCS 행 버퍼)을 멤버로 들고 있어서
+// 같은 객체로 여러 줄을 정렬하면 버퍼를 다시 잡지 않는다. align() 의 결과는
+// 다음 align() 호출 전까지만 유효하다.
+// ------------------------------------------------------------
+class TokenAligner {
+public:
+    const std::vector<AlignedToken>& align(std::string_view oldLine, std::string_view newLine, TokenMode mode) {
+        DIFF_STATS_SCOPE(TokenDiff);
+        tokens_.clear();
+        if (mode == TokenMode::Char) {
+            alignChars(oldLine, newLine);
+        } else {
+            splitWordsBySpace(oldLine, a_);
+            splitWordsBySpace(newLine, b_);
+            alignSplit(false);
+        }
+        DIFF_STATS_ADD(TokenRows, 1);
+        DIFF_STATS_ADD(TokenCount, tokens_.size());
+        return tokens_;
+    }
+
+private:
+    std::vector<std::string_view> a_;
+    std::vector<std::string_view> b_;
+    SequenceDiffer<std::string_view> differ_;
+    std::vector<char> ops_;
+    std::vector<AlignedToken> tokens_;
+
+    void alignChars(std::string_view oldLine, std::string_view newLine) {
+        size_t prefix = commonPrefixLength(oldLine, newLine);
+        while (prefix > 0 && !(isUtf8ClusterStart(oldLine, prefix) && isUtf8ClusterStart(newLine, prefix))) --prefix;
+
+        // 뒤쪽 같은 바이트는 앞에서 잘라낸 부분과 겹치지 않게
+        size_t suffix = commonSuffixLength(oldLine, newLine, std::min(oldLine.size(), newLine.size()) - prefix);
+        while (suffix > 0 && !(isUtf8ClusterStart(oldLine, oldLine.size() - suffix) &&
+                               isUtf8ClusterStart(newLine, newLine.size() - suffix))) {
+            --suffix;
+        }
+
+        std::string_view oldMiddle = oldLine.substr(prefix, oldLine.size() - prefix - suffix);
+        std::string_view newMiddle = newLine.substr(prefix, newLine.size() - prefix - suffix);
+        pushMerged({oldLine.substr(0, prefix), newLine.substr(0, prefix), 'M'});
+
+        splitUtf8Chars(oldMiddle, a_);
+        splitUtf8Chars(newMiddle, b_);
+        alignSplit(true);
+
+        pushMerged({oldLine.substr(oldLine.size() - suffix), newLine.substr(newLine.size() - suffix), 'M'});
+    }
+
+    // a_ / b_ 토큰을 정렬해 tokens_ 뒤에 붙임 (merge 면 같은 op 의 이어진 토큰을 합침)
+    void alignSplit(bool merge) {
+        differ_.align(a_, b_, ops_);
+
+        tokens_.reserve(tokens_.size() + ops_.size());
+        size_t i = 0;
+        size_t j = 0;
+        for (char op : ops_) {
+            AlignedToken token{op != 'I' ? a_[i] : std::string_view(), op != 'D' ? b_[j] : std::string_view(), op};
+            if (op != 'I') ++i;
+            if (op != 'D') ++j;
+            if (merge) {
+                pushMerged(token);
+            } else {
+                tokens_.push_back(token);
+            }
+        }
+    }
+
+    // 빈 토큰은 버리고, 앞 토큰과 op 가 같고 양쪽이 이어져 있으면 합침
+    void pushMerged(const AlignedToken& token) {
+        if (token.left.empty() && token.right.empty()) return;
+        if (!tokens_.empty() && tokens_.back().op == token.op) {
+            AlignedToken& last = tokens_.back();
+            std::string_view left = last.left;
+            std::string_view right = last.right;
+            if (extendAdjacent(left, token.left) && extendAdjacent(right, token.right)) {
+                last.left = left;
+                last.right = right;
+                return;
+            }
+        }
+        tokens_.push_back(token);
+    }
+};
+
+// 줄마다 버퍼를 새로 잡지 않도록 스레드별로 하나씩 둔 정렬기
+inline TokenAligner& threadTokenAligner() {
+    thread_local TokenAligner aligner;
+    return aligner;
+}
+
+inline std::vector<AlignedToken> alignTokens(std::string_view oldLine, std::string_view newLine, TokenMode mode) {
+    return threadTokenAligner().align(oldLine, newLine, mode);
+}
+
+// 띄어쓰기 기준 단어 단위 정렬
+inline std::vector<AlignedToken> alignWords(std::string_view oldLine, std::string_view newLine) {
+    return alignTokens(oldLine, newLine, TokenMode::Word);
+}
+
+// ------------------------------------------------------------
+// 한 줄(oldLine, newLine)에 대해 "단어 단위 diff" 를 계산해서
+// JSON 배열 형태의 문자열을 만드는 함수
+//
+// 예)
+//   oldLine = "Second"
+//   newLine = "Second Modified"
+// -> tokens:
+//   [
+//     {"op":"equal",  "left":"Second", "right":"Second"},
+//     {"op":"insert", "left":"",       "right":"Modified"}
+//   ]
+//   - appendTokensJson 은 out 뒤에 바로 붙임 (중간 문자열을 만들지 않음)
+// ------------------------------------------------------------
+template <typename Out>
+inline void appendTokensJson(Out& out, std::string_view oldLine, std::string_view newLine,
+                             TokenMode mode = TokenMode::Word) {
+    const std::vector<AlignedToken>& tokens = threadTokenAligner().align(oldLine, newLine, mode);
+
+    // JSON 배열 만들기
+    out += '[';
+    bool first = true;
+    for (const auto& t : tokens) {
+        if (!first) out += ',';
+        first = false;
+
+        const char* opStr;
+        if (t.op == 'M') opStr = "equal";
+        else if (t.op == 'D') opStr = "delete";
+        else opStr = "insert";
+
+        out += "{\"op\":\"";
+        out += opStr;
+        out += "\",\"left\":\"";
+        appendEscapedJson(out, t.left);
+        out += "\",\"right\":\"";
+        appendEscapedJson(out, t.right);
+        out += "\"}";
+    }
+    out += ']';
+}
+
+inline std::string makeWordTokensJSON(std::string_view oldLine, std::string_view newLine,
+                                      TokenMode mode = TokenMode::Word) {
+    std::string json;
+    appendTokensJson(json, oldLine, newLine, mode);
+    return json;
+}
+
+// ------------------------------------------------------------
+// 결과 한 줄(row)
+//   leftIndex  : 기준 텍스트 줄 번호 (insert 인 경우 -1)
+//   rightIndex : 변경 텍스트 줄 번호 (delete 인 경우 -1)
+// ------------------------------------------------------------
+enum class RowOp : uint8_t {
+    Equal = 0,
+    Delete = 1,
+    Insert = 2,
+    Replace = 3,
+};
+
+struct DiffRow {
+    RowOp op;
+    int leftIndex;
+    int rightIndex;
+};
+
+inline const char* rowOpName(RowOp op) {
+    switch (op) {
+        case RowOp::Equal: return "equal";
+        case RowOp::Delete: return "delete";
+        case RowOp::Insert: return "insert";
+        default: return "replace";
+    }
+}
+
+// ------------------------------------------------------------
+// 편집 스크립트 -> 결과 row 목록
+//   - 연속된 delete 블록 뒤에 같은 개수의 insert 블록이 오면 1:1 로 묶어 replace
+//   - 개수가 다르면 delete 블록, insert 블록을 그대로 출력
+//   - Rows 는 std::vector<DiffRow> 또는 ArenaVector<DiffRow> (비우고 채움)
+// ------------------------------------------------------------
+template <typename Rows>
+inline void buildRows(const std::vector<IndexedEdit>& edits, Rows& rows) {
+    rows.clear();
+    rows.reserve(edits.size());
+
+    size_t i = 0;
+    while (i < edits.size()) {
+        const IndexedEdit& e = edits[i];
+
+        if (e.op == ' ') {
+            // 공통 줄
+            rows.push_back({RowOp::Equal, e.aIndex, e.bIndex});
+            ++i;
+        } else if (e.op == '-') {
+            // 연속된 delete 블록과 insert 블록의 개수를 세기
+            size_t deleteStart = i;
+            while (i < edits.size() && edits[i].op == '-') ++i;
+            size_t deleteCount = i - deleteStart;
+
+            size_t insertStart = i;
+            while (i < edits.size() && edits[i].op == '+') ++i;
+            size_t insertCount = i - insertStart;
+
+            // delete와 insert 개수가 같으면 1:1 매칭하여 replace로 처리
+            if (deleteCount == insertCount) {
+                for (size_t j = 0; j < deleteCount; ++j) {
+                    rows.push_back({RowOp::Replace, edits[deleteStart + j].aIndex,
+                                    edits[insertStart + j].bIndex});
+                }
+            } else {
+                for (size_t j = 0; j < deleteCount; ++j) {
+                    rows.push_back({RowOp::Delete, edits[deleteStart + j].aIndex, -1});
+                }
+                for (size_t j = 0; j < insertCount; ++j) {
+                    rows.push_back({RowOp::Insert, -1, edits[insertStart + j].bIndex});
+                }
+            }
+        } else {
+            // 추가된 줄 (단독으로 나타난 경우, 앞의 delete 블록에서 처리 안 된 경우)
+            rows.push_back({RowOp::Insert, -1, e.bIndex});
+            ++i;
+        }
+    }
+}
+
+inline std::vector<DiffRow> buildRows(const std::vector<IndexedEdit>& edits) {
+    std::vector<DiffRow> rows;
+    buildRows(edits, rows);
+    return rows;
+}
+
+// ------------------------------------------------------------
+// row 하나의 JSON 객체 앞부분: `    {"op":"...","left":"...","right":"..."`
+//   - 쉼표 / "tokens" / 닫는 '}' 는 호출자가 붙인다
+// ------------------------------------------------------------
+template <typename Out>
+inline void appendRowJsonFields(Out& out, RowOp op, std::string_view leftText, std::string_view rightText) {
+    out += "    {";
+    out += "\"op\":\"";
+    out += rowOpName(op);
+    out += "\",";
+    out += "\"left\":\"";
+    appendEscapedJson(out, leftText);
+    out += "\",\"right\":\"";
+    appendEscapedJson(out, rightText);
+    out += '"';
+}
+
+// ------------------------------------------------------------
+// row 하나를 JSON 객체로 out 뒤에 추가 (firstRow 가 아니면 앞에 쉼표)
+//   - row 마다 임시 문자열을 만들지 않고 out 에 바로 이스케이프해 넣는다
+// ------------------------------------------------------------
+template <typename Out>
+inline void appendRowJson(Out& out, const DiffRow& row, const std::vector<std::string_view>& baseLines,
+                          const std::vector<std::string_view>& changedLines, bool& firstRow, TokenMode tokenMode) {
+    std::string_view leftText  = (row.leftIndex >= 0) ? baseLines[row.leftIndex] : std::string_view();
+    std::string_view rightText = (row.rightIndex >= 0) ? changedLines[row.rightIndex] : std::string_view();
+
+    if (!firstRow) {
+        out += ",\n";
+    }
+    firstRow = false;
+
+    // 한 줄(row)을 JSON 객체로 추가
+    appendRowJsonFields(out, row.op, leftText, rightText);
+
+    // replace 인 경우에만 단어 단위 토큰 정보 추가 (띄어쓰기 기준 단어 단위 diff)
+    if (row.op == RowOp::Replace) {
+        out += ",\"tokens\":";
+        appendTokensJson(out, leftText, rightText, tokenMode);
+    }
+
+    out += '}';
+}
+
+// ------------------------------------------------------------
+// row 목록을 JSON 객체들로 out 뒤에 추가 ("rows" 배열의 원소 부분)
+//   - firstRow 는 쉼표 처리를 위해 여러 번 나눠 호출할 때 이어서 사용
+// ------------------------------------------------------------
+template <typename Out, typename Rows>
+inline void appendRowsJson(Out& out, const Rows& rows, const std::vector<std::string_view>& baseLines,
+                           const std::vector<std::string_view>& changedLines, bool& firstRow,
+                           TokenMode tokenMode = TokenMode::Word) {
+    for (const DiffRow& row : rows) {
+        appendRowJson(out, row, baseLines, changedLines, firstRow, tokenMode);
+    }
+}
+
+// ------------------------------------------------------------
+// 같은 줄 묶음을 접은 row 목록 (context >= 0)
+//   - 변경 row 앞뒤로 context 개의 equal row 만 남기고 나머지는
+//     {"op":"skip","count":N,"left_line":L,"right_line":R} 하나로 바꾼다
+//     (L, R: 접힌 첫 줄의 기준 / 변경 줄 번호, 양쪽 내용이 같으므로 텍스트는 넣지 않음)
+//   - 파일 맨 앞 / 맨 뒤의 같은 줄 묶음은 변경 쪽 문맥만 남긴다
+//   - 묶음 전체를 나눠 봐야 하므로 rows 는 한 번에 넘긴다
+// ------------------------------------------------------------
+template <typename Out>
+inline void appendSkipRowJson(Out& out, size_t count, int leftLine, int rightLine, bool& firstRow) {
+    if (!firstRow) {
+        out += ",\n";
+    }
+    firstRow = false;
+    out += "    {\"op\":\"skip\",\"count\":";
+    out += std::to_string(count);
+    out += ",\"left_line\":";
+    out += std::to_string(leftLine);
+    out += ",\"right_line\":";
+    out += std::to_string(rightLine);
+    out += '}';
+}
+
+template <typename Out, typename Rows>
+inline void appendFoldedRowsJson(Out& out, const Rows& rows, const std::vector<std::string_view>& baseLines,
+                                 const std::vector<std::string_view>& changedLines, int context,
+                                 TokenMode tokenMode = TokenMode::Word) {
+    const size_t n = rows.size();
+    const size_t keep = static_cast<size_t>(context);
+    bool firstRow = true;
+    auto emit = [&](size_t from, size_t to) {
+        for (size_t k = from; k < to; ++k) appendRowJson(out, rows[k], baseLines, changedLines, firstRow, tokenMode);
+    };
+
+    size_t i = 0;
+    while (i < n) {
+        if (rows[i].op != RowOp::Equal) {
+            emit(i, i + 1);
+            ++i;
+            continue;
+        }
+
+        size_t runStart = i;
+        while (i < n && rows[i].op == RowOp::Equal) ++i;
+        size_t head = (runStart == 0) ? 0 : keep;  // 앞 변경 뒤의 문맥
+        size_t tail = (i == n) ? 0 : keep;         // 다음 변경 앞의 문맥
+
+        if (head + tail >= i - runStart) {
+            emit(runStart, i);
+            continue;
+        }
+        emit(runStart, runStart + head);
+        const DiffRow& folded = rows[runStart + head];
+        appendSkipRowJson(out, i - runStart - head - tail, folded.leftIndex, folded.rightIndex, firstRow);
+        emit(i - tail, i);
+    }
+}
+
+// options.context 에 따라 전체 row 또는 접은 row 를 추가 (diff_text 계열 JSON 의 본문)
+template <typename Out, typename Rows>
+inline void appendResultRowsJson(Out& out, const Rows& rows, const std::vector<std::string_view>& baseLines,
+                                 const std::vector<std::string_view>& changedLines, const DiffOptions& options) {
+    if (options.context >= 0) {
+        appendFoldedRowsJson(out, rows, baseLines, changedLines, options.context, options.tokenMode);
+        return;
+    }
+    bool firstRow = true;
+    appendRowsJson(out, rows, baseLines, changedLines, firstRow, options.tokenMode);
+}
+
+// ------------------------------------------------------------
+// {"rows": [ ... 뒤를 닫는다
+//   예산 때문에 최소 diff 가 아닐 수 있으면 그 이유를 "degraded": ["cost", "time"]
+//   처럼 덧붙인다 (degraded 가 0 이면 기존과 같은 출력)
+// ------------------------------------------------------------
+template <typename Out>
+inline void appendRowsJsonEnd(Out& out, uint32_t degraded) {
+    out += "\n  ]";
+    if (degraded) {
+        out += ",\n  \"degraded\": [";
+        bool first = true;
+        for (uint32_t reason : {DIFF_DEGRADED_COST, DIFF_DEGRADED_MEMORY, DIFF_DEGRADED_TIME}) {
+            if (!(degraded & reason)) continue;
+            if (!first) out += ", ";
+            first = false;
+            out += '"';
+            out += degradedReasonName(reason);
+            out += '"';
+        }
+        out += ']';
+    }
+    out += "\n}";
+}
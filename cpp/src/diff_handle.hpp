@@ -0,0 +1,100 @@
+// ------------------------------------------------------------
+// 재진입 가능한 diff 핸들
+// ------------------------------------------------------------
+// diff_text() 는 결과를 함수 안의 버퍼에 두기 때문에 두 스레드가 동시에 부르면
+// 서로의 결과를 덮어쓴다. DiffHandle 은 결과와 작업 버퍼를 모두 핸들 안에 두므로
+// 서로 다른 핸들은 여러 스레드에서 동시에 실행해도 된다.
+// (핸들 하나를 여러 스레드가 동시에 쓰는 것은 안 됨)
+//
+// 실행마다 필요한 메모리는 두 종류로 나눠 재사용한다.
+//   - row 목록, 결과 JSON : 핸들의 BumpArena 에서 잘라 쓰고 run() 시작 시 reset
+//   - 줄 / ID / 편집 스크립트 배열, 줄 해시 테이블, 기존 Myers 의 trace : 핸들이 들고 있는
+//     vector 를 clear() 해서 용량을 재사용
+// 그래서 비슷한 크기의 입력을 반복해서 넣으면 두 번째 실행부터는 이 버퍼들을
+// 새로 할당하지 않는다. (선형 Myers / Patience / Histogram 의 작업 배열, 병렬 모드의
+// 작업자별 버퍼는 실행마다 새로 잡음)
+//
+//   DiffHandle handle(options);
+//   handle.run(baseText, changedText);
+//   handle.result() / handle.resultSize()   // 다음 run() 전까지 유효
+//   handle.degraded()                        // 예산 때문에 최소 diff 가 아니면 DIFF_DEGRADED_* 비트
+// ------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "bump_arena.hpp"
+#include "diff_core.hpp"
+#include "diff_stats.hpp"
+#include "line_index.hpp"
+
+class DiffHandle {
+public:
+    explicit DiffHandle(const DiffOptions& options = DiffOptions()) : options_(options) {}
+
+    DiffHandle(const DiffHandle&) = delete;
+    DiffHandle& operator=(const DiffHandle&) = delete;
+
+    const DiffOptions& options() const { return options_; }
+    void setOptions(const DiffOptions& options) { options_ = options; }
+
+    // diff_text 와 같은 형식의 JSON 을 만들고 그 길이(바이트, '\0' 제외)를 반환
+    size_t run(std::string_view baseText, std::string_view changedText) {
+        // 이전 결과를 먼저 없앤 뒤 arena 를 되돌림
+        json_.reset();
+        rows_.reset();
+        arena_.reset();
+
+        DIFF_STATS_CALL();
+
+        // 1) 줄로 나누고(복사 없음) 줄 ID 부여
+        splitLineViews(baseText, lines_.aLines);
+        splitLineViews(changedText, lines_.bLines);
+        assignLineIds(lines_, interner_, options_.normalize);
+        DIFF_STATS_MARK(Split);
+
+        // 2) 줄 단위 diff 후 row 로 묶기
+        const std::vector<IndexedEdit>& edits = runLineDiff(lines_, options_, scratch_);
+        DIFF_STATS_MARK(LineDiff);
+        rows_.emplace(ArenaAllocator<DiffRow>(arena_));
+        buildRows(edits, *rows_);
+        DIFF_STATS_MARK(BuildRows);
+
+        // 3) JSON: 입력 크기 + row 당 고정 부분만큼 미리 잡아 두면 대부분 한 번에 끝남
+        json_.emplace(ArenaAllocator<char>(arena_));
+        json_->reserve(baseText.size() + changedText.size() + rows_->size() * 48 + 32);
+        *json_ += "{\n  \"rows\": [\n";
+
+        appendResultRowsJson(*json_, *rows_, lines_.aLines, lines_.bLines, options_);
+
+        appendRowsJsonEnd(*json_, scratch_.degraded);
+        DIFF_STATS_MARK(Serialize);
+        return json_->size();
+    }
+
+    // 마지막 run() 의 결과 ('\0' 으로 끝남, run() 전이면 빈 문자열)
+    const char* result() const { return json_ ? json_->c_str() : ""; }
+    size_t resultSize() const { return json_ ? json_->size() : 0; }
+
+    // 마지막 run() 이 options().budget 때문에 탐색을 줄였으면 DIFF_DEGRADED_* 비트
+    uint32_t degraded() const { return json_ ? scratch_.degraded : 0; }
+
+    size_t arenaCapacity() const { return arena_.capacity(); }
+
+private:
+    DiffOptions options_;
+
+    // 실행 사이에 용량을 유지하는 작업 버퍼
+    InternedLines lines_;
+    LineInterner interner_;
+    LineDiffScratch scratch_;
+
+    // 실행 한 번 동안만 쓰는 결과 (arena 위)
+    BumpArena arena_;
+    std::optional<ArenaVector<DiffRow>> rows_;
+    std::optional<ArenaString> json_;
+};
@@ -0,0 +1,218 @@
+// ------------------------------------------------------------
+// 단계별 측정 카운터
+// ------------------------------------------------------------
+// diff_text 한 번의 시간이 어느 단계(줄 분할, 줄 diff, row 묶기, 토큰 diff,
+// 직렬화)에서 쓰였는지와 편집 거리, snake, 할당 횟수 등을 기록한다.
+//
+// DIFF_STATS 를 정의하고 빌드할 때만 동작한다. 정의하지 않으면 아래 매크로가
+// 모두 빈 문장이 되어 측정 코드가 하나도 남지 않는다 (diff_get_stats 는 항상
+// 있고, 이때는 enabled = 0 인 빈 값을 돌려준다).
+//
+//   DIFF_STATS_CALL()        : 진입점 맨 앞. 카운터를 비우고 전체 시간 측정 시작
+//   DIFF_STATS_MARK(Phase)   : 직전 MARK(또는 CALL) 이후 시간을 Phase 에 더함
+//   DIFF_STATS_SCOPE(Phase)  : 현재 블록이 끝날 때까지의 시간을 Phase 에 더함
+//   DIFF_STATS_ADD(Counter, n)
+// ------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "edit_script.hpp"
+
+#ifdef DIFF_STATS
+#include <atomic>
+#include <chrono>
+#endif
+
+// ------------------------------------------------------------
+// extern "C" 로 내보내는 결과 구조체
+//   JS 에서 Float64Array 로 바로 읽을 수 있도록 모든 필드를 double 로 둔다
+//   (필드 순서를 바꾸면 wasm-optimized.ts 의 DIFF_STATS_FIELDS 도 같이 바꿀 것)
+// ------------------------------------------------------------
+struct DiffStats {
+    double enabled;        // 1 = 측정 빌드 (DIFF_STATS), 0 = 측정 코드 없음
+    double totalMs;        // 진입점 전체
+    double splitMs;        // 줄 분할 + 줄 ID 부여
+    double lineDiffMs;     // 줄 단위 diff + 편집 스크립트 복원
+    double buildRowsMs;    // 편집 스크립트 -> row
+    double tokenDiffMs;    // replace 줄의 토큰 diff
+    double serializeMs;    // JSON / 바이너리 작성 (토큰 diff 시간 제외)
+    double editDistance;   // D (삭제 + 추가 줄 수)
+    double snakeCount;     // 결과 경로의 같은 줄 구간(snake) 수
+    double snakeLines;     // snake 에 속한 줄 수
+    double longestSnake;   // 가장 긴 snake 길이
+    double myersSteps;     // Myers 계열이 탐색한 (d, k) 지점 수
+    double tokenRows;      // 토큰 diff 를 한 row 수
+    double tokenCount;     // 만들어진 토큰 수
+    double allocCount;     // operator new 호출 수
+    double allocBytes;     // operator new 로 요청한 바이트 수
+};
+
+enum class DiffPhase {
+    Split,
+    LineDiff,
+    BuildRows,
+    TokenDiff,
+    Serialize,
+    Count,
+};
+
+enum class DiffCounter {
+    EditDistance,
+    SnakeCount,
+    SnakeLines,
+    LongestSnake,
+    MyersSteps,
+    TokenRows,
+    TokenCount,
+    AllocCount,
+    AllocBytes,
+    Count,
+};
+
+#ifdef DIFF_STATS
+
+// ------------------------------------------------------------
+// 기록 저장소 (병렬 diff 의 작업자 스레드에서도 더하므로 atomic)
+// ------------------------------------------------------------
+struct DiffStatsRecorder {
+    using Clock = std::chrono::steady_clock;
+
+    std::atomic<uint64_t> phaseNs[static_cast<size_t>(DiffPhase::Count)] = {};
+    std::atomic<uint64_t> counters[static_cast<size_t>(DiffCounter::Count)] = {};
+    std::atomic<uint64_t> totalNs{0};
+
+    void reset() {
+        for (auto& ns : phaseNs) ns.store(0, std::memory_order_relaxed);
+        for (auto& value : counters) value.store(0, std::memory_order_relaxed);
+        totalNs.store(0, std::memory_order_relaxed);
+    }
+};
+
+inline DiffStatsRecorder& diffStatsRecorder() {
+    static DiffStatsRecorder recorder;
+    return recorder;
+}
+
+inline void diffStatsAdd(DiffCounter counter, uint64_t value) {
+    diffStatsRecorder().counters[static_cast<size_t>(counter)].fetch_add(value, std::memory_order_relaxed);
+}
+
+inline void diffStatsMax(DiffCounter counter, uint64_t value) {
+    std::atomic<uint64_t>& slot = diffStatsRecorder().counters[static_cast<size_t>(counter)];
+    uint64_t current = slot.load(std::memory_order_relaxed);
+    while (value > current && !slot.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+inline uint64_t diffStatsElapsedNs(DiffStatsRecorder::Clock::time_point since) {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(DiffStatsRecorder::Clock::now() - since).count());
+}
+
+// 진입점 한 번: 생성 시 초기화, 소멸 시 전체 시간 기록. mark() 로 단계 구분
+class DiffStatsCall {
+public:
+    DiffStatsCall() : start_(DiffStatsRecorder::Clock::now()), last_(start_) { diffStatsRecorder().reset(); }
+    ~DiffStatsCall() { diffStatsRecorder().totalNs.store(diffStatsElapsedNs(start_), std::memory_order_relaxed); }
+
+    void mark(DiffPhase phase) {
+        auto now = DiffStatsRecorder::Clock::now();
+        uint64_t ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - last_).count());
+        diffStatsRecorder().phaseNs[static_cast<size_t>(phase)].fetch_add(ns, std::memory_order_relaxed);
+        last_ = now;
+    }
+
+private:
+    DiffStatsRecorder::Clock::time_point start_;
+    DiffStatsRecorder::Clock::time_point last_;
+};
+
+class DiffStatsScope {
+public:
+    explicit DiffStatsScope(DiffPhase phase) : phase_(phase), start_(DiffStatsRecorder::Clock::now()) {}
+    ~DiffStatsScope() {
+        diffStatsRecorder().phaseNs[static_cast<size_t>(phase_)].fetch_add(diffStatsElapsedNs(start_),
+                                                                            std::memory_order_relaxed);
+    }
+
+private:
+    DiffPhase phase_;
+    DiffStatsRecorder::Clock::time_point start_;
+};
+
+// 최종 편집 스크립트에서 D 와 snake(같은 줄이 이어지는 구간) 통계
+inline void diffStatsRecordEdits(const std::vector<IndexedEdit>& edits) {
+    uint64_t distance = 0;
+    uint64_t snakes = 0;
+    uint64_t snakeLines = 0;
+    uint64_t longest = 0;
+    uint64_t run = 0;
+    for (const IndexedEdit& e : edits) {
+        if (e.op == ' ') {
+            if (run++ == 0) ++snakes;
+            ++snakeLines;
+            if (run > longest) longest = run;
+        } else {
+            ++distance;
+            run = 0;
+        }
+    }
+    diffStatsAdd(DiffCounter::EditDistance, distance);
+    diffStatsAdd(DiffCounter::SnakeCount, snakes);
+    diffStatsAdd(DiffCounter::SnakeLines, snakeLines);
+    diffStatsMax(DiffCounter::LongestSnake, longest);
+}
+
+inline DiffStats diffStatsSnapshot() {
+    const DiffStatsRecorder& r = diffStatsRecorder();
+    auto ms = [&](DiffPhase phase) {
+        return static_cast<double>(r.phaseNs[static_cast<size_t>(phase)].load(std::memory_order_relaxed)) / 1e6;
+    };
+    auto count = [&](DiffCounter counter) {
+        return static_cast<double>(r.counters[static_cast<size_t>(counter)].load(std::memory_order_relaxed));
+    };
+
+    DiffStats stats{};
+    stats.enabled = 1.0;
+    stats.totalMs = static_cast<double>(r.totalNs.load(std::memory_order_relaxed)) / 1e6;
+    stats.splitMs = ms(DiffPhase::Split);
+    stats.lineDiffMs = ms(DiffPhase::LineDiff);
+    stats.buildRowsMs = ms(DiffPhase::BuildRows);
+    stats.tokenDiffMs = ms(DiffPhase::TokenDiff);
+    // 토큰 diff 는 직렬화 도중에 실행되므로 그만큼 뺌
+    stats.serializeMs = ms(DiffPhase::Serialize) > stats.tokenDiffMs ? ms(DiffPhase::Serialize) - stats.tokenDiffMs
+                                                                      : 0.0;
+    stats.editDistance = count(DiffCounter::EditDistance);
+    stats.snakeCount = count(DiffCounter::SnakeCount);
+    stats.snakeLines = count(DiffCounter::SnakeLines);
+    stats.longestSnake = count(DiffCounter::LongestSnake);
+    stats.myersSteps = count(DiffCounter::MyersSteps);
+    stats.tokenRows = count(DiffCounter::TokenRows);
+    stats.tokenCount = count(DiffCounter::TokenCount);
+    stats.allocCount = count(DiffCounter::AllocCount);
+    stats.allocBytes = count(DiffCounter::AllocBytes);
+    return stats;
+}
+
+#define DIFF_STATS_CALL() DiffStatsCall diffStatsCall_
+#define DIFF_STATS_MARK(phase) diffStatsCall_.mark(DiffPhase::phase)
+#define DIFF_STATS_SCOPE(phase) DiffStatsScope diffStatsScope_(DiffPhase::phase)
+#define DIFF_STATS_ADD(counter, value) diffStatsAdd(DiffCounter::counter, static_cast<uint64_t>(value))
+#define DIFF_STATS_EDITS(edits) diffStatsRecordEdits(edits)
+
+#else
+
+inline DiffStats diffStatsSnapshot() {
+    return DiffStats{};
+}
+
+#define DIFF_STATS_CALL() ((void)0)
+#define DIFF_STATS_MARK(phase) ((void)0)
+#define DIFF_STATS_SCOPE(phase) ((void)0)
+#define DIFF_STATS_ADD(counter, value) ((void)0)
+#define DIFF_STATS_EDITS(edits) ((void)0)
+
+#endif
@@ -0,0 +1,53 @@
+// ------------------------------------------------------------
+// 인덱스 기반 편집 스크립트
+// ------------------------------------------------------------
+// 모든 줄 단위 diff 엔진은 텍스트를 복사하지 않고 원본 줄 번호만 담은
+// IndexedEdit 벡터를 결과로 돌려준다. 실제 텍스트는 출력 단계에서
+// 원본 버퍼(string_view)를 통해 꺼낸다.
+// ------------------------------------------------------------
+#pragma once
+
+#include <vector>
+
+// ------------------------------------------------------------
+// 인덱스 기반 편집 연산 (텍스트를 복사하지 않고 줄 번호만 보관)
+//   op     : ' ' (같은 줄), '-' (삭제), '+' (추가)
+//   aIndex : 기준 텍스트 줄 번호 (추가인 경우 -1)
+//   bIndex : 변경 텍스트 줄 번호 (삭제인 경우 -1)
+// ------------------------------------------------------------
+struct IndexedEdit {
+    char op;
+    int aIndex;
+    int bIndex;
+};
+
+// ------------------------------------------------------------
+// 같은 줄로 짝지어진 (기준 줄 번호, 변경 줄 번호) 쌍
+// ------------------------------------------------------------
+struct LineMatch {
+    int aIndex;
+    int bIndex;
+};
+
+// ------------------------------------------------------------
+// 증가하는 LineMatch 목록으로부터 a[aLo, aHi), b[bLo, bHi) 전체의
+// 편집 스크립트를 만들어 out 뒤에 추가
+//   - 두 match 사이의 빈 구간은 "삭제 블록 -> 추가 블록" 순서로 채운다
+// ------------------------------------------------------------
+inline void appendScriptFromMatches(std::vector<IndexedEdit>& out, const std::vector<LineMatch>& matches,
+                                    int aLo, int aHi, int bLo, int bHi) {
+    int x = aLo;
+    int y = bLo;
+    auto fillGap = [&](int xEnd, int yEnd) {
+        for (; x < xEnd; ++x) out.push_back({'-', x, -1});
+        for (; y < yEnd; ++y) out.push_back({'+', -1, y});
+    };
+
+    for (const LineMatch& match : matches) {
+        fillGap(match.aIndex, match.bIndex);
+        out.push_back({' ', match.aIndex, match.bIndex});
+        ++x;
+        ++y;
+    }
+    fillGap(aHi, bHi);
+}
@@ -0,0 +1,299 @@
+// ------------------------------------------------------------
+// 작은 편집 뒤의 증분 diff
+// ------------------------------------------------------------
+// 편집기에서 한 줄을 고칠 때마다 diff_text() 를 다시 부르면 파일 전체를 다시 나누고
+// 다시 비교한다. IncrementalDiff 는 양쪽 줄 목록 / 줄 ID / row 목록을 들고 있다가
+// 편집 하나 (어느 쪽, 줄 범위 [begin, end), 새 텍스트) 가 들어오면
+//   1) 편집한 줄을 가진 row 구간을 찾고
+//   2) 양쪽으로 ANCHOR_RUN 줄 연속 equal 인 곳 (안정된 앵커) 까지만 넓혀서
+//   3) 그 창 안의 줄만 다시 줄 diff 하고 row 목록의 그 구간을 바꿔 끼운 뒤
+//   4) 바뀐 row 만 JSON 으로 돌려준다
+//      {"row": 바뀐 첫 row 번호, "removed": 이전 결과에서 지울 row 수,
+//       "start": [기준 줄 번호, 변경 줄 번호], "rows": [...], "degraded": [...]}
+//      (start 는 LazyDiffResult 와 같이 첫 row 앞의 양쪽 줄 수)
+//
+// 줄 diff / 토큰 diff / JSON 은 창 크기에만 비례한다. 파일 크기에 비례하는 것은 줄 배열과
+// row 배열을 옮기는 memmove, 줄 수가 바뀐 편집 뒤의 row 줄 번호 갱신 (정수 덧셈) 뿐이다.
+// 창 경계가 앵커에 묶이므로 결과는 올바른 diff 지만, 전체를 다시 비교한 결과와
+// 항상 같은 정렬이라는 보장은 없다.
+//
+// 새 텍스트는 파일과 같은 규칙으로 줄을 나눈다 (빈 문자열 = 줄 없음, 끝의 '\n' 하나는 줄 끝).
+// 편집으로 생긴 텍스트는 따로 쌓아 두고, 버려진 텍스트가 살아 있는 줄보다 커지면
+// 한 번에 다시 모은다 (row 는 줄 번호 기준이라 그대로 유지됨).
+// (결과 하나를 여러 스레드가 동시에 쓰는 것은 안 됨)
+//
+//   IncrementalDiff diff(baseText, changedText, options);
+//   diff.full();                                     // 처음 화면용 전체 row
+//   diff.edit(INCREMENTAL_SIDE_CHANGED, 10, 11, "new line\n");
+//   diff.result() / diff.resultSize()                // 다음 full() / edit() 전까지 유효
+// ------------------------------------------------------------
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "diff_core.hpp"
+#include "line_index.hpp"
+
+constexpr int INCREMENTAL_SIDE_BASE = 0;
+constexpr int INCREMENTAL_SIDE_CHANGED = 1;
+
+// row 하나와 그 row 앞까지 나온 양쪽 줄 수
+//   equal / replace 는 aLine, bLine 번 줄을 가지고, delete 는 aLine, insert 는 bLine 번 줄만 가짐
+//   (insert / delete row 에도 줄 수를 두므로 두 값 모두 row 순서대로 줄지 않음)
+struct IncrementalRow {
+    RowOp op;
+    int aLine;
+    int bLine;
+};
+
+class IncrementalDiff {
+public:
+    // 창 경계로 인정하는 연속 equal row 수 (stream_session.hpp 의 앵커와 같은 두 줄)
+    static constexpr size_t ANCHOR_RUN = 2;
+    // 버려진 텍스트가 이만큼은 쌓여야 다시 모음
+    static constexpr size_t COMPACT_MIN_BYTES = size_t(1) << 20;
+
+    IncrementalDiff(std::string_view baseText, std::string_view changedText,
+                    const DiffOptions& options = DiffOptions())
+        : options_(options) {
+        texts_.emplace_back(baseText);
+        texts_.emplace_back(changedText);
+        splitLineViews(texts_[0], lines_.aLines);
+        splitLineViews(texts_[1], lines_.bLines);
+        storedBytes_ = liveBytes_ = baseText.size() + changedText.size();
+        assignLineIds(lines_, interner_, options_.normalize);
+
+        std::vector<DiffRow> rows;
+        buildRows(runLineDiff(lines_, options_, scratch_), rows);
+        degraded_ = scratch_.degraded;
+        appendPositioned(rows, 0, 0, rows_);
+    }
+
+    // 줄 view 가 복사해 둔 텍스트를 가리키므로 복사 / 이동하지 않음
+    IncrementalDiff(const IncrementalDiff&) = delete;
+    IncrementalDiff& operator=(const IncrementalDiff&) = delete;
+
+    size_t rowCount() const { return rows_.size(); }
+    const std::vector<IncrementalRow>& rows() const { return rows_; }
+
+    // 지금까지의 줄 diff 중 하나라도 예산 때문에 최소 diff 가 아니었으면 DIFF_DEGRADED_* 비트
+    uint32_t degraded() const { return degraded_; }
+
+    // 전체 row 를 diff_text 와 같은 JSON 으로 만들고 그 길이를 반환
+    //   (context 로 접지 않음: edit() 의 row 번호가 이 목록 기준)
+    size_t full() {
+        result_.clear();
+        result_ += "{\n  \"rows\": [\n";
+        appendRows(0, rows_.size());
+        appendRowsJsonEnd(result_, degraded_);
+        return result_.size();
+    }
+
+    // side 쪽 [begin, end) 줄을 text 의 줄로 바꾸고 바뀐 row 만 JSON 으로 만든 뒤 그 길이를 반환
+    //   side 가 INCREMENTAL_SIDE_* 가 아니거나 범위가 줄 수를 넘으면 아무것도 바꾸지 않고 0
+    size_t edit(int side, size_t begin, size_t end, std::string_view text) {
+        result_.clear();
+        if (side != INCREMENTAL_SIDE_BASE && side != INCREMENTAL_SIDE_CHANGED) return 0;
+        const bool base = side == INCREMENTAL_SIDE_BASE;
+        std::vector<std::string_view>& sideLines = base ? lines_.aLines : lines_.bLines;
+        std::vector<uint32_t>& sideIds = base ? lines_.aIds : lines_.bIds;
+        if (begin > end || end > sideLines.size()) return 0;
+        int IncrementalRow::*sideLine = base ? &IncrementalRow::aLine : &IncrementalRow::bLine;
+
+        // 1) 편집한 줄을 가진 row 구간 [first, last)
+        //    줄 수는 row 순서대로 줄지 않으므로 이분 탐색
+        auto lineBefore = [&](size_t line) {
+            return [sideLine, line](const IncrementalRow& row) { return row.*sideLine < static_cast<int>(line); };
+        };
+        size_t first = std::partition_point(rows_.begin(), rows_.end(), lineBefore(begin)) - rows_.begin();
+        size_t last = std::partition_point(rows_.begin() + first, rows_.end(), lineBefore(end)) - rows_.begin();
+
+        // 2) 양쪽으로 앵커까지 넓힘 (파일 처음 / 끝도 앵커)
+        size_t lo = first;
+        size_t hi = last;
+        while (lo > 0 && !(lo >= ANCHOR_RUN && equalRun(lo - ANCHOR_RUN))) --lo;
+        while (hi < rows_.size() && !equalRun(hi)) ++hi;
+
+        const size_t aLo = linesBefore(lo, &IncrementalRow::aLine, lines_.aLines.size());
+        const size_t bLo = linesBefore(lo, &IncrementalRow::bLine, lines_.bLines.size());
+        size_t aHi = linesBefore(hi, &IncrementalRow::aLine, lines_.aLines.size());
+        size_t bHi = linesBefore(hi, &IncrementalRow::bLine, lines_.bLines.size());
+
+        // 3) 줄 / ID 를 바꿔 끼움
+        newLines_.clear();
+        newIds_.clear();
+        if (!text.empty()) {
+            texts_.emplace_back(text);
+            storedBytes_ += text.size();
+            splitLineViews(texts_.back(), newLines_);
+            if (text.back() == '\n') newLines_.pop_back();
+            for (std::string_view line : newLines_) newIds_.push_back(interner_.intern(line));
+        }
+        for (size_t i = begin; i < end; ++i) liveBytes_ -= sideLines[i].size();
+        for (std::string_view line : newLines_) liveBytes_ += line.size();
+        replaceRange(sideLines, begin, end, newLines_);
+        replaceRange(sideIds, begin, end, newIds_);
+
+        const int shift = static_cast<int>(newLines_.size()) - static_cast<int>(end - begin);
+        (base ? aHi : bHi) += shift;
+
+        // 4) 창 안만 다시 비교 (ID 는 창 안에서 0 부터 다시 붙여 파일 전체의 ID 수와 무관하게)
+        diffWindow(aLo, aHi, bLo, bHi);
+        replaceRange(rows_, lo, hi, windowRows_);
+        if (shift != 0) {
+            for (size_t i = lo + windowRows_.size(); i < rows_.size(); ++i) rows_[i].*sideLine += shift;
+        }
+
+        // 5) 바뀐 row 만 JSON 으로
+        result_ += "{\n  \"row\": ";
+        result_ += std::to_string(lo);
+        result_ += ",\n  \"removed\": ";
+        result_ += std::to_string(hi - lo);
+        result_ += ",\n  \"start\": [";
+        result_ += std::to_string(aLo);
+        result_ += ", ";
+        result_ += std::to_string(bLo);
+        result_ += "],\n  \"rows\": [\n";
+        appendRows(lo, lo + windowRows_.size());
+        appendRowsJsonEnd(result_, degraded_);
+
+        if (storedBytes_ > liveBytes_ * 2 + COMPACT_MIN_BYTES) compact();
+        return result_.size();
+    }
+
+    // 마지막 full() / edit() 의 결과 ('\0' 으로 끝남)
+    const char* result() const { return result_.c_str(); }
+    size_t resultSize() const { return result_.size(); }
+
+private:
+    static constexpr uint32_t NO_LOCAL_ID = 0xFFFFFFFFu;
+
+    DiffOptions options_;
+    std::deque<std::string> texts_;  // 줄 view 가 가리키는 텍스트 (뒤에 넣어도 기존 원소는 그대로)
+    size_t storedBytes_ = 0;         // texts_ 전체 크기
+    size_t liveBytes_ = 0;           // 지금 줄들이 쓰는 크기
+
+    InternedLines lines_;
+    LineInterner interner_;
+    std::vector<IncrementalRow> rows_;
+    uint32_t degraded_ = 0;
+
+    // 편집마다 다시 쓰는 버퍼
+    std::vector<std::string_view> newLines_;
+    std::vector<uint32_t> newIds_;
+    InternedLines window_;
+    std::vector<uint32_t> localIds_;  // 파일 ID -> 창 ID (쓴 칸만 되돌려 놓음)
+    std::vector<uint32_t> touchedIds_;
+    LineDiffScratch scratch_;
+    std::vector<DiffRow> windowDiffRows_;
+    std::vector<IncrementalRow> windowRows_;
+    std::string result_;
+
+    bool equalRun(size_t from) const {
+        if (from + ANCHOR_RUN > rows_.size()) return false;
+        for (size_t i = from; i < from + ANCHOR_RUN; ++i) {
+            if (rows_[i].op != RowOp::Equal) return false;
+        }
+        return true;
+    }
+
+    size_t linesBefore(size_t row, int IncrementalRow::*side, size_t total) const {
+        return row < rows_.size() ? static_cast<size_t>(rows_[row].*side) : total;
+    }
+
+    // v 의 [begin, end) 를 items 로 바꿈 (뒤쪽은 한 번만 옮김)
+    template <typename T>
+    static void replaceRange(std::vector<T>& v, size_t begin, size_t end, const std::vector<T>& items) {
+        size_t removed = end - begin;
+        size_t common = std::min(removed, items.size());
+        std::copy(items.begin(), items.begin() + common, v.begin() + begin);
+        if (items.size() > removed) {
+            v.insert(v.begin() + end, items.begin() + common, items.end());
+        } else {
+            v.erase(v.begin() + begin + common, v.begin() + end);
+        }
+    }
+
+    // 줄 번호 row -> 앞까지 나온 줄 수를 붙인 row
+    static void appendPositioned(const std::vector<DiffRow>& rows, int aLine, int bLine,
+                                 std::vector<IncrementalRow>& out) {
+        out.reserve(out.size() + rows.size());
+        for (const DiffRow& row : rows) {
+            out.push_back({row.op, aLine, bLine});
+            if (row.op != RowOp::Insert) ++aLine;
+            if (row.op != RowOp::Delete) ++bLine;
+        }
+    }
+
+    uint32_t localId(uint32_t id) {
+        if (id >= localIds_.size()) localIds_.resize(interner_.size(), NO_LOCAL_ID);
+        uint32_t& slot = localIds_[id];
+        if (slot == NO_LOCAL_ID) {
+            slot = window_.idCount++;
+            touchedIds_.push_back(id);
+        }
+        return slot;
+    }
+
+    // 기준 [aLo, aHi), 변경 [bLo, bHi) 줄을 비교해 windowRows_ 에 채움
+    void diffWindow(size_t aLo, size_t aHi, size_t bLo, size_t bHi) {
+        window_.aLines.assign(lines_.aLines.begin() + aLo, lines_.aLines.begin() + aHi);
+        window_.bLines.assign(lines_.bLines.begin() + bLo, lines_.bLines.begin() + bHi);
+        window_.aIds.clear();
+        window_.bIds.clear();
+        window_.idCount = 0;
+        for (size_t i = aLo; i < aHi; ++i) window_.aIds.push_back(localId(lines_.aIds[i]));
+        for (size_t i = bLo; i < bHi; ++i) window_.bIds.push_back(localId(lines_.bIds[i]));
+        for (uint32_t id : touchedIds_) localIds_[id] = NO_LOCAL_ID;
+        touchedIds_.clear();
+
+        buildRows(runLineDiff(window_, options_, scratch_), windowDiffRows_);
+        degraded_ |= scratch_.degraded;
+        windowRows_.clear();
+        appendPositioned(windowDiffRows_, static_cast<int>(aLo), static_cast<int>(bLo), windowRows_);
+    }
+
+    void appendRows(size_t from, size_t to) {
+        for (size_t i = from; i < to; ++i) {
+            const IncrementalRow& row = rows_[i];
+            std::string_view leftText = row.op != RowOp::Insert ? lines_.aLines[row.aLine] : std::string_view();
+            std::string_view rightText = row.op != RowOp::Delete ? lines_.bLines[row.bLine] : std::string_view();
+
+            if (i != from) result_ += ",\n";
+            appendRowJsonFields(result_, row.op, leftText, rightText);
+            if (row.op == RowOp::Replace) {
+                result_ += ",\"tokens\":";
+                appendTokensJson(result_, leftText, rightText, options_.tokenMode);
+            }
+            result_ += '}';
+        }
+    }
+
+    // 살아 있는 줄만 새 텍스트 두 개로 모으고 ID 를 다시 붙임 (row 는 그대로)
+    void compact() {
+        std::deque<std::string> texts;
+        for (std::vector<std::string_view>* lines : {&lines_.aLines, &lines_.bLines}) {
+            std::string& text = texts.emplace_back();
+            size_t bytes = 0;
+            for (std::string_view line : *lines) bytes += line.size();
+            text.reserve(bytes);
+            for (std::string_view line : *lines) text += line;
+
+            size_t offset = 0;
+            for (std::string_view& line : *lines) {
+                line = std::string_view(text.data() + offset, line.size());
+                offset += line.size();
+            }
+        }
+        texts_ = std::move(texts);
+        storedBytes_ = liveBytes_;
+        assignLineIds(lines_, interner_, options_.normalize);
+        localIds_.assign(interner_.size(), NO_LOCAL_ID);
+    }
+};
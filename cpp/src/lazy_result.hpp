@@ -0,0 +1,132 @@
+// ------------------------------------------------------------
+// 필요한 부분만 꺼내 보는 diff 결과
+// ------------------------------------------------------------
+// diff_text() 는 같은 줄까지 모든 row 를 텍스트와 함께 JSON 으로 만들지만, 화면에는
+// 그중 스크롤한 부분만 보인다. LazyDiffResult 는 만들 때 줄 diff 와 row 목록
+// (row 당 op + 양쪽 줄 번호)까지만 계산해 두고,
+//   - rowCount() / ops() : 전체 모양 (몇 줄이고 각 row 가 무슨 op 인지)
+//   - range(i, j)        : [i, j) 번 row 만 diff_text 와 같은 JSON 으로
+// 을 제공한다. replace row 의 토큰 diff 는 그 row 가 처음 range 에 들어올 때 계산해서
+// 기억해 두므로, 같은 구간을 다시 봐도 다시 계산하지 않는다.
+//
+// 두 입력은 복사해 두므로 만든 뒤에 호출자 버퍼를 버려도 된다.
+// (결과 하나를 여러 스레드가 동시에 쓰는 것은 안 됨)
+//
+//   LazyDiffResult result(baseText, changedText, options);
+//   result.range(1000, 1100);
+//   result.rangeResult() / result.rangeSize()   // 다음 range() 전까지 유효
+// ------------------------------------------------------------
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "diff_core.hpp"
+#include "line_index.hpp"
+
+class LazyDiffResult {
+public:
+    LazyDiffResult(std::string_view baseText, std::string_view changedText,
+                   const DiffOptions& options = DiffOptions())
+        : baseText_(baseText), changedText_(changedText), tokenMode_(options.tokenMode) {
+        InternedLines lines;
+        splitLineViews(baseText_, lines.aLines);
+        splitLineViews(changedText_, lines.bLines);
+        LineInterner interner;
+        assignLineIds(lines, interner, options.normalize);
+
+        LineDiffScratch scratch;
+        buildRows(runLineDiff(lines, options, scratch), rows_);
+        degraded_ = scratch.degraded;
+
+        aLines_ = std::move(lines.aLines);
+        bLines_ = std::move(lines.bLines);
+        ops_.reserve(rows_.size());
+        for (const DiffRow& row : rows_) ops_.push_back(static_cast<uint8_t>(row.op));
+    }
+
+    // 줄 view 가 복사해 둔 입력을 가리키므로 복사 / 이동하지 않음
+    LazyDiffResult(const LazyDiffResult&) = delete;
+    LazyDiffResult& operator=(const LazyDiffResult&) = delete;
+
+    size_t rowCount() const { return rows_.size(); }
+
+    // row 별 op (RowOp 값: 0 = equal, 1 = delete, 2 = insert, 3 = replace), rowCount() 개
+    const uint8_t* ops() const { return ops_.data(); }
+
+    // 예산 때문에 최소 diff 가 아니면 DIFF_DEGRADED_* 비트
+    uint32_t degraded() const { return degraded_; }
+
+    // 토큰 diff 를 계산해 둔 replace row 수
+    size_t cachedTokenRows() const { return tokens_.size(); }
+
+    // [begin, end) 번 row 를 JSON 으로 만들고 그 길이를 반환 (범위는 rowCount() 안으로 자름)
+    //   {"start": [기준 줄 번호, 변경 줄 번호], "rows": [...], "degraded": [...]}
+    //   start 는 begin 번 row 앞에 나온 양쪽 줄 수 (화면의 줄 번호용)
+    size_t range(size_t begin, size_t end) {
+        end = std::min(end, rows_.size());
+        begin = std::min(begin, end);
+
+        range_.clear();
+        range_ += "{\n  \"start\": [";
+        range_ += std::to_string(linesBefore(begin, &DiffRow::leftIndex, aLines_.size()));
+        range_ += ", ";
+        range_ += std::to_string(linesBefore(begin, &DiffRow::rightIndex, bLines_.size()));
+        range_ += "],\n  \"rows\": [\n";
+
+        for (size_t i = begin; i < end; ++i) {
+            const DiffRow& row = rows_[i];
+            std::string_view leftText  = (row.leftIndex >= 0) ? aLines_[row.leftIndex] : std::string_view();
+            std::string_view rightText = (row.rightIndex >= 0) ? bLines_[row.rightIndex] : std::string_view();
+
+            if (i != begin) range_ += ",\n";
+            appendRowJsonFields(range_, row.op, leftText, rightText);
+            if (row.op == RowOp::Replace) {
+                range_ += ",\"tokens\":";
+                range_ += tokensJson(static_cast<uint32_t>(i), leftText, rightText);
+            }
+            range_ += '}';
+        }
+
+        appendRowsJsonEnd(range_, degraded_);
+        return range_.size();
+    }
+
+    // 마지막 range() 의 결과 ('\0' 으로 끝남)
+    const char* rangeResult() const { return range_.c_str(); }
+    size_t rangeSize() const { return range_.size(); }
+
+private:
+    std::string baseText_;
+    std::string changedText_;
+    TokenMode tokenMode_;
+
+    std::vector<std::string_view> aLines_;
+    std::vector<std::string_view> bLines_;
+    std::vector<DiffRow> rows_;
+    std::vector<uint8_t> ops_;
+    uint32_t degraded_ = 0;
+
+    std::unordered_map<uint32_t, std::string> tokens_;  // row 번호 -> 토큰 JSON 배열
+    std::string range_;
+
+    const std::string& tokensJson(uint32_t row, std::string_view leftText, std::string_view rightText) {
+        auto [it, inserted] = tokens_.try_emplace(row);
+        if (inserted) appendTokensJson(it->second, leftText, rightText, tokenMode_);
+        return it->second;
+    }
+
+    // begin 번 row 앞에 나온 한쪽 줄 수
+    //   줄 번호는 row 순서대로 늘어나므로 begin 부터 처음 만나는 그쪽 줄 번호가 곧 답
+    size_t linesBefore(size_t begin, int DiffRow::*side, size_t total) const {
+        for (size_t i = begin; i < rows_.size(); ++i) {
+            if (rows_[i].*side >= 0) return static_cast<size_t>(rows_[i].*side);
+        }
+        return total;
+    }
+};
@@ -0,0 +1,371 @@
+// ------------------------------------------------------------
+// 줄 분할 + 줄 인터닝(interning)
+// ------------------------------------------------------------
+// 1) 입력 버퍼를 복사하지 않고 string_view 로 줄을 나눈다.
+// 2) 각 줄을 한 번만 해시해서 공용 테이블에 넣고, 두 입력 모두에
+//    같은 내용이면 같은 "줄 ID"(0, 1, 2, ... 연속된 32비트 정수)를 준다.
+// 3) diff 엔진은 문자열 대신 uint32_t 배열을 비교한다.
+//
+// 추가로, 한쪽 파일에만 있는 줄은 절대 "같은 줄"이 될 수 없으므로
+// Myers 를 돌리기 전에 빼 두었다가 결과를 만들 때 삭제/추가로 되돌린다.
+//
+// 정규화(LINE_IGNORE_*)를 켜면 해시와 비교만 정규화된 내용으로 한다.
+// 정규화한 복사본을 만들지 않으므로 줄 view 는 여전히 원문을 가리키고,
+// 결과 row 에도 원문이 그대로 나간다.
+// ------------------------------------------------------------
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "edit_script.hpp"
+#include "simd_scan.hpp"
+
+// ------------------------------------------------------------
+// 버퍼를 '\n' 기준으로 잘라 원본을 가리키는 string_view 로 반환
+//   - splitLines 와 같은 규칙: 마지막 줄은 '\n' 이 없어도 한 줄
+//   - '\n' 위치는 SIMD 스캐너(simd_scan.hpp)로 찾는다
+//   - lines 를 비우고 채운다 (용량은 그대로 두어 반복 호출 시 재할당 없음)
+// ------------------------------------------------------------
+inline void splitLineViews(std::string_view text, std::vector<std::string_view>& lines) {
+    lines.clear();
+    const char* data = text.data();
+    size_t lineStart = 0;
+    forEachByte(text, '\n', [&](size_t newline) {
+        lines.emplace_back(data + lineStart, newline - lineStart);
+        lineStart = newline + 1;
+    });
+    lines.emplace_back(data + lineStart, text.size() - lineStart);
+}
+
+inline std::vector<std::string_view> splitLineViews(std::string_view text) {
+    std::vector<std::string_view> lines;
+    splitLineViews(text, lines);
+    return lines;
+}
+
+// '\0' 으로 끝나는 C 문자열 버전 (nullptr 이면 줄 없음)
+inline std::vector<std::string_view> splitLineViews(const char* text) {
+    if (!text) return {};
+    return splitLineViews(std::string_view(text));
+}
+
+// ------------------------------------------------------------
+// 바이트열 해시 (8바이트 단위로 섞는 간단한 곱셈 해시)
+// ------------------------------------------------------------
+inline uint64_t hashBytes(const char* data, size_t length) {
+    uint64_t h = 0x9E3779B97F4A7C15ull ^ (length * 0xff51afd7ed558ccdull);
+    while (length >= 8) {
+        uint64_t word;
+        std::memcpy(&word, data, 8);
+        h = (h ^ word) * 0xff51afd7ed558ccdull;
+        h ^= h >> 32;
+        data += 8;
+        length -= 8;
+    }
+    uint64_t tail = 0;
+    std::memcpy(&tail, data, length);
+    h = (h ^ tail) * 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 29;
+    return h;
+}
+
+// ------------------------------------------------------------
+// 줄 비교 정규화 비트 (DiffOptions::normalize)
+//   IGNORE_TRAILING_CR  : 줄 끝의 '\r' 하나를 무시 (CRLF 와 LF 를 같게)
+//   IGNORE_ALL_SPACE    : 공백 문자를 모두 무시
+//   IGNORE_SPACE_CHANGE : 공백 묶음은 공백 하나로 보고, 줄 끝 공백은 무시
+//   IGNORE_CASE         : ASCII 대소문자를 무시
+// ------------------------------------------------------------
+constexpr uint32_t LINE_IGNORE_TRAILING_CR = 1u << 0;
+constexpr uint32_t LINE_IGNORE_ALL_SPACE = 1u << 1;
+constexpr uint32_t LINE_IGNORE_SPACE_CHANGE = 1u << 2;
+constexpr uint32_t LINE_IGNORE_CASE = 1u << 3;
+
+inline bool isLineSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// ------------------------------------------------------------
+// 정규화된 줄을 한 바이트씩 꺼내는 커서 (원문을 읽기만 함)
+//   - 줄 끝 처리('\r', 줄 끝 공백)는 만들 때 범위를 줄여 두고
+//   - 공백 / 대소문자는 next() 에서 바이트마다 처리
+// ------------------------------------------------------------
+class NormalizedLineCursor {
+public:
+    NormalizedLineCursor(std::string_view line, uint32_t normalize)
+        : data_(line.data()), end_(line.size()), normalize_(normalize) {
+        if ((normalize & LINE_IGNORE_TRAILING_CR) && end_ > 0 && data_[end_ - 1] == '\r') --end_;
+        if (normalize & LINE_IGNORE_SPACE_CHANGE) {
+            while (end_ > 0 && isLineSpace(data_[end_ - 1])) --end_;
+        }
+    }
+
+    // 줄 끝 처리 말고는 바이트를 바꾸지 않는지 (그러면 rest() 를 그대로 비교 / 해시)
+    bool plain() const { return (normalize_ & ~LINE_IGNORE_TRAILING_CR) == 0; }
+    std::string_view rest() const { return std::string_view(data_ + pos_, end_ - pos_); }
+
+    bool next(char& c) {
+        while (pos_ < end_) {
+            char ch = data_[pos_++];
+            if ((normalize_ & (LINE_IGNORE_ALL_SPACE | LINE_IGNORE_SPACE_CHANGE)) && isLineSpace(ch)) {
+                if (normalize_ & LINE_IGNORE_ALL_SPACE) continue;
+                while (pos_ < end_ && isLineSpace(data_[pos_])) ++pos_;
+                ch = ' ';
+            } else if ((normalize_ & LINE_IGNORE_CASE) && ch >= 'A' && ch <= 'Z') {
+                ch = static_cast<char>(ch - 'A' + 'a');
+            }
+            c = ch;
+            return true;
+        }
+        return false;
+    }
+
+private:
+    const char* data_;
+    size_t end_;
+    size_t pos_ = 0;
+    uint32_t normalize_;
+};
+
+// 정규화된 내용의 해시 (hashBytes 와 같은 방식으로 8바이트씩 모아 섞음)
+inline uint64_t hashNormalizedLine(std::string_view line, uint32_t normalize) {
+    NormalizedLineCursor cursor(line, normalize);
+    if (cursor.plain()) {
+        std::string_view rest = cursor.rest();
+        return hashBytes(rest.data(), rest.size());
+    }
+
+    uint64_t h = 0x9E3779B97F4A7C15ull;
+    uint64_t word = 0;
+    size_t filled = 0;
+    size_t length = 0;
+    char c;
+    while (cursor.next(c)) {
+        word |= static_cast<uint64_t>(static_cast<uint8_t>(c)) << (filled * 8);
+        ++length;
+        if (++filled == 8) {
+            h = (h ^ word) * 0xff51afd7ed558ccdull;
+            h ^= h >> 32;
+            word = 0;
+            filled = 0;
+        }
+    }
+    h ^= length * 0xff51afd7ed558ccdull;
+    h = (h ^ word) * 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 29;
+    return h;
+}
+
+// 정규화했을 때 두 줄이 같은지
+inline bool equalNormalizedLines(std::string_view a, std::string_view b, uint32_t normalize) {
+    if (a == b) return true;
+    if (normalize == 0) return false;
+
+    NormalizedLineCursor left(a, normalize);
+    NormalizedLineCursor right(b, normalize);
+    if (left.plain()) return left.rest() == right.rest();
+
+    char x = 0;
+    char y = 0;
+    while (true) {
+        bool hasX = left.next(x);
+        bool hasY = right.next(y);
+        if (hasX != hasY) return false;
+        if (!hasX) return true;
+        if (x != y) return false;
+    }
+}
+
+// ------------------------------------------------------------
+// 줄 내용 -> 줄 ID 테이블 (open addressing)
+//   normalize 가 0 이 아니면 정규화된 내용이 같은 줄끼리 같은 ID
+//   (대표 텍스트는 처음 넣은 줄의 원문)
+// ------------------------------------------------------------
+class LineInterner {
+public:
+    explicit LineInterner(size_t expectedLines = 0, uint32_t normalize = 0) { reset(expectedLines, normalize); }
+
+    // 테이블을 비움 (확보해 둔 용량은 재사용)
+    void reset(size_t expectedLines, uint32_t normalize = 0) {
+        normalize_ = normalize;
+        size_t capacity = 16;
+        while (capacity < expectedLines * 2) capacity <<= 1;
+        slots_.assign(capacity, EMPTY);
+        lines_.clear();
+        hashes_.clear();
+        lines_.reserve(expectedLines);
+        hashes_.reserve(expectedLines);
+    }
+
+    // 줄을 테이블에 넣고 ID 반환 (이미 있으면 기존 ID)
+    uint32_t intern(std::string_view line) {
+        uint64_t h = hashLine(line);
+        size_t pos = probe(line, h);
+        if (slots_[pos] != EMPTY) {
+            return slots_[pos];
+        }
+
+        uint32_t id = static_cast<uint32_t>(lines_.size());
+        slots_[pos] = id;
+        lines_.push_back(line);
+        hashes_.push_back(h);
+
+        if (lines_.size() * 2 > slots_.size()) {
+            grow();
+        }
+        return id;
+    }
+
+    // 테이블을 바꾸지 않고 줄 ID 만 찾음 (없으면 NOT_FOUND). 여러 스레드에서 동시에 불러도 됨
+    uint32_t find(std::string_view line) const {
+        return slots_[probe(line, hashLine(line))];
+    }
+
+    size_t size() const { return lines_.size(); }
+    uint32_t normalize() const { return normalize_; }
+
+    static constexpr uint32_t NOT_FOUND = 0xFFFFFFFFu;
+
+private:
+    static constexpr uint32_t EMPTY = NOT_FOUND;
+
+    std::vector<uint32_t> slots_;          // 해시 슬롯 -> 줄 ID
+    std::vector<std::string_view> lines_;  // 줄 ID -> 대표 텍스트
+    std::vector<uint64_t> hashes_;         // 줄 ID -> 해시값
+    uint32_t normalize_ = 0;               // LINE_IGNORE_* 비트
+
+    uint64_t hashLine(std::string_view line) const {
+        return normalize_ ? hashNormalizedLine(line, normalize_) : hashBytes(line.data(), line.size());
+    }
+
+    // line 이 있는 슬롯, 없으면 넣을 빈 슬롯
+    size_t probe(std::string_view line, uint64_t h) const {
+        size_t mask = slots_.size() - 1;
+        size_t pos = static_cast<size_t>(h) & mask;
+        while (slots_[pos] != EMPTY) {
+            uint32_t id = slots_[pos];
+            if (hashes_[id] == h && equalNormalizedLines(lines_[id], line, normalize_)) break;
+            pos = (pos + 1) & mask;
+        }
+        return pos;
+    }
+
+    void grow() {
+        std::vector<uint32_t> old(slots_.size() * 2, EMPTY);
+        slots_.swap(old);
+        size_t mask = slots_.size() - 1;
+        for (uint32_t id = 0; id < lines_.size(); ++id) {
+            size_t pos = static_cast<size_t>(hashes_[id]) & mask;
+            while (slots_[pos] != EMPTY) pos = (pos + 1) & mask;
+            slots_[pos] = id;
+        }
+    }
+};
+
+// ------------------------------------------------------------
+// 두 입력을 줄로 나누고 공용 ID 를 붙인 결과
+// ------------------------------------------------------------
+struct InternedLines {
+    std::vector<std::string_view> aLines;
+    std::vector<std::string_view> bLines;
+    std::vector<uint32_t> aIds;
+    std::vector<uint32_t> bIds;
+    uint32_t idCount = 0;
+};
+
+// lines.aLines / bLines 에 줄 ID 부여 (aIds / bIds 는 비우고 다시 채움)
+//   normalize: LINE_IGNORE_* 비트 (정규화해서 같은 줄은 같은 ID)
+inline void assignLineIds(InternedLines& lines, LineInterner& interner, uint32_t normalize = 0) {
+    interner.reset(lines.aLines.size() + lines.bLines.size(), normalize);
+    lines.aIds.clear();
+    lines.bIds.clear();
+    lines.aIds.reserve(lines.aLines.size());
+    lines.bIds.reserve(lines.bLines.size());
+    for (std::string_view line : lines.aLines) lines.aIds.push_back(interner.intern(line));
+    for (std::string_view line : lines.bLines) lines.bIds.push_back(interner.intern(line));
+    lines.idCount = static_cast<uint32_t>(interner.size());
+}
+
+// 이미 나눠 둔 줄 목록에 ID 부여 (스트리밍 세션처럼 버퍼 일부만 비교할 때)
+inline InternedLines internLineViews(std::vector<std::string_view> aLines, std::vector<std::string_view> bLines,
+                                     uint32_t normalize = 0) {
+    InternedLines result;
+    result.aLines = std::move(aLines);
+    result.bLines = std::move(bLines);
+
+    LineInterner interner;
+    assignLineIds(result, interner, normalize);
+    return result;
+}
+
+inline InternedLines internLines(const char* aText, const char* bText, uint32_t normalize = 0) {
+    return internLineViews(splitLineViews(aText), splitLineViews(bText), normalize);
+}
+
+// ------------------------------------------------------------
+// 상대 파일에 한 번도 나오지 않는 줄을 뺀 ID 배열
+//   ids[i] 는 원본의 origin[i] 번째 줄
+// ------------------------------------------------------------
+struct FilteredIds {
+    std::vector<uint32_t> ids;
+    std::vector<int> origin;
+};
+
+//   seen: ID 별 등장 표시용 작업 버퍼 (bit 0 = a 에 있음, bit 1 = b 에 있음)
+inline void filterUnmatchedLines(const InternedLines& lines, FilteredIds& a, FilteredIds& b,
+                                 std::vector<uint8_t>& seen) {
+    seen.assign(lines.idCount, 0);
+    for (uint32_t id : lines.aIds) seen[id] |= 1;
+    for (uint32_t id : lines.bIds) seen[id] |= 2;
+
+    auto keep = [&seen](const std::vector<uint32_t>& ids, uint8_t other, FilteredIds& out) {
+        out.ids.clear();
+        out.origin.clear();
+        out.ids.reserve(ids.size());
+        out.origin.reserve(ids.size());
+        for (size_t i = 0; i < ids.size(); ++i) {
+            if (seen[ids[i]] & other) {
+                out.ids.push_back(ids[i]);
+                out.origin.push_back(static_cast<int>(i));
+            }
+        }
+    };
+    keep(lines.aIds, 2, a);
+    keep(lines.bIds, 1, b);
+}
+
+inline void filterUnmatchedLines(const InternedLines& lines, FilteredIds& a, FilteredIds& b) {
+    std::vector<uint8_t> seen;
+    filterUnmatchedLines(lines, a, b, seen);
+}
+
+// ------------------------------------------------------------
+// 걸러낸 배열 위에서 구한 같은 줄 쌍을 원본 줄 번호 기준 편집 스크립트로 복원
+//   - 같은 줄 쌍만 원본 번호로 옮기고, 나머지는 삭제/추가로 채운다
+// ------------------------------------------------------------
+//   matches 는 원본 번호로 바꾸는 데 쓰는 작업 버퍼, script 는 비우고 다시 채움
+inline void expandFilteredMatches(const std::vector<LineMatch>& filteredMatches, const FilteredIds& a,
+                                  const FilteredIds& b, int n, int m, std::vector<LineMatch>& matches,
+                                  std::vector<IndexedEdit>& script) {
+    matches.clear();
+    matches.reserve(filteredMatches.size());
+    for (const LineMatch& match : filteredMatches) {
+        matches.push_back({a.origin[match.aIndex], b.origin[match.bIndex]});
+    }
+
+    script.clear();
+    script.reserve(static_cast<size_t>(n + m) - matches.size());
+    appendScriptFromMatches(script, matches, 0, n, 0, m);
+}
+
+inline std::vector<IndexedEdit> expandFilteredMatches(const std::vector<LineMatch>& filteredMatches,
+                                                      const FilteredIds& a, const FilteredIds& b, int n, int m) {
+    std::vector<LineMatch> matches;
+    std::vector<IndexedEdit> script;
+    expandFilteredMatches(filteredMatches, a, b, n, m, matches, script);
+    return script;
+}
@@ -35,484 +35,437 @@
 //   - WASM 에서는 extern "C" 로 감싼 diff_text() 를 호출하면 됨
 // ------------------------------------------------------------
 
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
 #include <string>
+#include <string_view>
 #include <vector>
-#include <unordered_map>
-#include <algorithm>
+
+#include "base_index.hpp"
+#include "binary_result.hpp"
+#include "cli.hpp"
+#include "delta_patch.hpp"
+#include "diff_core.hpp"
+#include "diff_handle.hpp"
+#include "diff_stats.hpp"
+#include "incremental_diff.hpp"
+#include "lazy_result.hpp"
+#include "stream_session.hpp"
 
 using namespace std;
 
 // ------------------------------------------------------------
-// 줄 단위 diff 결과를 담는 구조체
+// 측정 빌드(DIFF_STATS)에서는 operator new 를 바꿔 할당 횟수/바이트를 센다
+//   main.cpp 를 include 하는 다른 실행 파일(DIFF_NO_MAIN)은 자기 것을 쓰도록 제외
+//   noinline: 인라인되면 GCC 가 new 식과 free 를 짝지어 잘못된 경고를 냄
 // ------------------------------------------------------------
-struct Edit {
-    char op;    // ' ' (같은 줄), '-' (삭제), '+' (추가)
-    string text;
-};
+#if defined(DIFF_STATS) && !defined(DIFF_NO_MAIN)
+void* operator new(size_t size) {
+    DIFF_STATS_ADD(AllocCount, 1);
+    DIFF_STATS_ADD(AllocBytes, size);
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw bad_alloc();
+}
+
+[[gnu::noinline]] void operator delete(void* p) noexcept {
+    free(p);
+}
+
+[[gnu::noinline]] void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+#endif
 
 // ------------------------------------------------------------
-// unordered_map<int, int> 에서 값 꺼내기 (없으면 기본값)
+// 실제 diff 로직: baseText / changedText 를 받아 JSON 문자열 생성
+//   - 실행은 스레드마다 하나씩 둔 DiffHandle(diff_handle.hpp)이 맡는다
+//   - 결과 포인터는 같은 스레드의 다음 호출 전까지 유효
+//     (다른 스레드의 호출은 각자의 핸들을 쓰므로 서로 덮어쓰지 않음)
 // ------------------------------------------------------------
-int getOrDefault(const unordered_map<int, int>& m, int key, int defaultValue) {
-    auto it = m.find(key);
-    if (it == m.end()) return defaultValue;
-    return it->second;
+const char* diff_text_impl(const char* baseText, const char* changedText,
+                           const DiffOptions& options = DiffOptions()) {
+    thread_local DiffHandle handle;
+    handle.setOptions(options);
+    handle.run(baseText ? baseText : "", changedText ? changedText : "");
+    return handle.result();
 }
 
 // ------------------------------------------------------------
-// C 문자열(전체 텍스트)을 '\n' 기준으로 잘라서 줄 벡터로 변환
-//   예) "Hello\nWorld" -> ["Hello", "World"]
+// 바이너리 결과 만들기: JSON 대신 입력 버퍼의 (offset, length) 만 기록
+//   - 형식은 binary_result.hpp 참고
 // ------------------------------------------------------------
-vector<string> splitLines(const char* text) {
-    vector<string> lines;
-    if (!text) {
-        return lines;
-    }
-
-    string current;
-    for (const char* p = text; *p != '\0'; ++p) {
-        if (*p == '\n') {
-            lines.push_back(current); // 지금까지 모은 글자들을 한 줄로 추가
-            current.clear();
-        } else {
-            current.push_back(*p);
+const uint32_t* diff_text_binary_impl(const char* baseText, const char* changedText,
+                                      const DiffOptions& options = DiffOptions()) {
+    DIFF_STATS_CALL();
+
+    InternedLines lines = internLines(baseText, changedText, options.normalize);
+    DIFF_STATS_MARK(Split);
+    uint32_t degraded = 0;
+    vector<IndexedEdit> edits = runLineDiff(lines, options, &degraded);
+    DIFF_STATS_MARK(LineDiff);
+    vector<DiffRow> rows = buildRows(edits);
+    DIFF_STATS_MARK(BuildRows);
+
+    // 스레드별 버퍼: 함수가 끝난 뒤에도 포인터가 유효함 (같은 스레드의 다음 호출 때 재사용)
+    thread_local BinaryResultWriter writer;
+    writer.begin(baseText, changedText, rows.size());
+
+    for (const DiffRow& row : rows) {
+        string_view leftText  = (row.leftIndex >= 0) ? lines.aLines[row.leftIndex] : string_view();
+        string_view rightText = (row.rightIndex >= 0) ? lines.bLines[row.rightIndex] : string_view();
+        writer.addRow(static_cast<uint32_t>(row.op), leftText, rightText);
+
+        if (row.op == RowOp::Replace) {
+            for (const AlignedToken& t : threadTokenAligner().align(leftText, rightText, options.tokenMode)) {
+                uint32_t tokenOp = (t.op == 'M') ? 0 : (t.op == 'D') ? 1 : 2;
+                writer.addToken(tokenOp, t.left, t.right);
+            }
         }
     }
-    // 마지막 줄 추가 (마지막에 '\n' 이 없더라도 한 줄로 취급)
-    lines.push_back(current);
 
-    return lines;
+    const uint32_t* words = writer.finish(degraded);
+    DIFF_STATS_MARK(Serialize);
+    return words;
+}
+
+// diff_set_threads 로 정한 스레드 수 (1 = 단일 스레드, 0 = 하드웨어 스레드 수)
+static int diffThreadCount = 1;
+
+// diff_set_budget 으로 정한 줄 diff 비용 상한 (기본: 제한 없음)
+static DiffBudget diffBudget;
+
+// diff_set_context 로 정한 접기 문맥 줄 수 (-1 = 접지 않음)
+static int diffContext = -1;
+
+// 바이너리 델타의 스레드별 결과 버퍼 (diff_delta_ptr / diff_delta_target_ptr 가 가리킴)
+static thread_local DeltaEncoder deltaEncoder;
+static thread_local string deltaTarget;
+
+// 위의 전역 설정을 반영한 옵션
+static DiffOptions currentOptions(int algorithm, int flags) {
+    return makeDiffOptions(algorithm, flags, diffThreadCount, diffBudget, diffContext);
 }
 
 // ------------------------------------------------------------
-// Myers 알고리즘: 줄 단위 diff
+// WASM에서 호출할 함수 (C 스타일 이름)
+//   - 실제 로직은 diff_text_impl 에 있음
 // ------------------------------------------------------------
-vector<Edit> myersDiff(const vector<string>& a, const vector<string>& b) {
-    int n = static_cast<int>(a.size());
-    int m = static_cast<int>(b.size());
+extern "C" {
+    const char* diff_text(const char* baseText, const char* changedText) {
+        return diff_text_impl(baseText, changedText, currentOptions(0, 0));
+    }
 
-    int maxD = n + m;
-    vector<unordered_map<int, int>> trace; // 각 D에서의 V(k -> x)
+    // 이후 호출에서 사용할 스레드 수 (큰 입력에서만 병렬로 처리, 결과 형식은 같음)
+    void diff_set_threads(int threads) {
+        diffThreadCount = threads < 0 ? 1 : threads;
+    }
 
-    unordered_map<int, int> v;
-    v[0] = 0;
+    // 이후 호출의 줄 diff 비용 상한 (diff_budget.hpp). 0 이하인 값은 제한 없음
+    //   maxCost     : Myers 탐색 한 번의 최대 D
+    //   maxMemoryMb : Myers 탐색 상태의 최대 크기 (MB)
+    //   timeLimitMs : 줄 diff 한 번의 제한 시간 (ms)
+    // 상한에 걸리면 결과는 유효하지만 최소가 아닐 수 있고, JSON 에 "degraded" 가 붙는다
+    void diff_set_budget(int maxCost, int maxMemoryMb, double timeLimitMs) {
+        diffBudget.maxCost = maxCost > 0 ? maxCost : 0;
+        diffBudget.maxMemoryBytes = maxMemoryMb > 0 ? static_cast<size_t>(maxMemoryMb) << 20 : 0;
+        diffBudget.timeLimitMs = timeLimitMs > 0.0 ? timeLimitMs : 0.0;
+    }
 
-    if (n == 0 && m == 0) {
-        return {};
+    // 이후 JSON 결과에서 같은 줄 묶음을 접는다 (diff_text / diff_text_ex / 핸들 / 인덱스)
+    //   lines >= 0 : 변경 앞뒤 lines 줄만 남기고 나머지는 {"op":"skip","count":N,"left_line":L,"right_line":R}
+    //   lines < 0  : 접지 않음 (기본)
+    // 접힌 줄은 양쪽이 같으므로 필요할 때 원문의 [L, L + N) 줄을 꺼내 보면 된다.
+    // 바이너리 결과 / 스트리밍 세션 / 지연 결과는 접지 않는다.
+    void diff_set_context(int lines) {
+        diffContext = lines < 0 ? -1 : lines;
     }
 
-    bool finished = false;
-    int finalD = 0;
+    // algorithm: DiffAlgorithm 값 (0 = Myers, 1 = MyersLinear, 2 = Patience, 3 = Histogram)
+    // flags    : DIFF_FLAG_* 비트 조합
+    const char* diff_text_ex(const char* baseText, const char* changedText, int algorithm, int flags) {
+        return diff_text_impl(baseText, changedText, currentOptions(algorithm, flags));
+    }
 
-    for (int d = 0; d <= maxD; ++d) {
-        unordered_map<int, int> newV;
+    // diff_text_ex 와 같은 옵션으로 바이너리 결과를 만든다 (형식은 binary_result.hpp)
+    const uint32_t* diff_text_binary(const char* baseText, const char* changedText, int algorithm, int flags) {
+        return diff_text_binary_impl(baseText, changedText, currentOptions(algorithm, flags));
+    }
 
-        for (int k = -d; k <= d; k += 2) {
-            int xStart;
+    // --------------------------------------------------------
+    // 스트리밍 세션 (stream_session.hpp)
+    //   create -> feed_base / feed_compare 반복 (중간중간 drain) -> finish -> drain -> destroy
+    //   chunkLines: 앵커를 찾을 최소 줄 수 (0 이면 기본값)
+    // --------------------------------------------------------
+    DiffStreamSession* diff_stream_create(int algorithm, int flags, int chunkLines) {
+        return new DiffStreamSession(currentOptions(algorithm, flags), chunkLines);
+    }
 
-            if (k == -d) {
-                xStart = getOrDefault(v, k + 1, 0);         // 아래에서(삽입)
-            } else if (k == d) {
-                xStart = getOrDefault(v, k - 1, 0) + 1;     // 오른쪽에서(삭제)
-            } else {
-                int xFromRight = getOrDefault(v, k - 1, 0) + 1; // 삭제
-                int xFromDown  = getOrDefault(v, k + 1, 0);     // 삽입
-                xStart = (xFromRight > xFromDown) ? xFromRight : xFromDown;
-            }
+    void diff_stream_feed_base(DiffStreamSession* session, const char* data, int length) {
+        if (session && data && length > 0) session->feedBase(data, static_cast<size_t>(length));
+    }
 
-            int yStart = xStart - k;
-            int x = xStart;
-            int y = yStart;
+    void diff_stream_feed_compare(DiffStreamSession* session, const char* data, int length) {
+        if (session && data && length > 0) session->feedCompare(data, static_cast<size_t>(length));
+    }
 
-            // "뱀(snake)" : 같은 줄이 연속되는 구간
-            while (x < n && y < m && a[x] == b[y]) {
-                ++x;
-                ++y;
-            }
+    void diff_stream_finish(DiffStreamSession* session) {
+        if (session) session->finish();
+    }
 
-            newV[k] = x;
+    // 마지막 drain 이후 확정된 row 들을 {"rows": [...]} JSON 으로 반환
+    const char* diff_stream_drain(DiffStreamSession* session) {
+        return session ? session->drain() : nullptr;
+    }
 
-            // 끝점(n, m)에 도달했으면 종료
-            if (x >= n && y >= m) {
-                finished = true;
-                finalD = d;
-                break;
-            }
-        }
+    void diff_stream_destroy(DiffStreamSession* session) {
+        delete session;
+    }
 
-        trace.push_back(newV);
-        v = newV;
+    // --------------------------------------------------------
+    // 재진입 가능한 핸들 API (diff_handle.hpp)
+    //   create -> run 반복 (결과는 result_ptr / result_size) -> release
+    //   - 서로 다른 핸들은 여러 스레드에서 동시에 실행해도 됨
+    //   - 결과 포인터는 같은 핸들의 다음 run / release 전까지 유효
+    //   - length < 0 이면 '\0' 으로 끝나는 문자열로 보고 길이를 잰다
+    // --------------------------------------------------------
+    DiffHandle* diff_create(int algorithm, int flags) {
+        return new DiffHandle(currentOptions(algorithm, flags));
+    }
+
+    // 결과 JSON 의 길이(바이트)를 반환. handle 이 없으면 -1
+    int diff_run(DiffHandle* handle, const char* baseText, int baseLength, const char* changedText,
+                 int changedLength) {
+        if (!handle) return -1;
+        auto view = [](const char* text, int length) {
+            if (!text) return string_view();
+            return length < 0 ? string_view(text) : string_view(text, static_cast<size_t>(length));
+        };
+        return static_cast<int>(handle->run(view(baseText, baseLength), view(changedText, changedLength)));
+    }
 
-        if (finished) break;
+    const char* diff_result_ptr(const DiffHandle* handle) {
+        return handle ? handle->result() : nullptr;
     }
 
-    // ---------- 역추적(backtracking) ----------
-    int x = n;
-    int y = m;
-    vector<Edit> edits;
+    int diff_result_size(const DiffHandle* handle) {
+        return handle ? static_cast<int>(handle->resultSize()) : 0;
+    }
 
-    for (int d = finalD; d > 0; --d) {
-        const auto& vPrev = trace[d - 1];
+    // 마지막 run 이 예산 때문에 탐색을 줄였으면 DIFF_DEGRADED_* 비트 (1 = cost, 2 = memory, 4 = time)
+    int diff_result_degraded(const DiffHandle* handle) {
+        return handle ? static_cast<int>(handle->degraded()) : 0;
+    }
 
-        int k = x - y;
-        int vPrevKm1 = getOrDefault(vPrev, k - 1, -1);
-        int vPrevKp1 = getOrDefault(vPrev, k + 1, -1);
+    void diff_release(DiffHandle* handle) {
+        delete handle;
+    }
 
-        int prevK;
-        if (k == -d || (k != d && vPrevKm1 < vPrevKp1)) {
-            // 아래에서 올라옴 (삽입)
-            prevK = k + 1;
-        } else {
-            // 오른쪽에서 옴 (삭제)
-            prevK = k - 1;
+    // --------------------------------------------------------
+    // 기준 파일 인덱스 (base_index.hpp): 기준 하나를 여러 비교 텍스트와 비교
+    //   index_create -> index_run / index_run_batch 반복 (결과는 index_result_ptr / size)
+    //   -> index_release
+    //   - 기준 텍스트는 복사해 두므로 create 뒤에 버퍼를 다시 써도 됨
+    //   - 결과 포인터는 같은 인덱스의 다음 run / release 전까지 유효
+    //   - length < 0 이면 '\0' 으로 끝나는 문자열로 보고 길이를 잰다
+    // --------------------------------------------------------
+    BaseIndex* diff_index_create(const char* baseText, int baseLength, int algorithm, int flags) {
+        string_view base;
+        if (baseText) {
+            base = baseLength < 0 ? string_view(baseText) : string_view(baseText, static_cast<size_t>(baseLength));
         }
+        return new BaseIndex(base, currentOptions(algorithm, flags));
+    }
 
-        int xStart = getOrDefault(vPrev, prevK, 0);
-        int yStart = xStart - prevK;
+    // 결과 JSON 의 길이(바이트)를 반환. index 가 없으면 -1
+    int diff_index_run(BaseIndex* index, const char* text, int length) {
+        if (!index) return -1;
+        string_view compare;
+        if (text) compare = length < 0 ? string_view(text) : string_view(text, static_cast<size_t>(length));
+        index->run(compare);
+        return static_cast<int>(index->resultSize(0));
+    }
 
-        // 뱀 구간: 같은 줄들
-        while (x > xStart && y > yStart) {
-            --x;
-            --y;
-            edits.push_back({' ', a[x]});
+    // texts[i] / lengths[i] 번째 비교 텍스트 count 개를 한 번에 처리 (lengths 가 없으면 '\0' 기준)
+    // 결과 수를 반환. index 가 없으면 -1
+    int diff_index_run_batch(BaseIndex* index, const char* const* texts, const int* lengths, int count) {
+        if (!index || count < 0 || (count > 0 && !texts)) return -1;
+        vector<string_view> compares(static_cast<size_t>(count));
+        for (int i = 0; i < count; ++i) {
+            if (!texts[i]) continue;
+            int length = lengths ? lengths[i] : -1;
+            compares[i] = length < 0 ? string_view(texts[i]) : string_view(texts[i], static_cast<size_t>(length));
         }
+        return static_cast<int>(index->run(compares));
+    }
 
-        // 한 칸짜리 편집(삭제 또는 삽입)
-        if (xStart < x) {
-            --x;
-            edits.push_back({'-', a[x]}); // 삭제
-        } else if (yStart < y) {
-            --y;
-            edits.push_back({'+', b[y]}); // 삽입
-        }
+    const char* diff_index_result_ptr(const BaseIndex* index, int i) {
+        return (index && i >= 0) ? index->result(static_cast<size_t>(i)) : nullptr;
     }
 
-    // 앞부분에 남은 같은 줄들
-    while (x > 0 && y > 0) {
-        --x;
-        --y;
-        edits.push_back({' ', a[x]});
+    int diff_index_result_size(const BaseIndex* index, int i) {
+        return (index && i >= 0) ? static_cast<int>(index->resultSize(static_cast<size_t>(i))) : 0;
     }
 
-    reverse(edits.begin(), edits.end());
-    return edits;
-}
+    // 기억해 둔 결과를 그대로 돌려준 횟수 (누적)
+    int diff_index_memo_hits(const BaseIndex* index) {
+        return index ? static_cast<int>(index->memoHits()) : 0;
+    }
 
-// ------------------------------------------------------------
-// JSON 문자열에서 필요한 문자들을 이스케이프
-//   - "  -> \"
-//   - \  -> \\
-//   - 줄바꿈, 탭 등은 \n, \t 등으로 변환
-// ------------------------------------------------------------
-string escapeJson(const string& s) {
-    string out;
-    out.reserve(s.size());
-
-    for (char c : s) {
-        switch (c) {
-            case '\"': out += "\\\""; break;
-            case '\\': out += "\\\\"; break;
-            case '\b': out += "\\b"; break;
-            case '\f': out += "\\f"; break;
-            case '\n': out += "\\n"; break;
-            case '\r': out += "\\r"; break;
-            case '\t': out += "\\t"; break;
-            default:
-                out += c;
-                break;
-        }
+    void diff_index_release(BaseIndex* index) {
+        delete index;
     }
-    return out;
-}
 
-// ------------------------------------------------------------
-// 공백(스페이스) 기준으로 "단어"들을 잘라내는 함수
-//   "Second Modified" -> ["Second", "Modified"]
-// ------------------------------------------------------------
-vector<string> splitWordsBySpace(const string& line) {
-    vector<string> result;
-    string word;
-
-    for (char c : line) {
-        if (c == ' ') {
-            if (!word.empty()) {
-                result.push_back(word);
-                word.clear();
-            }
-        } else {
-            word.push_back(c);
-        }
+    // --------------------------------------------------------
+    // 필요한 부분만 꺼내 보는 결과 (lazy_result.hpp)
+    //   lazy_create -> lazy_row_count / lazy_ops 로 전체 모양 확인
+    //   -> lazy_rows(begin, end) 로 보이는 구간만 JSON (결과는 lazy_rows_ptr) -> lazy_release
+    //   - 두 입력은 복사해 두므로 create 뒤에 버퍼를 다시 써도 됨
+    //   - lazy_rows_ptr 는 같은 결과의 다음 lazy_rows / release 전까지 유효
+    //   - length < 0 이면 '\0' 으로 끝나는 문자열로 보고 길이를 잰다
+    // --------------------------------------------------------
+    LazyDiffResult* diff_lazy_create(const char* baseText, int baseLength, const char* changedText, int changedLength,
+                                     int algorithm, int flags) {
+        auto view = [](const char* text, int length) {
+            if (!text) return string_view();
+            return length < 0 ? string_view(text) : string_view(text, static_cast<size_t>(length));
+        };
+        return new LazyDiffResult(view(baseText, baseLength), view(changedText, changedLength),
+                                  currentOptions(algorithm, flags));
     }
 
-    if (!word.empty()) {
-        result.push_back(word);
+    int diff_lazy_row_count(const LazyDiffResult* result) {
+        return result ? static_cast<int>(result->rowCount()) : 0;
     }
-    return result;
-}
 
-// 단어 단위 정렬 정보를 담는 구조체
-struct AlignedToken {
-    string left;   // 기준 텍스트쪽 단어 (없으면 "")
-    string right;  // 변경 텍스트쪽 단어 (없으면 "")
-    char op;       // 'M' = match(equal), 'D' = delete(left만), 'I' = insert(right만)
-};
+    // row 별 op 배열 (row_count 바이트, 0 = equal, 1 = delete, 2 = insert, 3 = replace)
+    const uint8_t* diff_lazy_ops(const LazyDiffResult* result) {
+        return result ? result->ops() : nullptr;
+    }
 
-// ------------------------------------------------------------
-// 한 줄(oldLine, newLine)에 대해 "단어 단위 diff" 를 계산해서
-// JSON 배열 형태의 문자열을 만드는 함수
-//
-// 예)
-//   oldLine = "Second"
-//   newLine = "Second Modified"
-// -> tokens:
-//   [
-//     {"op":"equal",  "left":"Second", "right":"Second"},
-//     {"op":"insert", "left":"",       "right":"Modified"}
-//   ]
-// ------------------------------------------------------------
-string makeWordTokensJSON(const string& oldLine, const string& newLine) {
-    vector<string> a = splitWordsBySpace(oldLine);
-    vector<string> b = splitWordsBySpace(newLine);
-
-    int n = static_cast<int>(a.size());
-    int m = static_cast<int>(b.size());
-
-    // LCS DP: dp[i][j] = a[0..i-1], b[0..j-1] 의 최장 공통 부분 수열 길이
-    vector<vector<int>> dp(n + 1, vector<int>(m + 1, 0));
-
-    for (int i = 1; i <= n; ++i) {
-        for (int j = 1; j <= m; ++j) {
-            if (a[i - 1] == b[j - 1]) {
-                dp[i][j] = dp[i - 1][j - 1] + 1;
-            } else {
-                dp[i][j] = (dp[i - 1][j] > dp[i][j - 1]) ? dp[i - 1][j] : dp[i][j - 1];
-            }
-        }
+    // [begin, end) 번 row 의 JSON 길이(바이트)를 반환. result 가 없으면 -1
+    int diff_lazy_rows(LazyDiffResult* result, int begin, int end) {
+        if (!result || begin < 0 || end < begin) return -1;
+        return static_cast<int>(result->range(static_cast<size_t>(begin), static_cast<size_t>(end)));
     }
 
-    // backtrack 하면서 정렬된 토큰 시퀀스 만들기
-    int i = n;
-    int j = m;
-    vector<AlignedToken> revTokens;
-
-    while (i > 0 || j > 0) {
-        if (i > 0 && j > 0 && a[i - 1] == b[j - 1]) {
-            // 같은 단어
-            revTokens.push_back({a[i - 1], b[j - 1], 'M'});
-            --i; --j;
-        } else if (j > 0 && (i == 0 || dp[i][j - 1] >= dp[i - 1][j])) {
-            // 오른쪽(새 텍스트)에만 있는 단어 (삽입)
-            revTokens.push_back({"", b[j - 1], 'I'});
-            --j;
-        } else if (i > 0) {
-            // 왼쪽(기준 텍스트)에만 있는 단어 (삭제)
-            revTokens.push_back({a[i - 1], "", 'D'});
-            --i;
-        }
+    const char* diff_lazy_rows_ptr(const LazyDiffResult* result) {
+        return result ? result->rangeResult() : nullptr;
     }
 
-    reverse(revTokens.begin(), revTokens.end());
+    // 예산 때문에 탐색을 줄였으면 DIFF_DEGRADED_* 비트
+    int diff_lazy_degraded(const LazyDiffResult* result) {
+        return result ? static_cast<int>(result->degraded()) : 0;
+    }
 
-    // JSON 배열 만들기
-    string json = "[";
-    bool first = true;
-    for (const auto& t : revTokens) {
-        if (!first) json += ",";
-        first = false;
+    void diff_lazy_release(LazyDiffResult* result) {
+        delete result;
+    }
 
-        string opStr;
-        if (t.op == 'M') opStr = "equal";
-        else if (t.op == 'D') opStr = "delete";
-        else opStr = "insert";
+    // --------------------------------------------------------
+    // 작은 편집 뒤의 증분 diff (incremental_diff.hpp)
+    //   incremental_create -> incremental_rows 로 처음 전체 row (결과는 incremental_result_ptr)
+    //   -> 편집마다 incremental_edit 로 바뀐 row 만 받음 -> incremental_release
+    //   - side: 0 = 기준, 1 = 변경. [lineStart, lineEnd) 줄을 text 의 줄로 바꿈
+    //     (text 는 파일과 같은 규칙: 빈 문자열 = 줄 없음, 끝의 '\n' 하나는 줄 끝)
+    //   - 두 입력과 편집 텍스트는 복사해 두므로 호출 뒤에 버퍼를 다시 써도 됨
+    //   - incremental_result_ptr 는 같은 handle 의 다음 rows / edit / release 전까지 유효
+    //   - length < 0 이면 '\0' 으로 끝나는 문자열로 보고 길이를 잰다
+    // --------------------------------------------------------
+    IncrementalDiff* diff_incremental_create(const char* baseText, int baseLength, const char* changedText,
+                                             int changedLength, int algorithm, int flags) {
+        auto view = [](const char* text, int length) {
+            if (!text) return string_view();
+            return length < 0 ? string_view(text) : string_view(text, static_cast<size_t>(length));
+        };
+        return new IncrementalDiff(view(baseText, baseLength), view(changedText, changedLength),
+                                   currentOptions(algorithm, flags));
+    }
 
-        json += "{";
-        json += "\"op\":\"" + opStr + "\",";
-        json += "\"left\":\"" + escapeJson(t.left) + "\",";
-        json += "\"right\":\"" + escapeJson(t.right) + "\"";
-        json += "}";
+    // 전체 row 의 JSON 길이(바이트)를 반환. diff 가 없으면 -1
+    int diff_incremental_rows(IncrementalDiff* diff) {
+        return diff ? static_cast<int>(diff->full()) : -1;
     }
-    json += "]";
-    return json;
-}
 
-// ------------------------------------------------------------
-// 실제 diff 로직: baseText / changedText 를 받아 JSON 문자열 생성
-// ------------------------------------------------------------
-const char* diff_text_impl(const char* baseText, const char* changedText) {
-    // 1) C 문자열을 줄 벡터로 변환
-    vector<string> baseLines    = splitLines(baseText);
-    vector<string> changedLines = splitLines(changedText);
-
-    // 2) Myers 알고리즘으로 줄 단위 diff
-    vector<Edit> edits = myersDiff(baseLines, changedLines);
-
-    // 3) JSON 문자열 만들기
-    //    static 으로 만들어야, 함수가 끝난 뒤에도 포인터가 유효함
-    static string result;
-    result.clear();
-
-    result += "{\n  \"rows\": [\n";
-
-    bool firstRow = true;
-
-    for (size_t i = 0; i < edits.size(); ++i) {
-        const Edit& e = edits[i];
-
-        string opName;     // "equal", "delete", "insert", "replace"
-        string leftText;   // 기준 텍스트 한 줄
-        string rightText;  // 변경 텍스트 한 줄
-        bool hasTokens = false;
-        string tokensJson;
-
-        if (e.op == ' ') {
-            // 공통 줄
-            opName   = "equal";
-            leftText = e.text;
-            rightText = e.text;
-        } else if (e.op == '-') {
-            // 연속된 delete 블록과 insert 블록의 개수를 세기
-            size_t deleteStart = i;
-            size_t deleteCount = 0;
-            while (i < edits.size() && edits[i].op == '-') {
-                deleteCount++;
-                i++;
-            }
+    // 바뀐 row 의 JSON 길이(바이트)를 반환. diff 가 없거나 side / 줄 범위가 틀리면 -1
+    //   {"row": 첫 row, "removed": 지울 row 수, "start": [기준 줄, 변경 줄], "rows": [...]}
+    int diff_incremental_edit(IncrementalDiff* diff, int side, int lineStart, int lineEnd, const char* text,
+                              int length) {
+        if (!diff || lineStart < 0 || lineEnd < lineStart) return -1;
+        string_view edit;
+        if (text) edit = length < 0 ? string_view(text) : string_view(text, static_cast<size_t>(length));
+        size_t size = diff->edit(side, static_cast<size_t>(lineStart), static_cast<size_t>(lineEnd), edit);
+        return size ? static_cast<int>(size) : -1;
+    }
 
-            // insert 블록의 개수 세기 (실제로 소비하지는 않음)
-            size_t insertStart = i;
-            size_t insertCount = 0;
-            while (i < edits.size() && edits[i].op == '+') {
-                insertCount++;
-                i++;
-            }
+    const char* diff_incremental_result_ptr(const IncrementalDiff* diff) {
+        return diff ? diff->result() : nullptr;
+    }
 
-            // delete와 insert 개수가 같으면 1:1 매칭하여 replace로 처리
-            if (deleteCount == insertCount && deleteCount > 0) {
-                for (size_t j = 0; j < deleteCount; j++) {
-                    if (!firstRow) {
-                        result += ",\n";
-                    }
-                    firstRow = false;
-
-                    opName = "replace";
-                    leftText = edits[deleteStart + j].text;
-                    rightText = edits[insertStart + j].text;
-
-                    // 띄어쓰기 기준 단어 단위 diff
-                    tokensJson = makeWordTokensJSON(leftText, rightText);
-                    hasTokens = true;
-
-                    string leftEsc  = escapeJson(leftText);
-                    string rightEsc = escapeJson(rightText);
-
-                    result += "    {";
-                    result += "\"op\":\"" + opName + "\",";
-                    result += "\"left\":\"" + leftEsc + "\",";
-                    result += "\"right\":\"" + rightEsc + "\"";
-                    result += ",\"tokens\":" + tokensJson;
-                    result += "}";
-                }
-
-                // 이미 모든 delete와 insert를 처리했으므로 continue
-                i--; // for문에서 ++i 되므로 1 빼기
-                continue;
-            } else {
-                // 개수가 다르면 원래대로 delete로 처리
-                // delete 블록 먼저 출력
-                for (size_t j = 0; j < deleteCount; j++) {
-                    if (!firstRow) {
-                        result += ",\n";
-                    }
-                    firstRow = false;
-
-                    opName = "delete";
-                    leftText = edits[deleteStart + j].text;
-                    rightText = "";
-
-                    string leftEsc  = escapeJson(leftText);
-                    string rightEsc = escapeJson(rightText);
-
-                    result += "    {";
-                    result += "\"op\":\"" + opName + "\",";
-                    result += "\"left\":\"" + leftEsc + "\",";
-                    result += "\"right\":\"" + rightEsc + "\"";
-                    result += "}";
-                }
-
-                // insert 블록 출력
-                for (size_t j = 0; j < insertCount; j++) {
-                    if (!firstRow) {
-                        result += ",\n";
-                    }
-                    firstRow = false;
-
-                    opName = "insert";
-                    leftText = "";
-                    rightText = edits[insertStart + j].text;
-
-                    string leftEsc  = escapeJson(leftText);
-                    string rightEsc = escapeJson(rightText);
-
-                    result += "    {";
-                    result += "\"op\":\"" + opName + "\",";
-                    result += "\"left\":\"" + leftEsc + "\",";
-                    result += "\"right\":\"" + rightEsc + "\"";
-                    result += "}";
-                }
-
-                i--; // for문에서 ++i 되므로 1 빼기
-                continue;
-            }
-        } else if (e.op == '+') {
-            // 추가된 줄 (단독으로 나타난 경우, 앞의 delete 블록에서 처리 안 된 경우)
-            opName   = "insert";
-            leftText = "";
-            rightText = e.text;
-        }
+    int diff_incremental_row_count(const IncrementalDiff* diff) {
+        return diff ? static_cast<int>(diff->rowCount()) : 0;
+    }
 
-        if (!firstRow) {
-            result += ",\n";
-        }
-        firstRow = false;
+    void diff_incremental_release(IncrementalDiff* diff) {
+        delete diff;
+    }
 
-        string leftEsc  = escapeJson(leftText);
-        string rightEsc = escapeJson(rightText);
+    // --------------------------------------------------------
+    // 바이너리 델타 (delta_patch.hpp): 스냅샷을 이전 스냅샷과의 차이로 저장 / 복원
+    //   delta_encode -> delta_ptr 의 바이트를 저장, 나중에 delta_apply -> delta_target_ptr
+    //   - flags: DELTA_FLAG_VARINT (1) 이면 varint 로 줄인 op, 0 이면 고정 폭
+    //   - 결과 포인터는 같은 스레드의 다음 delta_encode / delta_apply 전까지 유효
+    //   - length < 0 이면 '\0' 으로 끝나는 문자열로 보고 길이를 잰다
+    // --------------------------------------------------------
+    // 델타 길이(바이트)를 반환
+    int diff_delta_encode(const char* baseText, int baseLength, const char* targetText, int targetLength,
+                          int flags) {
+        auto view = [](const char* text, int length) {
+            if (!text) return string_view();
+            return length < 0 ? string_view(text) : string_view(text, static_cast<size_t>(length));
+        };
+        const vector<uint8_t>& delta = deltaEncoder.encode(view(baseText, baseLength), view(targetText, targetLength),
+                                                           static_cast<uint32_t>(flags), currentOptions(0, 0));
+        return static_cast<int>(delta.size());
+    }
 
-        // 한 줄(row)을 JSON 객체로 추가
-        result += "    {";
-        result += "\"op\":\"" + opName + "\",";
-        result += "\"left\":\"" + leftEsc + "\",";
-        result += "\"right\":\"" + rightEsc + "\"";
+    const uint8_t* diff_delta_ptr() {
+        return deltaEncoder.result().data();
+    }
 
-        // replace 인 경우에만 단어 단위 토큰 정보 추가
-        if (hasTokens) {
-            result += ",\"tokens\":" + tokensJson;
+    // 복원한 대상 길이(바이트)를 반환. 실패하면 -DeltaStatus (-1 헤더, -2 다른 기준, -3 손상, -4 검사 값)
+    int diff_delta_apply(const char* baseText, int baseLength, const uint8_t* delta, int deltaLength) {
+        string_view base;
+        if (baseText) {
+            base = baseLength < 0 ? string_view(baseText) : string_view(baseText, static_cast<size_t>(baseLength));
         }
-
-        result += "}";
+        size_t length = (delta && deltaLength > 0) ? static_cast<size_t>(deltaLength) : 0;
+        DeltaStatus status = applyDelta(base, delta, length, deltaTarget);
+        if (status != DeltaStatus::Ok) return -static_cast<int>(status);
+        return static_cast<int>(deltaTarget.size());
     }
 
-    result += "\n  ]\n}";
-
-    // result.c_str() 는 static string 이라 diff_text_impl 이 끝나도 유효
-    return result.c_str();
-}
+    const char* diff_delta_target_ptr() {
+        return deltaTarget.c_str();
+    }
 
-// ------------------------------------------------------------
-// WASM에서 호출할 함수 (C 스타일 이름)
-//   - 실제 로직은 diff_text_impl 에 있음
-// ------------------------------------------------------------
-extern "C" {
-    const char* diff_text(const char* baseText, const char* changedText) {
-        return diff_text_impl(baseText, changedText);
+    // --------------------------------------------------------
+    // 마지막 diff_text / diff_text_ex / diff_text_binary / diff_run 호출의 단계별 측정 값
+    //   (구조체 형식은 diff_stats.hpp, DIFF_STATS 없이 빌드하면 enabled = 0)
+    //   측정 값은 프로세스에 하나뿐이므로 여러 스레드가 동시에 실행하면 섞인다
+    // --------------------------------------------------------
+    const DiffStats* diff_get_stats() {
+        static DiffStats stats;
+        stats = diffStatsSnapshot();
+        return &stats;
     }
 }
 
 // ------------------------------------------------------------
-// 테스트용 main (네이티브에서 실행 시)
-//   WASM 빌드할 때는 이 main 은 빼고 컴파일하면 됨
+// 예제 입력으로 결과를 확인하는 데모 (네이티브에서는 `diff --demo`)
 // ------------------------------------------------------------
-int main() {
+int runDemo() {
     printf("===== Test 1: Simple Addition =====\n");
     const char* base1 = "Hello\nWorld";
     const char* changed1 = "Hello\nHappy\nWorld";
@@ -613,5 +566,62 @@ int main() {
         p++;
     }
 
+    printf("\n===== Test 7: Algorithms vs Myers =====\n");
+    const char* cases[][2] = {
+        {base1, changed1}, {base2, changed2}, {base3, changed3},
+        {base4, changed4}, {base5, changed5}, {base6, changed6},
+    };
+    for (size_t t = 0; t < sizeof(cases) / sizeof(cases[0]); ++t) {
+        // diff_text_impl 은 static string 을 돌려주므로 먼저 복사해 둔다
+        string classic = diff_text_impl(cases[t][0], cases[t][1]);
+        printf("Test %zu:", t + 1);
+        const pair<const char*, DiffAlgorithm> others[] = {
+            {"linear", DiffAlgorithm::MyersLinear},
+            {"patience", DiffAlgorithm::Patience},
+            {"histogram", DiffAlgorithm::Histogram},
+        };
+        for (const auto& [name, algorithm] : others) {
+            DiffOptions options;
+            options.algorithm = algorithm;
+            string other = diff_text_impl(cases[t][0], cases[t][1], options);
+            printf(" %s=%s", name, classic == other ? "same" : "different");
+        }
+        printf("\n");
+    }
+
+    printf("\n===== Test 8: Delta Round Trip =====\n");
+    DeltaEncoder encoder;
+    vector<uint8_t> delta = encoder.encode(base6, changed6, DELTA_FLAG_VARINT);
+    string rebuilt;
+    DeltaStatus status = applyDelta(base6, delta.data(), delta.size(), rebuilt);
+    printf("apply: %s, same=%s\n", deltaStatusName(status), rebuilt == changed6 ? "yes" : "no");
+
+    // 헤더의 대상 길이(16 바이트부터 u64)에서 비트 하나가 깨지면 256 GB 를 요청하게 됨
+    vector<uint8_t> corrupt = delta;
+    corrupt[20] ^= 0x40;
+    status = applyDelta(base6, corrupt.data(), corrupt.size(), rebuilt);
+    printf("corrupt target length: %s\n", deltaStatusName(status));
+
     return 0;
 }
+
+// ------------------------------------------------------------
+// main
+//   - 네이티브: 파일 두 개를 비교하는 CLI (cli.hpp), --demo 면 데모
+//   - WASM    : 기존처럼 데모 실행
+//   - DIFF_NO_MAIN 을 정의하면 main 없이 컴파일 (다른 실행 파일에서 include 할 때)
+// ------------------------------------------------------------
+#ifndef DIFF_NO_MAIN
+#ifdef __EMSCRIPTEN__
+int main() {
+    return runDemo();
+}
+#else
+int main(int argc, char** argv) {
+    if (argc == 2 && strcmp(argv[1], "--demo") == 0) {
+        return runDemo();
+    }
+    return runCli(argc, argv);
+}
+#endif
+#endif
@@ -0,0 +1,111 @@
+// ------------------------------------------------------------
+// 읽기 전용 메모리 맵 파일
+// ------------------------------------------------------------
+// 네이티브 CLI 에서 입력 파일을 복사하지 않고 그대로 string_view 로 다루기 위해 사용.
+//   - POSIX : mmap(PROT_READ, MAP_PRIVATE)
+//   - 그 외 : 파일 전체를 버퍼로 읽어 오는 방식으로 대체
+// 빈 파일은 매핑하지 않고 빈 view 를 돌려준다.
+// ------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define DIFF_HAS_MMAP 1
+#endif
+
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            mapped_ = std::exchange(other.mapped_, false);
+            buffer_ = std::move(other.buffer_);
+        }
+        return *this;
+    }
+
+    ~MappedFile() { close(); }
+
+    // 파일 열기. 실패하면 false 와 함께 error 에 이유를 남김
+    bool open(const char* path, std::string& error) {
+        close();
+#ifdef DIFF_HAS_MMAP
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) {
+            error = std::string(path) + ": cannot open file";
+            return false;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            ::close(fd);
+            error = std::string(path) + ": cannot stat file";
+            return false;
+        }
+        size_ = static_cast<size_t>(info.st_size);
+        if (size_ > 0) {
+            void* p = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                size_ = 0;
+                error = std::string(path) + ": mmap failed";
+                return false;
+            }
+            madvise(p, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(p);
+            mapped_ = true;
+        }
+        ::close(fd);
+        return true;
+#else
+        FILE* file = std::fopen(path, "rb");
+        if (!file) {
+            error = std::string(path) + ": cannot open file";
+            return false;
+        }
+        char chunk[1 << 16];
+        size_t read;
+        while ((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+            buffer_.insert(buffer_.end(), chunk, chunk + read);
+        }
+        std::fclose(file);
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+        return true;
+#endif
+    }
+
+    std::string_view view() const { return std::string_view(data_ ? data_ : "", size_); }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    bool mapped_ = false;
+    std::vector<char> buffer_;  // mmap 이 없는 환경에서 사용
+
+    void close() {
+#ifdef DIFF_HAS_MMAP
+        if (mapped_) munmap(const_cast<char*>(data_), size_);
+#endif
+        data_ = nullptr;
+        size_ = 0;
+        mapped_ = false;
+        buffer_.clear();
+    }
+};
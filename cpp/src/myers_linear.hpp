@@ -0,0 +1,288 @@
+// ------------------------------------------------------------
+// 선형 공간(linear-space) Myers 알고리즘
+// ------------------------------------------------------------
+// 기존 myersDiff 는 D 마다 V 전체(unordered_map)를 trace 에 복사해 두기 때문에
+// 메모리가 O(D^2) 로 늘어난다. 여기서는
+//   - V 를 "k + offset" 으로 인덱싱하는 연속 배열(vector<int>)로 두고
+//   - 앞/뒤에서 동시에 탐색해 middle snake 를 찾은 뒤
+//   - 그 snake 를 기준으로 좌/우 구간을 다시 나누는(Hirschberg 방식, 재귀 대신 작업 스택)
+// 방법으로 O(N + M) 메모리만 사용한다.
+//
+// 결과는 원본 줄 번호만 담은 인덱스 기반 편집 스크립트(IndexedEdit)이다.
+//
+// BudgetState(diff_budget.hpp)를 넘기면 탐색 비용을 제한한다.
+//   - D 가 maxCost 를 넘으면 앞/뒤 경로 중 가장 멀리 간 끝점에서 구간을 나눔
+//   - 시간 / 메모리가 바닥나면 남은 구간은 삭제 + 추가로 처리
+// ------------------------------------------------------------
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "diff_budget.hpp"
+#include "diff_stats.hpp"
+#include "edit_script.hpp"
+
+// middle snake 탐색 결과: (x, y) -> (u, v) 가 대각선으로 같은 구간
+struct MiddleSnake {
+    int x;
+    int y;
+    int u;
+    int v;
+};
+
+// ------------------------------------------------------------
+// 선형 공간 Myers 탐색기
+//   Seq 는 operator[] 와 == 비교가 가능한 임의 접근 시퀀스
+// ------------------------------------------------------------
+template <typename Seq>
+class LinearMyers {
+public:
+    LinearMyers(const Seq& a, int n, const Seq& b, int m, BudgetState* budget = nullptr)
+        : a_(a), b_(b), n_(n), m_(m), budget_(budget) {
+        // 앞/뒤 V 배열은 한 번만 할당하고 모든 구간에서 재사용
+        int maxD = (n + m + 1) / 2 + 1;
+        size_t size = static_cast<size_t>(2 * maxD + 2);
+        if (budget_ && !budget_->reserve(2 * size * sizeof(int))) {
+            return;  // V 배열 없이: diffRange 가 전부 삭제 + 추가로 처리
+        }
+        offset_ = maxD;
+        forwardV_.assign(size, 0);
+        backwardV_.assign(size, 0);
+    }
+
+    ~LinearMyers() {
+        if (budget_) budget_->release((forwardV_.size() + backwardV_.size()) * sizeof(int));
+    }
+
+    LinearMyers(const LinearMyers&) = delete;
+    LinearMyers& operator=(const LinearMyers&) = delete;
+
+    std::vector<IndexedEdit> run() {
+        edits_.clear();
+        edits_.reserve(static_cast<size_t>(n_ > m_ ? n_ : m_));
+        diffRange(0, n_, 0, m_);
+        groupChanges();
+        return std::move(edits_);
+    }
+
+    // 이미 구한 (aLo, bLo) 까지의 편집 스크립트 뒤에 나머지 a[aLo, n), b[bLo, m) 을 이어 붙임
+    //   기존 myersDiff 가 예산을 다 써서 중간에 멈췄을 때 남은 부분을 맡긴다
+    std::vector<IndexedEdit> runFrom(std::vector<IndexedEdit> prefix, int aLo, int bLo) {
+        edits_ = std::move(prefix);
+        diffRange(aLo, n_, bLo, m_);
+        groupChanges();
+        return std::move(edits_);
+    }
+
+private:
+    const Seq& a_;
+    const Seq& b_;
+    int n_;
+    int m_;
+    BudgetState* budget_;
+    int offset_ = 0;
+    std::vector<int> forwardV_;
+    std::vector<int> backwardV_;
+    std::vector<IndexedEdit> edits_;
+
+    // 아직 처리하지 않은 구간 / 같은 줄 묶음
+    //   재귀 대신 직접 쌓으므로 (예산 때문에 구간을 조금씩만 줄여 나가도) 호출 스택이 깊어지지 않음
+    struct RangeTask {
+        int aLo;
+        int aHi;
+        int bLo;
+        int bHi;
+        bool equal;  // true 면 (aLo, bLo) 부터 aHi - aLo 쌍을 같은 줄로 추가
+    };
+    std::vector<RangeTask> tasks_;
+
+    // --------------------------------------------------------
+    // a[aLo, aHi) 와 b[bLo, bHi) 의 차이를 edits_ 뒤에 순서대로 추가
+    //   뒤에 나올 것부터 tasks_ 에 쌓아 앞 구간부터 꺼냄
+    // --------------------------------------------------------
+    void diffRange(int aLo, int aHi, int bLo, int bHi) {
+        tasks_.push_back({aLo, aHi, bLo, bHi, false});
+        while (!tasks_.empty()) {
+            RangeTask task = tasks_.back();
+            tasks_.pop_back();
+            if (task.equal) {
+                for (int x = task.aLo, y = task.bLo; x < task.aHi; ++x, ++y) {
+                    edits_.push_back({' ', x, y});
+                }
+            } else {
+                splitRange(task.aLo, task.aHi, task.bLo, task.bHi);
+            }
+        }
+    }
+
+    // 구간 하나: 바로 정해지는 편집은 edits_ 에 넣고, 나눈 구간은 tasks_ 에 쌓음
+    void splitRange(int aLo, int aHi, int bLo, int bHi) {
+        // 앞쪽 공통 구간
+        while (aLo < aHi && bLo < bHi && a_[aLo] == b_[bLo]) {
+            edits_.push_back({' ', aLo, bLo});
+            ++aLo;
+            ++bLo;
+        }
+
+        // 뒤쪽 공통 구간 (출력은 구간 안쪽이 모두 끝난 뒤에)
+        int suffix = 0;
+        while (aHi - suffix > aLo && bHi - suffix > bLo &&
+               a_[aHi - 1 - suffix] == b_[bHi - 1 - suffix]) {
+            ++suffix;
+        }
+        aHi -= suffix;
+        bHi -= suffix;
+        if (suffix > 0) tasks_.push_back({aHi, aHi + suffix, bHi, bHi + suffix, true});
+
+        if (aLo == aHi) {
+            for (int y = bLo; y < bHi; ++y) edits_.push_back({'+', -1, y});
+        } else if (bLo == bHi) {
+            for (int x = aLo; x < aHi; ++x) edits_.push_back({'-', x, -1});
+        } else if (forwardV_.empty() || (budget_ && budget_->exhausted())) {
+            // 예산 소진: 더 찾지 않고 구간 전체를 바꾼 것으로 처리
+            for (int x = aLo; x < aHi; ++x) edits_.push_back({'-', x, -1});
+            for (int y = bLo; y < bHi; ++y) edits_.push_back({'+', -1, y});
+        } else {
+            MiddleSnake s = findMiddleSnake(aLo, aHi, bLo, bHi);
+            tasks_.push_back({s.u, aHi, s.v, bHi, false});
+            if (s.u > s.x) tasks_.push_back({s.x, s.u, s.y, s.v, true});
+            tasks_.push_back({aLo, s.x, bLo, s.y, false});
+        }
+    }
+
+    // --------------------------------------------------------
+    // 앞(forward)과 뒤(backward)에서 동시에 D-path 를 늘려가다가
+    // 두 경로가 겹치는 대각선의 snake 를 찾는다.
+    //   forwardV_[k]  : 대각선 k 에서 앞쪽 경로가 도달한 최대 x (구간 기준)
+    //   backwardV_[k] : 뒤집은 좌표계의 대각선 k 에서 도달한 최대 x
+    // --------------------------------------------------------
+    MiddleSnake findMiddleSnake(int aLo, int aHi, int bLo, int bHi) {
+        const int n = aHi - aLo;
+        const int m = bHi - bLo;
+        const int delta = n - m;
+        const bool odd = (delta & 1) != 0;
+        const int maxD = (n + m + 1) / 2;
+        int* vf = forwardV_.data() + offset_;
+        int* vb = backwardV_.data() + offset_;
+
+        vf[1] = 0;
+        vb[1] = 0;
+
+        const int maxCost = budget_ ? budget_->maxCost() : 0;
+
+        for (int d = 0; d <= maxD; ++d) {
+            // 예산 초과: 지금까지(d - 1)의 가장 멀리 간 점에서 나눔 (빈 snake)
+            if (budget_ && d >= 2 && ((maxCost > 0 && d > maxCost) || budget_->exhausted())) {
+                MiddleSnake cut;
+                if (furthestSplit(aLo, aHi, bLo, bHi, d - 1, cut)) {
+                    if (maxCost > 0 && d > maxCost) budget_->degrade(DIFF_DEGRADED_COST);
+                    return cut;
+                }
+            }
+            DIFF_STATS_ADD(MyersSteps, 2 * (d + 1));
+
+            // 앞쪽 탐색
+            for (int k = -d; k <= d; k += 2) {
+                int x = (k == -d || (k != d && vf[k - 1] < vf[k + 1])) ? vf[k + 1] : vf[k - 1] + 1;
+                int y = x - k;
+                int x0 = x;
+                int y0 = y;
+                while (x < n && y < m && a_[aLo + x] == b_[bLo + y]) {
+                    ++x;
+                    ++y;
+                }
+                vf[k] = x;
+
+                int kb = delta - k;
+                if (odd && kb >= -(d - 1) && kb <= d - 1 && x + vb[kb] >= n) {
+                    return {aLo + x0, bLo + y0, aLo + x, bLo + y};
+                }
+            }
+
+            // 뒤쪽 탐색 (뒤집은 좌표계에서 같은 방식으로 진행)
+            for (int k = -d; k <= d; k += 2) {
+                int x = (k == -d || (k != d && vb[k - 1] < vb[k + 1])) ? vb[k + 1] : vb[k - 1] + 1;
+                int y = x - k;
+                int x0 = x;
+                int y0 = y;
+                while (x < n && y < m && a_[aHi - 1 - x] == b_[bHi - 1 - y]) {
+                    ++x;
+                    ++y;
+                }
+                vb[k] = x;
+
+                int kf = delta - k;
+                if (!odd && kf >= -d && kf <= d && x + vf[kf] >= n) {
+                    return {aHi - x, bHi - y, aHi - x0, bHi - y0};
+                }
+            }
+        }
+
+        // 도달할 수 없음 (D <= maxD 가 항상 성립)
+        return {aHi, bHi, aHi, bHi};
+    }
+
+    // --------------------------------------------------------
+    // D = d 까지의 앞/뒤 경로 끝점 중 x + y 가 가장 많이 진행된 점 (GNU diff 와 같은 기준)
+    //   구간의 시작/끝 점이면 나눠도 줄어들지 않으므로 false
+    // --------------------------------------------------------
+    bool furthestSplit(int aLo, int aHi, int bLo, int bHi, int d, MiddleSnake& cut) const {
+        const int n = aHi - aLo;
+        const int m = bHi - bLo;
+        const int* vf = forwardV_.data() + offset_;
+        const int* vb = backwardV_.data() + offset_;
+
+        int best = 0;
+        for (int k = -d; k <= d; k += 2) {
+            int x = vf[k];
+            int y = x - k;
+            if (x >= 0 && x <= n && y >= 0 && y <= m && x + y > best && x + y < n + m) {
+                best = x + y;
+                cut = {aLo + x, bLo + y, aLo + x, bLo + y};
+            }
+        }
+        for (int k = -d; k <= d; k += 2) {
+            int x = vb[k];
+            int y = x - k;
+            if (x >= 0 && x <= n && y >= 0 && y <= m && x + y > best && x + y < n + m) {
+                best = x + y;
+                cut = {aHi - x, bHi - y, aHi - x, bHi - y};
+            }
+        }
+        return best > 0;
+    }
+
+    // --------------------------------------------------------
+    // 같은 줄 사이의 변경 구간 안에서 삭제를 추가보다 먼저 오도록 정렬
+    //   기존 myersDiff 의 출력(삭제 블록 -> 추가 블록)과 같은 모양으로 맞춰
+    //   diff_text_impl 의 replace 묶음 처리가 똑같이 동작하게 한다.
+    // --------------------------------------------------------
+    void groupChanges() {
+        size_t i = 0;
+        while (i < edits_.size()) {
+            if (edits_[i].op == ' ') {
+                ++i;
+                continue;
+            }
+            size_t end = i;
+            while (end < edits_.size() && edits_[end].op != ' ') ++end;
+            std::stable_partition(edits_.begin() + i, edits_.begin() + end,
+                                  [](const IndexedEdit& e) { return e.op == '-'; });
+            i = end;
+        }
+    }
+};
+
+// ------------------------------------------------------------
+// 선형 공간 Myers 로 인덱스 기반 편집 스크립트 생성
+// ------------------------------------------------------------
+template <typename Seq>
+std::vector<IndexedEdit> myersDiffLinear(const Seq& a, int n, const Seq& b, int m, BudgetState* budget = nullptr) {
+    if (n == 0 && m == 0) {
+        return {};
+    }
+    LinearMyers<Seq> engine(a, n, b, m, budget);
+    return engine.run();
+}
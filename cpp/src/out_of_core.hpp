@@ -0,0 +1,477 @@
+// ------------------------------------------------------------
+// 메모리보다 큰 입력의 diff (out-of-core, 네이티브 CLI 의 --out-of-core)
+// ------------------------------------------------------------
+// 줄 텍스트를 메모리에 두지 않고 줄마다 (위치, 길이, 해시) 레코드만 들고 diff 한다.
+//   1) LineRecordReader : 파일을 고정 크기 블록으로 읽으며 줄 레코드를 하나씩 꺼냄
+//   2) OutOfCoreDiff    : stream_session.hpp 처럼 양쪽 창(window)에서 앵커를 찾아
+//                         그 앞까지만 diff 하고 나머지는 다음 창으로 넘김
+//                         -> 레코드와 diff 작업 공간은 창 크기만큼만 메모리에 있음
+//   3) LineFetcher      : 출력할 줄만 파일에서 다시 읽음
+//   4) SpillBuffer      : hunk 처럼 다 모아야 쓸 수 있는 레코드가 상한을 넘으면
+//                         임시 파일(std::tmpfile)로 내렸다가 순서대로 다시 읽음
+//
+// 줄 비교는 64비트 해시 + 32비트 검사 해시 + 길이로 한다 (텍스트를 다시 읽어 비교하지
+// 않음). 서로 다른 두 줄이 세 값까지 모두 같을 확률은 무시할 만하지만 0 은 아니다.
+//
+// 메모리는 OutOfCoreBudget 하나(창 줄 수, 블록 크기, SpillBuffer 상한)로 정해지고
+// 입력 크기와는 상관없다. 창 경계에서 끊기 때문에 결과는 스트리밍 세션처럼 창 안에서만
+// 최소 diff 이고, 정규화(-w 등)는 지원하지 않는다.
+// ------------------------------------------------------------
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "diff_core.hpp"
+#include "sequence_diff.hpp"
+#include "stream_session.hpp"
+
+// '\n' 없이 파일이 끝나는 마지막 줄 (같은 내용이어도 '\n' 으로 끝나는 줄과 다르게 비교)
+constexpr uint32_t LINE_RECORD_NO_NEWLINE = 1u << 0;
+
+struct LineRecord {
+    uint64_t offset = 0;  // 파일에서 줄이 시작하는 위치 (바이트)
+    uint64_t length = 0;  // '\n' 을 뺀 바이트 수
+    uint64_t hash = 0;
+    uint32_t check = 0;   // hash 와 따로 섞은 두 번째 해시
+    uint32_t flags = 0;   // LINE_RECORD_* 비트
+};
+
+// 텍스트 없이 레코드만으로 비교 (SequenceInterner 가 줄 ID 를 붙일 때 사용)
+template <>
+struct SequenceTraits<LineRecord> {
+    static uint64_t hash(const LineRecord& line) { return line.hash; }
+    static bool equal(const LineRecord& x, const LineRecord& y) {
+        return x.hash == y.hash && x.check == y.check && x.length == y.length && x.flags == y.flags;
+    }
+};
+
+// ------------------------------------------------------------
+// 블록 경계에 걸친 줄도 이어서 해시하는 누적 해시
+//   hashBytes 처럼 8바이트씩 모아 섞고, 검사 해시는 다른 상수로 따로 섞는다
+// ------------------------------------------------------------
+class LineHasher {
+public:
+    void update(const char* data, size_t length) {
+        length_ += length;
+        while (filled_ != 0 && length > 0) {
+            push(static_cast<uint8_t>(*data++));
+            --length;
+        }
+        for (; length >= 8; data += 8, length -= 8) {
+            uint64_t word;
+            std::memcpy(&word, data, 8);
+            mix(word);
+        }
+        while (length > 0) {
+            push(static_cast<uint8_t>(*data++));
+            --length;
+        }
+    }
+
+    // 지금까지 넣은 바이트를 한 줄로 마무리하고 다음 줄을 위해 초기화
+    void finish(LineRecord& record) {
+        uint64_t h = (h_ ^ (length_ * 0xff51afd7ed558ccdull) ^ word_) * 0xc4ceb9fe1a85ec53ull;
+        uint64_t g = (g_ + length_ + word_) * 0x94d049bb133111ebull;
+        record.length = length_;
+        record.hash = h ^ (h >> 29);
+        record.check = static_cast<uint32_t>((g ^ (g >> 31)) >> 32);
+        *this = LineHasher();
+    }
+
+    uint64_t length() const { return length_; }
+
+private:
+    uint64_t h_ = 0x9E3779B97F4A7C15ull;
+    uint64_t g_ = 0x2545F4914F6CDD1Dull;
+    uint64_t word_ = 0;
+    size_t filled_ = 0;
+    uint64_t length_ = 0;
+
+    void push(uint8_t c) {
+        word_ |= static_cast<uint64_t>(c) << (filled_ * 8);
+        if (++filled_ == 8) {
+            mix(word_);
+            word_ = 0;
+            filled_ = 0;
+        }
+    }
+
+    void mix(uint64_t word) {
+        h_ = (h_ ^ word) * 0xff51afd7ed558ccdull;
+        h_ ^= h_ >> 32;
+        g_ = (g_ + word) * 0xbf58476d1ce4e5b9ull;
+        g_ ^= g_ >> 27;
+    }
+};
+
+// 64비트 위치로 이동 (long 이 32비트인 플랫폼도 있으므로 fseek 대신)
+inline bool seekFile(FILE* file, uint64_t offset) {
+#if defined(_WIN32)
+    return _fseeki64(file, static_cast<__int64>(offset), SEEK_SET) == 0;
+#else
+    return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+}
+
+// 블록 단위로 직접 읽으므로 stdio 버퍼는 끔
+inline FILE* openBlockFile(const char* path, std::string& error) {
+    FILE* file = std::fopen(path, "rb");
+    if (!file) {
+        error = std::string(path) + ": cannot open file";
+        return nullptr;
+    }
+    std::setvbuf(file, nullptr, _IONBF, 0);
+    return file;
+}
+
+// ------------------------------------------------------------
+// 파일을 블록 단위로 읽으며 줄 레코드를 하나씩 꺼냄
+//   줄 나누기는 cli.hpp 의 splitFileLines 와 같다 (파일 끝 '\n' 뒤 빈 조각은 줄이 아님)
+// ------------------------------------------------------------
+class LineRecordReader {
+public:
+    LineRecordReader() = default;
+    LineRecordReader(const LineRecordReader&) = delete;
+    LineRecordReader& operator=(const LineRecordReader&) = delete;
+    ~LineRecordReader() {
+        if (file_) std::fclose(file_);
+    }
+
+    bool open(const char* path, size_t blockBytes, std::string& error) {
+        path_ = path;
+        file_ = openBlockFile(path, error);
+        block_.resize(blockBytes);
+        return file_ != nullptr;
+    }
+
+    // 다음 줄 (파일 끝이거나 읽기 오류면 false, 오류는 failed())
+    bool next(LineRecord& record) {
+        record.offset = lineStart_;
+        record.flags = 0;
+        while (true) {
+            if (pos_ == end_ && !refill()) {
+                if (hasher_.length() == 0) return false;
+                hasher_.finish(record);
+                record.flags = LINE_RECORD_NO_NEWLINE;
+                lineStart_ += record.length;
+                return true;
+            }
+            const char* begin = block_.data() + pos_;
+            const char* newline = static_cast<const char*>(std::memchr(begin, '\n', end_ - pos_));
+            if (newline) {
+                hasher_.update(begin, static_cast<size_t>(newline - begin));
+                hasher_.finish(record);
+                pos_ += static_cast<size_t>(newline - begin) + 1;
+                lineStart_ = blockOffset_ + pos_;
+                return true;
+            }
+            hasher_.update(begin, end_ - pos_);
+            pos_ = end_;
+        }
+    }
+
+    bool failed(std::string& error) const {
+        if (failed_) error = path_ + ": read error";
+        return failed_;
+    }
+
+private:
+    FILE* file_ = nullptr;
+    std::string path_;
+    std::vector<char> block_;
+    size_t pos_ = 0;
+    size_t end_ = 0;
+    uint64_t blockOffset_ = 0;  // block_[0] 의 파일 위치
+    uint64_t lineStart_ = 0;
+    LineHasher hasher_;
+    bool failed_ = false;
+
+    bool refill() {
+        if (!file_ || failed_) return false;
+        blockOffset_ += end_;
+        pos_ = 0;
+        end_ = std::fread(block_.data(), 1, block_.size(), file_);
+        if (end_ == 0 && std::ferror(file_)) failed_ = true;
+        return end_ > 0;
+    }
+};
+
+// ------------------------------------------------------------
+// 레코드가 가리키는 줄 텍스트를 파일에서 다시 읽음
+//   출력 순서대로 부르면 위치가 거의 늘어나기만 하므로 블록 하나로 대부분 해결되고,
+//   블록보다 긴 줄은 블록 크기 조각으로 나눠 넘겨서 메모리에 통째로 올리지 않는다
+// ------------------------------------------------------------
+class LineFetcher {
+public:
+    LineFetcher() = default;
+    LineFetcher(const LineFetcher&) = delete;
+    LineFetcher& operator=(const LineFetcher&) = delete;
+    ~LineFetcher() {
+        if (file_) std::fclose(file_);
+    }
+
+    bool open(const char* path, size_t blockBytes, std::string& error) {
+        path_ = path;
+        file_ = openBlockFile(path, error);
+        block_.resize(blockBytes);
+        return file_ != nullptr;
+    }
+
+    // 줄 텍스트를 piece(std::string_view) 로 한 번 이상 나눠 넘김 (읽기 오류면 false)
+    template <typename Piece>
+    bool read(const LineRecord& line, Piece&& piece) {
+        uint64_t offset = line.offset;
+        uint64_t remaining = line.length;
+        if (remaining == 0) return true;
+        do {
+            if (offset < blockOffset_ || offset >= blockOffset_ + blockLength_) {
+                if (!load(offset)) return false;
+            }
+            size_t start = static_cast<size_t>(offset - blockOffset_);
+            size_t take = static_cast<size_t>(std::min<uint64_t>(remaining, blockLength_ - start));
+            piece(std::string_view(block_.data() + start, take));
+            offset += take;
+            remaining -= take;
+        } while (remaining > 0);
+        return true;
+    }
+
+    std::string error() const { return path_ + ": read error"; }
+
+private:
+    FILE* file_ = nullptr;
+    std::string path_;
+    std::vector<char> block_;
+    uint64_t blockOffset_ = 0;
+    size_t blockLength_ = 0;
+
+    bool load(uint64_t offset) {
+        blockLength_ = 0;
+        if (!seekFile(file_, offset)) return false;
+        blockOffset_ = offset;
+        blockLength_ = std::fread(block_.data(), 1, block_.size(), file_);
+        return blockLength_ > 0;
+    }
+};
+
+// ------------------------------------------------------------
+// 넣은 순서대로 다시 꺼내는 버퍼, 메모리에는 maxItems 개까지만 두고 넘치면 임시 파일로
+//   T 는 memcpy 로 옮길 수 있는 타입 (레코드 그대로 파일에 씀)
+// ------------------------------------------------------------
+template <typename T>
+class SpillBuffer {
+    static_assert(std::is_trivially_copyable_v<T>, "SpillBuffer stores raw bytes");
+
+public:
+    explicit SpillBuffer(size_t maxItems) : maxItems_(std::max<size_t>(maxItems, 1)) {}
+    SpillBuffer(const SpillBuffer&) = delete;
+    SpillBuffer& operator=(const SpillBuffer&) = delete;
+    ~SpillBuffer() {
+        if (file_) std::fclose(file_);
+    }
+
+    void push(const T& item) {
+        memory_.push_back(item);
+        if (memory_.size() >= maxItems_) spill();
+    }
+
+    size_t size() const { return spilled_ + memory_.size(); }
+    bool empty() const { return size() == 0; }
+    bool failed() const { return failed_; }
+
+    // 넣은 순서대로 fn(const T&) (임시 파일 쪽은 maxItems 개씩 읽어 옴)
+    template <typename Fn>
+    bool forEach(Fn&& fn) {
+        if (spilled_ > 0) {
+            if (failed_ || std::fseek(file_, 0, SEEK_SET) != 0) return false;
+            std::vector<T> chunk(std::min(spilled_, maxItems_));
+            for (size_t done = 0; done < spilled_;) {
+                size_t count = std::min(chunk.size(), spilled_ - done);
+                if (std::fread(chunk.data(), sizeof(T), count, file_) != count) return false;
+                for (size_t i = 0; i < count; ++i) fn(chunk[i]);
+                done += count;
+            }
+        }
+        for (const T& item : memory_) fn(item);
+        return true;
+    }
+
+    // 비움 (임시 파일은 닫지 않고 처음부터 다시 씀)
+    void clear() {
+        memory_.clear();
+        spilled_ = 0;
+        if (file_ && std::fseek(file_, 0, SEEK_SET) != 0) failed_ = true;
+    }
+
+private:
+    size_t maxItems_;
+    std::vector<T> memory_;
+    FILE* file_ = nullptr;
+    size_t spilled_ = 0;  // 임시 파일에 있는 항목 수
+    bool failed_ = false;
+
+    void spill() {
+        if (!file_ && !failed_) {
+            file_ = std::tmpfile();
+            failed_ = file_ == nullptr;
+        }
+        if (!failed_ && std::fwrite(memory_.data(), sizeof(T), memory_.size(), file_) != memory_.size()) {
+            failed_ = true;
+        }
+        spilled_ += memory_.size();
+        memory_.clear();
+    }
+};
+
+// ------------------------------------------------------------
+// 메모리 상한을 창 줄 수 / 블록 크기 / SpillBuffer 상한으로 나눔
+//   - 블록 4개 (양쪽 읽기 + 양쪽 가져오기) : 1/8
+//   - SpillBuffer                          : 1/8
+//   - 창 (양쪽 레코드 + 줄 ID 표 + diff 작업 공간, 줄 쌍마다 WINDOW_BYTES_PER_LINE) : 나머지의 대부분
+// ------------------------------------------------------------
+struct OutOfCoreBudget {
+    static constexpr size_t DEFAULT_MEGABYTES = 256;
+    static constexpr size_t MIN_MEGABYTES = 4;
+    static constexpr size_t WINDOW_BYTES_PER_LINE = 320;
+
+    size_t blockBytes = 0;
+    size_t windowLines = 0;
+    size_t spillBytes = 0;
+
+    static OutOfCoreBudget fromBytes(size_t bytes) {
+        bytes = std::max(bytes, MIN_MEGABYTES << 20);
+        OutOfCoreBudget budget;
+        budget.blockBytes = std::clamp<size_t>(bytes / 32, size_t{64} << 10, size_t{4} << 20);
+        budget.spillBytes = bytes / 8;
+        budget.windowLines = std::max<size_t>(bytes / 2 / WINDOW_BYTES_PER_LINE, 1024);
+        return budget;
+    }
+};
+
+// ------------------------------------------------------------
+// 두 파일의 편집 스크립트를 레코드로 흘려보냄
+//   onEdit(op, line) : op 는 ' ' / '-' / '+', line 은 ' ' 와 '-' 면 기준 줄, '+' 면 변경 줄.
+//   편집은 파일 순서대로 한 번씩만 나오고, 넘긴 레코드는 호출이 끝나면 버려진다.
+// ------------------------------------------------------------
+class OutOfCoreDiff {
+public:
+    OutOfCoreDiff(const DiffOptions& options, const OutOfCoreBudget& budget) : options_(options), budget_(budget) {
+        // 기본 Myers 의 trace 는 편집 수의 제곱으로 커지므로 같은 결과 길이의 선형 공간 Myers 로
+        if (options_.algorithm == DiffAlgorithm::Myers) options_.algorithm = DiffAlgorithm::MyersLinear;
+    }
+
+    template <typename OnEdit>
+    bool run(const char* basePath, const char* changedPath, OnEdit&& onEdit, std::string& error) {
+        LineRecordReader base;
+        LineRecordReader changed;
+        if (!base.open(basePath, budget_.blockBytes, error) || !changed.open(changedPath, budget_.blockBytes, error)) {
+            return false;
+        }
+
+        bool baseDone = false;
+        bool changedDone = false;
+        while (true) {
+            fill(base, aWindow_, baseDone);
+            fill(changed, bWindow_, changedDone);
+            if (base.failed(error) || changed.failed(error)) return false;
+            if (aWindow_.empty() && bWindow_.empty()) return true;
+
+            intern();
+            size_t aCut = aWindow_.size();
+            size_t bCut = bWindow_.size();
+            if (baseDone && changedDone) {
+                emit(diffWindow(aCut, bCut), onEdit);
+            } else if (!cutAtAnchor(aCut, bCut)) {
+                // 강제 절단 (stream_session.hpp 와 같음): 창 전체 diff 의 마지막 같은 줄까지만 내보냄.
+                //   같은 줄이 없으면 꽉 찬 쪽 창만 삭제/추가로 내보내고 다른 쪽은 남김
+                const std::vector<IndexedEdit>& edits = diffWindow(aCut, bCut);
+                auto lastEqual =
+                    std::find_if(edits.rbegin(), edits.rend(), [](const IndexedEdit& e) { return e.op == ' '; });
+                if (lastEqual != edits.rend()) {
+                    aCut = static_cast<size_t>(lastEqual->aIndex) + 1;
+                    bCut = static_cast<size_t>(lastEqual->bIndex) + 1;
+                    emit(edits, onEdit, static_cast<size_t>(edits.rend() - lastEqual));
+                } else {
+                    if (aWindow_.size() >= budget_.windowLines) bCut = 0;
+                    else aCut = 0;
+                    emit(diffWindow(aCut, bCut), onEdit);
+                }
+            } else {
+                emit(diffWindow(aCut, bCut), onEdit);
+            }
+            aWindow_.erase(aWindow_.begin(), aWindow_.begin() + aCut);
+            bWindow_.erase(bWindow_.begin(), bWindow_.begin() + bCut);
+        }
+    }
+
+    uint32_t degraded() const { return degraded_; }
+
+private:
+    DiffOptions options_;
+    OutOfCoreBudget budget_;
+    std::vector<LineRecord> aWindow_;
+    std::vector<LineRecord> bWindow_;
+    SequenceInterner<LineRecord> interner_;
+    InternedLines ids_;  // aIds / bIds / idCount 만 채움 (줄 텍스트는 메모리에 없음)
+    LineDiffScratch scratch_;
+    uint32_t degraded_ = 0;
+
+    void fill(LineRecordReader& reader, std::vector<LineRecord>& window, bool& done) {
+        LineRecord record;
+        while (!done && window.size() < budget_.windowLines) {
+            if (reader.next(record)) window.push_back(record);
+            else done = true;
+        }
+    }
+
+    void intern() {
+        interner_.reset(aWindow_.size() + bWindow_.size());
+        ids_.aIds.clear();
+        ids_.bIds.clear();
+        for (const LineRecord& line : aWindow_) ids_.aIds.push_back(interner_.intern(line));
+        for (const LineRecord& line : bWindow_) ids_.bIds.push_back(interner_.intern(line));
+        ids_.idCount = static_cast<uint32_t>(interner_.size());
+    }
+
+    // 앵커 줄까지 끊을 위치. 앵커가 창 앞쪽에만 있으면 (창의 1/4 도 못 넘기면)
+    // 같은 창을 거의 그대로 다시 보게 되므로 강제 절단으로 넘김
+    bool cutAtAnchor(size_t& aCut, size_t& bCut) {
+        LineMatch anchor{};
+        if (!findStreamAnchor(ids_, anchor)) return false;
+        size_t aAnchor = static_cast<size_t>(anchor.aIndex) + 1;
+        size_t bAnchor = static_cast<size_t>(anchor.bIndex) + 1;
+        if ((aAnchor + bAnchor) * 4 < budget_.windowLines) return false;
+        aCut = aAnchor;
+        bCut = bAnchor;
+        return true;
+    }
+
+    // 양쪽 창의 앞 aCount / bCount 줄 diff (결과는 scratch_.edits, 다음 호출 전까지 유효)
+    const std::vector<IndexedEdit>& diffWindow(size_t aCount, size_t bCount) {
+        ids_.aIds.resize(aCount);
+        ids_.bIds.resize(bCount);
+        filterUnmatchedLines(ids_, scratch_.a, scratch_.b, scratch_.seen);
+        const std::vector<IndexedEdit>& edits = runFilteredLineDiff(
+            ids_.idCount, static_cast<int>(aCount), static_cast<int>(bCount), options_, scratch_);
+        degraded_ |= scratch_.degraded;
+        return edits;
+    }
+
+    // 앞 count 개 편집을 onEdit 으로 (기본: 전부)
+    template <typename OnEdit>
+    void emit(const std::vector<IndexedEdit>& edits, OnEdit& onEdit, size_t count = SIZE_MAX) {
+        count = std::min(count, edits.size());
+        for (size_t k = 0; k < count; ++k) {
+            const IndexedEdit& e = edits[k];
+            onEdit(e.op, e.op == '+' ? bWindow_[e.bIndex] : aWindow_[e.aIndex]);
+        }
+    }
+};
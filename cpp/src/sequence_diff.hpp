@@ -0,0 +1,146 @@
+// ------------------------------------------------------------
+// 토큰 종류에 상관없는 시퀀스 diff 엔진
+// ------------------------------------------------------------
+// 토큰에 연속 ID 를 붙이는 부분만 토큰 종류와 비교 방법을 템플릿 인자(SequenceTraits)로
+// 받고, 그 뒤는 모두 같은 uint32_t 코어를 탄다. 가상 함수 없이 컴파일 시점에 정해진다.
+//
+//   SequenceTraits<std::string_view> : 원문을 가리키는 단어 / 글자 (TokenAligner 의 SequenceDiffer)
+//   SequenceTraits<LineRecord>       : 텍스트 없는 줄 레코드 (out_of_core.hpp 의 SequenceInterner)
+//
+// SequenceDiffer 의 코어
+//   - 기준 토큰 수 x 변경 토큰 수가 LCS_MAX_CELLS 이하면 비트 병렬 LCS (bit_lcs.hpp)
+//     (기존 DP 역추적과 같은 정렬이라 JS 엔진의 lcsTokens 와 결과가 같음)
+//   - 더 크면 줄 diff 와 같은 선형 공간 Myers (myers_linear.hpp)
+//     (편집 수는 최소지만 같은 길이의 정렬 중 어느 것을 고르는지는 LCS 와 다를 수 있음)
+//
+// 줄 diff(runLineDiff)는 이 엔진을 거치지 않고 LineInterner 로 걸러낸 줄 ID 배열 위에서
+// LinearMyers 를 바로 부른다 (앵커 / 병렬 처리가 그 위에 얹혀 있음).
+//
+// 다른 토큰 종류가 필요하면 hash / equal 을 가진 SequenceTraits 특수화만 추가하면 된다.
+// ------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "bit_lcs.hpp"
+#include "edit_script.hpp"
+#include "line_index.hpp"
+#include "myers_linear.hpp"
+
+template <typename Token>
+struct SequenceTraits;
+
+// 원문을 가리키는 토큰 (바이트 비교)
+template <>
+struct SequenceTraits<std::string_view> {
+    static uint64_t hash(std::string_view token) { return hashBytes(token.data(), token.size()); }
+    static bool equal(std::string_view x, std::string_view y) { return x == y; }
+};
+
+// ------------------------------------------------------------
+// 토큰 -> 연속 ID 테이블 (LineInterner 와 같은 open addressing, 토큰 종류만 일반화)
+// ------------------------------------------------------------
+template <typename Token, typename Traits = SequenceTraits<Token>>
+class SequenceInterner {
+public:
+    // 테이블을 비움 (확보해 둔 용량은 재사용)
+    void reset(size_t expectedTokens) {
+        size_t capacity = 16;
+        while (capacity < expectedTokens * 2) capacity <<= 1;
+        slots_.assign(capacity, EMPTY);
+        tokens_.clear();
+        hashes_.clear();
+    }
+
+    uint32_t intern(const Token& token) {
+        uint64_t h = Traits::hash(token);
+        size_t mask = slots_.size() - 1;
+        size_t pos = static_cast<size_t>(h) & mask;
+        while (slots_[pos] != EMPTY) {
+            uint32_t id = slots_[pos];
+            if (hashes_[id] == h && Traits::equal(tokens_[id], token)) return id;
+            pos = (pos + 1) & mask;
+        }
+
+        uint32_t id = static_cast<uint32_t>(tokens_.size());
+        slots_[pos] = id;
+        tokens_.push_back(token);
+        hashes_.push_back(h);
+        if (tokens_.size() * 2 > slots_.size()) grow();
+        return id;
+    }
+
+    size_t size() const { return tokens_.size(); }
+
+private:
+    static constexpr uint32_t EMPTY = 0xFFFFFFFFu;
+
+    std::vector<uint32_t> slots_;
+    std::vector<Token> tokens_;
+    std::vector<uint64_t> hashes_;
+
+    void grow() {
+        slots_.assign(slots_.size() * 2, EMPTY);
+        size_t mask = slots_.size() - 1;
+        for (uint32_t id = 0; id < tokens_.size(); ++id) {
+            size_t pos = static_cast<size_t>(hashes_[id]) & mask;
+            while (slots_[pos] != EMPTY) pos = (pos + 1) & mask;
+            slots_[pos] = id;
+        }
+    }
+};
+
+// ------------------------------------------------------------
+// 토큰 배열 두 개의 정렬
+//   결과 ops 는 'M' (같은 토큰), 'D' (a 에만 있음), 'I' (b 에만 있음) 의 순서열
+//   ID 배열, 해시 테이블, LCS 행 버퍼를 멤버로 들고 있어 같은 객체로 반복 호출하면
+//   버퍼를 다시 잡지 않는다
+// ------------------------------------------------------------
+template <typename Token, typename Traits = SequenceTraits<Token>>
+class SequenceDiffer {
+public:
+    // 비트 병렬 LCS 를 쓰는 최대 크기 (기준 토큰 수 x 변경 토큰 수), 넘으면 선형 공간 Myers
+    static constexpr size_t LCS_MAX_CELLS = size_t(1) << 22;
+
+    void align(const std::vector<Token>& a, const std::vector<Token>& b, std::vector<char>& ops) {
+        interner_.reset(a.size() + b.size());
+        aIds_.clear();
+        bIds_.clear();
+        aIds_.reserve(a.size());
+        bIds_.reserve(b.size());
+        for (const Token& token : a) aIds_.push_back(interner_.intern(token));
+        for (const Token& token : b) bIds_.push_back(interner_.intern(token));
+        alignIds(aIds_, bIds_, static_cast<uint32_t>(interner_.size()), ops);
+    }
+
+    std::vector<char> align(const std::vector<Token>& a, const std::vector<Token>& b) {
+        std::vector<char> ops;
+        align(a, b, ops);
+        return ops;
+    }
+
+private:
+    SequenceInterner<Token, Traits> interner_;
+    std::vector<uint32_t> aIds_;
+    std::vector<uint32_t> bIds_;
+    BitParallelLcs lcs_;
+
+    void alignIds(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b, uint32_t idCount,
+                  std::vector<char>& ops) {
+        if (a.size() * b.size() <= LCS_MAX_CELLS) {
+            lcs_.align(a, b, idCount, ops);
+            return;
+        }
+
+        const uint32_t* aData = a.data();
+        const uint32_t* bData = b.data();
+        std::vector<IndexedEdit> edits =
+            myersDiffLinear(aData, static_cast<int>(a.size()), bData, static_cast<int>(b.size()));
+        ops.clear();
+        ops.reserve(edits.size());
+        for (const IndexedEdit& e : edits) ops.push_back(e.op == ' ' ? 'M' : e.op == '-' ? 'D' : 'I');
+    }
+};
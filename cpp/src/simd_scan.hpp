@@ -0,0 +1,206 @@
+// ------------------------------------------------------------
+// 바이트 스캐너 (SIMD)
+// ------------------------------------------------------------
+// 버퍼에서 특정 바이트('\n', ' ' 등)의 위치를 모두 찾는다. 16 / 32 바이트 블록을
+// 한 번에 비교해 일치 위치를 비트 마스크로 만들고, 켜진 비트만 차례로 넘겨준다.
+// 줄이 짧아 구분 바이트가 자주 나오는 입력에서도 한 바이트씩 도는 루프나
+// 구분 바이트마다 memchr 을 다시 부르는 방식보다 분기가 적다.
+//
+//   - WASM (-msimd128)   : wasm simd128 (16 바이트)
+//   - x86-64             : SSE2 (16 바이트), CPU 가 지원하면 실행 중에 AVX2 (32 바이트) 선택
+//   - 그 외              : 한 바이트씩 비교
+//
+//   forEachByte(text, '\n', [&](size_t pos) { ... });   // pos 는 text 안의 위치
+//
+// 같은 방식으로 두 버퍼를 블록째 비교해 공통 앞 / 뒤 길이도 구한다 (글자 단위 토큰 diff).
+//   commonPrefixLength(a, b) / commonSuffixLength(a, b, limit)
+// ------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#if defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define DIFF_SCAN_WASM_SIMD 1
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define DIFF_SCAN_SSE2 1
+#if defined(__GNUC__) || defined(__clang__)
+#include <immintrin.h>
+#define DIFF_SCAN_AVX2 1
+#endif
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+inline int countTrailingZeros32(uint32_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(x);
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, x);
+    return static_cast<int>(index);
+#else
+    int n = 0;
+    while (!(x & 1u)) {
+        x >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+inline int countLeadingZeros32(uint32_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clz(x);
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse(&index, x);
+    return 31 - static_cast<int>(index);
+#else
+    int n = 0;
+    while (!(x & 0x80000000u)) {
+        x <<= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+// 블록 시작 위치 base 와 일치 마스크로 fn 호출
+template <typename Fn>
+inline void forEachMaskBit(size_t base, uint32_t mask, Fn& fn) {
+    while (mask) {
+        fn(base + static_cast<size_t>(countTrailingZeros32(mask)));
+        mask &= mask - 1;
+    }
+}
+
+// ------------------------------------------------------------
+// 블록 커널: [0, size) 중 블록 크기의 배수만큼 처리하고 처리한 길이를 반환
+// ------------------------------------------------------------
+#ifdef DIFF_SCAN_WASM_SIMD
+template <typename Fn>
+inline size_t scanBlocksSimd128(const char* data, size_t size, char byte, Fn& fn) {
+    const v128_t needle = wasm_i8x16_splat(byte);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        v128_t block = wasm_v128_load(data + i);
+        uint32_t mask = static_cast<uint32_t>(wasm_i8x16_bitmask(wasm_i8x16_eq(block, needle)));
+        forEachMaskBit(i, mask, fn);
+    }
+    return i;
+}
+#endif
+
+#ifdef DIFF_SCAN_SSE2
+template <typename Fn>
+inline size_t scanBlocksSse2(const char* data, size_t size, char byte, Fn& fn) {
+    const __m128i needle = _mm_set1_epi8(byte);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+        forEachMaskBit(i, mask, fn);
+    }
+    return i;
+}
+#endif
+
+#ifdef DIFF_SCAN_AVX2
+template <typename Fn>
+__attribute__((target("avx2"))) inline size_t scanBlocksAvx2(const char* data, size_t size, char byte, Fn& fn) {
+    const __m256i needle = _mm256_set1_epi8(byte);
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+        forEachMaskBit(i, mask, fn);
+    }
+    return i;
+}
+
+// 실행 중인 CPU 의 AVX2 지원 여부 (처음 한 번만 확인)
+inline bool cpuHasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+#endif
+
+// ------------------------------------------------------------
+// text 안의 byte 위치마다 fn(pos) 호출 (앞에서부터 순서대로)
+// ------------------------------------------------------------
+template <typename Fn>
+inline void forEachByte(std::string_view text, char byte, Fn&& fn) {
+    const char* data = text.data();
+    const size_t size = text.size();
+    size_t done = 0;
+
+#if defined(DIFF_SCAN_WASM_SIMD)
+    done = scanBlocksSimd128(data, size, byte, fn);
+#elif defined(DIFF_SCAN_SSE2)
+#ifdef DIFF_SCAN_AVX2
+    if (cpuHasAvx2()) done = scanBlocksAvx2(data, size, byte, fn);
+#endif
+    // AVX2 가 남긴 32 바이트 미만의 꼬리도 16 바이트 블록이면 SSE2 로
+    const size_t offset = done;
+    auto shifted = [&](size_t pos) { fn(offset + pos); };
+    done += scanBlocksSse2(data + offset, size - offset, byte, shifted);
+#endif
+
+    for (size_t i = done; i < size; ++i) {
+        if (data[i] == byte) fn(i);
+    }
+}
+
+// ------------------------------------------------------------
+// 두 버퍼의 공통 앞 / 뒤 길이 (바이트)
+//   - 16 바이트씩 비교해 같은 바이트 마스크를 만들고, 다른 바이트가 처음 나온 블록에서 멈춤
+//   - 줄 하나 정도의 길이에 쓰므로 AVX2 없이 16 바이트 블록만 사용
+// ------------------------------------------------------------
+#if defined(DIFF_SCAN_WASM_SIMD)
+inline uint32_t equalMask16(const char* x, const char* y) {
+    return static_cast<uint32_t>(wasm_i8x16_bitmask(wasm_i8x16_eq(wasm_v128_load(x), wasm_v128_load(y))));
+}
+#elif defined(DIFF_SCAN_SSE2)
+inline uint32_t equalMask16(const char* x, const char* y) {
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x));
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+}
+#endif
+
+inline size_t commonPrefixLength(std::string_view a, std::string_view b) {
+    const size_t size = a.size() < b.size() ? a.size() : b.size();
+    size_t i = 0;
+#if defined(DIFF_SCAN_WASM_SIMD) || defined(DIFF_SCAN_SSE2)
+    for (; i + 16 <= size; i += 16) {
+        uint32_t differ = ~equalMask16(a.data() + i, b.data() + i) & 0xFFFFu;
+        if (differ) return i + static_cast<size_t>(countTrailingZeros32(differ));
+    }
+#endif
+    while (i < size && a[i] == b[i]) ++i;
+    return i;
+}
+
+// 끝에서부터 같은 바이트 수 (limit 을 넘지 않음)
+inline size_t commonSuffixLength(std::string_view a, std::string_view b, size_t limit) {
+    size_t size = a.size() < b.size() ? a.size() : b.size();
+    if (limit < size) size = limit;
+    const char* aEnd = a.data() + a.size();
+    const char* bEnd = b.data() + b.size();
+    size_t i = 0;
+#if defined(DIFF_SCAN_WASM_SIMD) || defined(DIFF_SCAN_SSE2)
+    for (; i + 16 <= size; i += 16) {
+        uint32_t differ = ~equalMask16(aEnd - i - 16, bEnd - i - 16) & 0xFFFFu;
+        // 블록의 가장 뒤쪽(높은 비트)에서 다른 바이트까지 같은 바이트 수
+        if (differ) return i + static_cast<size_t>(countLeadingZeros32(differ) - 16);
+    }
+#endif
+    while (i < size && aEnd[-1 - static_cast<std::ptrdiff_t>(i)] == bEnd[-1 - static_cast<std::ptrdiff_t>(i)]) ++i;
+    return i;
+}
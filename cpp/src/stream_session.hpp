@@ -0,0 +1,224 @@
+// ------------------------------------------------------------
+// 스트리밍 diff 세션
+// ------------------------------------------------------------
+// 두 입력을 조금씩 받아(feed) 가면서 결과 row 를 바로바로 내보낸다.
+//
+// 고정된 줄 번호(예: 500줄)로 양쪽을 똑같이 자르면, 앞쪽에 한 줄만 추가돼도
+// 이후 모든 청크의 위치가 어긋나서 거대한 가짜 삭제/추가 블록이 생긴다.
+// 여기서는
+//   1) 양쪽에 쌓인 완성된 줄들(창, window)에 줄 ID 를 붙이고
+//   2) 양쪽 창에서 한 번씩만 나오는 줄 중 순서가 유지되는 열(LIS)을 구해
+//   3) 그 열의 마지막 앵커 줄까지만 diff 해서 row 를 내보내고
+//   4) 앵커 뒤의 나머지(아직 짝이 정해지지 않은 꼬리)는 다음 청크로 넘긴다.
+// 그래서 청크 경계가 항상 "같은 줄" 위에 놓이고, 메모리는 창 크기로 제한된다.
+//
+// 앵커를 찾지 못한 채 한쪽이 maxPendingLines 를 넘으면 그때는 창 전체를
+// 그대로 diff 하고 넘어간다 (메모리 상한을 지키기 위한 강제 절단).
+// ------------------------------------------------------------
+#pragma once
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "diff_core.hpp"
+#include "simd_scan.hpp"
+
+// ------------------------------------------------------------
+// 양쪽 창에서 청크를 끊을 앵커 줄 찾기
+//   - 양쪽에 한 번씩만 나오는 줄로 순서가 유지되는 가장 긴 열을 만들고
+//   - 그 열에서 바로 앞 줄도 앵커인(두 줄 연속으로 맞는) 마지막 쌍을 고른다.
+//     한 줄짜리 우연한 일치(창 끝 근처의 다른 위치 줄)로 끊는 것을 피하기 위함
+//   - 연속 쌍이 없으면 열의 마지막 앵커를 사용
+// ------------------------------------------------------------
+inline bool findStreamAnchor(const InternedLines& lines, LineMatch& anchor) {
+    std::vector<LineMatch> anchors =
+        findUniqueLineAnchors(lines.aIds.data(), static_cast<int>(lines.aIds.size()), lines.bIds.data(),
+                              static_cast<int>(lines.bIds.size()), lines.idCount);
+    if (anchors.empty()) {
+        return false;
+    }
+
+    anchor = anchors.back();
+    for (size_t k = anchors.size() - 1; k > 0; --k) {
+        const LineMatch& before = anchors[k - 1];
+        if (before.aIndex + 1 == anchors[k].aIndex && before.bIndex + 1 == anchors[k].bIndex) {
+            anchor = anchors[k];
+            break;
+        }
+    }
+    return true;
+}
+
+// ------------------------------------------------------------
+// 스트리밍 세션
+//   feedBase / feedCompare 로 바이트를 넣고, drain() 으로 그동안 확정된 row 를
+//   diff_text 와 같은 {"rows": [...]} JSON 으로 꺼낸다. 입력을 다 넣었으면 finish().
+// ------------------------------------------------------------
+class DiffStreamSession {
+public:
+    static constexpr int DEFAULT_CHUNK_LINES = 2000;
+
+    explicit DiffStreamSession(const DiffOptions& options, int chunkLines = DEFAULT_CHUNK_LINES)
+        : options_(options),
+          chunkLines_(chunkLines > 0 ? static_cast<size_t>(chunkLines) : DEFAULT_CHUNK_LINES),
+          maxPendingLines_(chunkLines_ * 8) {}
+
+    void feedBase(const char* data, size_t length) {
+        base_.append(data, length);
+        pump(false);
+    }
+
+    void feedCompare(const char* data, size_t length) {
+        compare_.append(data, length);
+        pump(false);
+    }
+
+    // 입력 끝: 남은 줄을 모두 diff 해서 row 로 내보냄
+    void finish() {
+        if (!finished_) {
+            pump(true);
+            finished_ = true;
+        }
+    }
+
+    // 마지막 drain 이후 확정된 row 들 (다음 drain 전까지 유효)
+    //   그 사이 청크 중 하나라도 예산 때문에 탐색을 줄였으면 "degraded" 가 붙는다
+    const char* drain() {
+        result_.clear();
+        result_ += "{\n  \"rows\": [\n";
+        result_ += rowsJson_;
+        appendRowsJsonEnd(result_, degraded_);
+        rowsJson_.clear();
+        firstRow_ = true;
+        degraded_ = 0;
+        return result_.c_str();
+    }
+
+    size_t pendingBytes() const { return base_.text.size() + compare_.text.size(); }
+
+private:
+    // 한쪽 입력의 아직 처리하지 않은 바이트와 그 안의 '\n' 위치
+    struct PendingText {
+        std::string text;
+        std::vector<size_t> lineEnds;
+
+        void append(const char* data, size_t length) {
+            size_t start = text.size();
+            text.append(data, length);
+            forEachByte(std::string_view(text).substr(start), '\n',
+                        [&](size_t newline) { lineEnds.push_back(start + newline); });
+        }
+
+        size_t completeLines() const { return lineEnds.size(); }
+
+        // 앞쪽 완성된 줄 count 개 ('\n' 제외)
+        std::vector<std::string_view> lines(size_t count) const {
+            std::vector<std::string_view> out;
+            out.reserve(count);
+            size_t start = 0;
+            for (size_t i = 0; i < count; ++i) {
+                out.emplace_back(text.data() + start, lineEnds[i] - start);
+                start = lineEnds[i] + 1;
+            }
+            return out;
+        }
+
+        // 남은 전부 (splitLineViews 와 같은 규칙: 마지막 조각도 한 줄)
+        std::vector<std::string_view> remainingLines() const {
+            std::vector<std::string_view> out = lines(lineEnds.size());
+            size_t start = lineEnds.empty() ? 0 : lineEnds.back() + 1;
+            out.emplace_back(text.data() + start, text.size() - start);
+            return out;
+        }
+
+        void consume(size_t count) {
+            if (count == 0) return;
+            size_t bytes = lineEnds[count - 1] + 1;
+            text.erase(0, bytes);
+            lineEnds.erase(lineEnds.begin(), lineEnds.begin() + count);
+            for (size_t& end : lineEnds) end -= bytes;
+        }
+    };
+
+    DiffOptions options_;
+    size_t chunkLines_;
+    size_t maxPendingLines_;
+    PendingText base_;
+    PendingText compare_;
+    size_t retryAt_ = 0;  // 앵커를 못 찾았을 때 다시 시도할 (양쪽 줄 수 합) 기준
+    bool finished_ = false;
+
+    std::string rowsJson_;
+    bool firstRow_ = true;
+    uint32_t degraded_ = 0;
+    std::string result_;
+
+    // --------------------------------------------------------
+    // 쌓인 줄로 끊을 수 있는 만큼 청크를 처리
+    //   final 이면 마지막에 남은 줄을 모두 처리
+    // --------------------------------------------------------
+    void pump(bool final) {
+        while (true) {
+            size_t aCount = base_.completeLines();
+            size_t bCount = compare_.completeLines();
+            bool full = aCount >= maxPendingLines_ || bCount >= maxPendingLines_;
+
+            if (final && !full) {
+                emit(internLineViews(base_.remainingLines(), compare_.remainingLines(), options_.normalize));
+                base_.text.clear();
+                base_.lineEnds.clear();
+                compare_.text.clear();
+                compare_.lineEnds.clear();
+                return;
+            }
+            // 한쪽 입력이 아직 덜 들어왔으면 대기 (양쪽을 비슷한 속도로 넣어야 메모리가 제한됨)
+            if (!final && (aCount < chunkLines_ || bCount < chunkLines_)) return;
+            if (!full && aCount + bCount < retryAt_) return;
+
+            size_t aWindow = std::min(aCount, maxPendingLines_);
+            size_t bWindow = std::min(bCount, maxPendingLines_);
+            InternedLines window = internLineViews(base_.lines(aWindow), compare_.lines(bWindow), options_.normalize);
+
+            LineMatch anchor{};
+            if (findStreamAnchor(window, anchor)) {
+                // 앵커 줄까지만 diff, 나머지는 다음 청크로
+                aWindow = static_cast<size_t>(anchor.aIndex) + 1;
+                bWindow = static_cast<size_t>(anchor.bIndex) + 1;
+            } else if (!full) {
+                // 앵커가 없으면 줄이 더 쌓일 때까지 대기
+                retryAt_ = aCount + bCount + chunkLines_;
+                return;
+            } else {
+                // 강제 절단: 창 전체 diff 의 마지막 같은 줄까지만 내보냄.
+                //   같은 줄이 하나도 없으면 넘친 쪽 창만 삭제/추가로 내보내고 다른 쪽은 남김
+                std::vector<IndexedEdit> edits = runLineDiff(window, options_, &degraded_);
+                auto lastEqual = std::find_if(edits.rbegin(), edits.rend(),
+                                              [](const IndexedEdit& e) { return e.op == ' '; });
+                if (lastEqual != edits.rend()) {
+                    aWindow = static_cast<size_t>(lastEqual->aIndex) + 1;
+                    bWindow = static_cast<size_t>(lastEqual->bIndex) + 1;
+                } else if (aCount >= maxPendingLines_) {
+                    bWindow = 0;
+                } else {
+                    aWindow = 0;
+                }
+            }
+
+            window.aLines.resize(aWindow);
+            window.aIds.resize(aWindow);
+            window.bLines.resize(bWindow);
+            window.bIds.resize(bWindow);
+            emit(window);
+            base_.consume(aWindow);
+            compare_.consume(bWindow);
+            retryAt_ = 0;
+        }
+    }
+
+    void emit(const InternedLines& lines) {
+        std::vector<DiffRow> rows = buildRows(runLineDiff(lines, options_, &degraded_));
+        appendRowsJson(rowsJson_, rows, lines.aLines, lines.bLines, firstRow_, options_.tokenMode);
+    }
+};
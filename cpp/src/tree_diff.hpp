@@ -0,0 +1,175 @@
+// ------------------------------------------------------------
+// 디렉터리 트리 비교: 파일 짝 맞추기와 같은 파일 걸러내기
+// ------------------------------------------------------------
+// 두 디렉터리 아래의 일반 파일과 디렉터리를 재귀로 모아 상대 경로로 짝을 맞춘다 (diff -r 과 같은 규칙).
+//   - 양쪽에 다 있는 파일은 Modified 후보, 양쪽에 다 있는 디렉터리는 그 안의 항목끼리 다시 짝 맞춤
+//   - 한쪽에만 있으면 OnlyBase / OnlyChanged (디렉터리면 그 안으로 들어가지 않고 한 번만)
+//   - 한쪽은 파일, 한쪽은 디렉터리면 TypeMismatch (디렉터리 쪽 안으로 들어가지 않음)
+//   - 결과는 디렉터리별 이름 순서 ('/' 를 가장 앞 글자로 보고 정렬, 출력 순서도 이 순서)
+//   - 일반 파일 / 디렉터리가 아닌 항목 (fifo, 깨진 링크 등) 은 건너뜀
+//
+// 짝이 맞은 파일은 줄 diff 전에 sameContent() 로 같은 파일을 먼저 거른다.
+//   - 크기가 다르면 바로 다름
+//   - 크기가 같으면 바이트 비교 (해시를 먼저 구해도 같은 파일은 어차피 끝까지 비교해야 하므로
+//     memcmp 한 번이 가장 적게 읽음)
+//
+// 실제 diff 와 출력은 cli.hpp 의 runTreeDiff 가 맡는다.
+// ------------------------------------------------------------
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+enum class TreeEntryStatus {
+    Identical,
+    Modified,
+    OnlyBase,
+    OnlyChanged,
+    TypeMismatch,
+    Error,
+};
+
+inline const char* treeEntryStatusName(TreeEntryStatus status) {
+    switch (status) {
+        case TreeEntryStatus::Identical: return "identical";
+        case TreeEntryStatus::Modified: return "modified";
+        case TreeEntryStatus::OnlyBase: return "only_base";
+        case TreeEntryStatus::OnlyChanged: return "only_changed";
+        case TreeEntryStatus::TypeMismatch: return "type_mismatch";
+        default: return "error";
+    }
+}
+
+struct TreeEntry {
+    std::string relativePath;  // '/' 로 구분한 상대 경로
+    std::string basePath;      // 기준 쪽 전체 경로 (OnlyChanged 면 비어 있음)
+    std::string changedPath;   // 변경 쪽 전체 경로 (OnlyBase 면 비어 있음)
+    uint64_t baseSize = 0;
+    uint64_t changedSize = 0;
+    bool baseIsDirectory = false;
+    bool changedIsDirectory = false;
+    TreeEntryStatus status = TreeEntryStatus::Modified;
+};
+
+// 트리 안의 항목 하나 (상대 경로, 종류, 파일 크기)
+struct TreeNode {
+    std::string relativePath;
+    bool directory = false;
+    uint64_t size = 0;
+};
+
+// 상대 경로 순서: '/' 를 가장 앞 글자로 봐서 디렉터리 바로 뒤에 그 안의 항목이 이어지게 함
+//   ("a", "a/x", "a.txt" 순서로, diff -r 처럼 디렉터리마다 이름 순서)
+inline bool treePathLess(std::string_view x, std::string_view y) {
+    size_t n = std::min(x.size(), y.size());
+    for (size_t i = 0; i < n; ++i) {
+        if (x[i] == y[i]) continue;
+        if (x[i] == '/') return true;
+        if (y[i] == '/') return false;
+        return static_cast<unsigned char>(x[i]) < static_cast<unsigned char>(y[i]);
+    }
+    return x.size() < y.size();
+}
+
+// dir 아래의 일반 파일과 디렉터리. 실패하면 false 와 함께 error 에 이유를 남김
+inline bool listTreeNodes(const std::filesystem::path& dir, std::vector<TreeNode>& nodes, std::string& error) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    fs::recursive_directory_iterator it(dir, fs::directory_options::skip_permission_denied, ec);
+    for (; !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+        std::error_code entryError;
+        TreeNode node;
+        if (it->is_directory(entryError)) {
+            node.directory = true;
+        } else if (it->is_regular_file(entryError)) {
+            node.size = it->file_size(entryError);
+            if (entryError) continue;
+        } else {
+            continue;
+        }
+        node.relativePath = it->path().lexically_relative(dir).generic_string();
+        nodes.push_back(std::move(node));
+    }
+    if (ec) {
+        error = dir.string() + ": " + ec.message();
+        return false;
+    }
+    std::sort(nodes.begin(), nodes.end(),
+              [](const TreeNode& x, const TreeNode& y) { return treePathLess(x.relativePath, y.relativePath); });
+    return true;
+}
+
+// nodes[i] 가 디렉터리면 그 안의 항목을 건너뛴 다음 번호, 아니면 i + 1
+inline size_t skipTreeNode(const std::vector<TreeNode>& nodes, size_t i) {
+    if (!nodes[i].directory) return i + 1;
+    std::string prefix = nodes[i].relativePath + '/';
+    for (++i; i < nodes.size() && nodes[i].relativePath.compare(0, prefix.size(), prefix) == 0; ++i) {}
+    return i;
+}
+
+// 두 디렉터리의 항목을 상대 경로로 짝 맞춤 (상대 경로 순서)
+inline bool pairTreeFiles(const std::filesystem::path& baseDir, const std::filesystem::path& changedDir,
+                          std::vector<TreeEntry>& entries, std::string& error) {
+    std::vector<TreeNode> baseNodes;
+    std::vector<TreeNode> changedNodes;
+    if (!listTreeNodes(baseDir, baseNodes, error) || !listTreeNodes(changedDir, changedNodes, error)) {
+        return false;
+    }
+
+    entries.clear();
+    size_t i = 0;
+    size_t j = 0;
+    while (i < baseNodes.size() || j < changedNodes.size()) {
+        const TreeNode* base = nullptr;
+        const TreeNode* changed = nullptr;
+        if (j == changedNodes.size()) {
+            base = &baseNodes[i];
+        } else if (i == baseNodes.size()) {
+            changed = &changedNodes[j];
+        } else {
+            if (!treePathLess(changedNodes[j].relativePath, baseNodes[i].relativePath)) base = &baseNodes[i];
+            if (!treePathLess(baseNodes[i].relativePath, changedNodes[j].relativePath)) changed = &changedNodes[j];
+        }
+
+        // 양쪽 모두 디렉터리: 안쪽 항목끼리 이어서 짝 맞춤
+        if (base && changed && base->directory && changed->directory) {
+            ++i;
+            ++j;
+            continue;
+        }
+
+        TreeEntry entry;
+        entry.relativePath = base ? base->relativePath : changed->relativePath;
+        if (base) {
+            entry.basePath = (baseDir / base->relativePath).string();
+            entry.baseSize = base->size;
+            entry.baseIsDirectory = base->directory;
+            i = skipTreeNode(baseNodes, i);
+        }
+        if (changed) {
+            entry.changedPath = (changedDir / changed->relativePath).string();
+            entry.changedSize = changed->size;
+            entry.changedIsDirectory = changed->directory;
+            j = skipTreeNode(changedNodes, j);
+        }
+        entry.status = !changed ? TreeEntryStatus::OnlyBase
+                     : !base    ? TreeEntryStatus::OnlyChanged
+                     : entry.baseIsDirectory != entry.changedIsDirectory ? TreeEntryStatus::TypeMismatch
+                                                                         : TreeEntryStatus::Modified;
+        entries.push_back(std::move(entry));
+    }
+    return true;
+}
+
+// 두 파일 내용이 같은지 (크기 -> 바이트 순으로 확인)
+inline bool sameContent(std::string_view base, std::string_view changed) {
+    if (base.size() != changed.size()) return false;
+    return base.empty() || std::memcmp(base.data(), changed.data(), base.size()) == 0;
+}
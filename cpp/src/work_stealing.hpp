@@ -0,0 +1,101 @@
+// ------------------------------------------------------------
+// 작업 훔치기(work stealing) 스케줄러
+// ------------------------------------------------------------
+// WorkerPool::parallelFor 는 번호를 하나씩 순서대로 나눠 주므로 작업 크기가 비슷할 때
+// 알맞다. 디렉터리 비교처럼 큰 파일 하나와 작은 파일 수천 개가 섞이면, 큰 작업을 늦게
+// 집은 스레드 하나가 끝날 때까지 나머지가 논다.
+//
+// WorkStealingScheduler::run(order, fn) 은
+//   - order(큰 작업부터 정렬된 작업 번호)를 스레드마다 돌아가며 나눠 자기 큐에 넣고
+//   - 각 스레드는 자기 큐 앞(남은 것 중 가장 큰 작업)부터 처리하다가
+//   - 큐가 비면 다른 스레드 큐의 뒤쪽 절반을 가져와서(steal) 이어서 처리한다
+// 큰 작업을 먼저 시작하고 남은 작업은 노는 스레드가 가져가므로, 가장 큰 작업 하나가
+// 끝나는 시점 근처에서 모든 작업이 끝난다.
+//
+// 작업 안에서 새 작업을 만들지 않으므로 모든 큐가 비면 끝난다. 호출한 스레드도
+// worker 0 으로 같이 일하고, 나머지 스레드는 run() 마다 만들고 끝나면 join 한다.
+// ------------------------------------------------------------
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "worker_pool.hpp"
+
+class WorkStealingScheduler {
+public:
+    // threads: 호출 스레드를 포함한 전체 스레드 수 (0 이하면 하드웨어 스레드 수)
+    explicit WorkStealingScheduler(int threads) : queues_(static_cast<size_t>(resolveThreadCount(threads))) {}
+
+    int size() const { return static_cast<int>(queues_.size()); }
+
+    // order 의 작업 번호마다 fn(번호, worker) 를 한 번씩 실행하고, 모두 끝나면 반환
+    void run(const std::vector<size_t>& order, const std::function<void(size_t, int)>& fn) {
+        const size_t threads = queues_.size();
+        for (size_t k = 0; k < order.size(); ++k) queues_[k % threads].tasks.push_back(order[k]);
+
+        std::vector<std::thread> helpers;
+        for (size_t w = 1; w < threads && w < order.size(); ++w) {
+            helpers.emplace_back([this, &fn, w] { workerLoop(fn, static_cast<int>(w)); });
+        }
+        workerLoop(fn, 0);
+        for (std::thread& helper : helpers) helper.join();
+    }
+
+    // 지금까지 다른 스레드 큐에서 작업을 가져온 횟수
+    size_t steals() const { return steals_.load(); }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<size_t> tasks;
+    };
+
+    std::vector<Queue> queues_;
+    std::atomic<size_t> steals_{0};
+
+    void workerLoop(const std::function<void(size_t, int)>& fn, int worker) {
+        size_t task;
+        while (popOwn(worker, task) || steal(worker, task)) {
+            fn(task, worker);
+        }
+    }
+
+    bool popOwn(int worker, size_t& task) {
+        Queue& own = queues_[static_cast<size_t>(worker)];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (own.tasks.empty()) return false;
+        task = own.tasks.front();
+        own.tasks.pop_front();
+        return true;
+    }
+
+    // 다음 스레드부터 한 바퀴 돌며 남은 작업이 있는 큐의 뒤쪽 절반을 가져옴
+    bool steal(int worker, size_t& task) {
+        const size_t threads = queues_.size();
+        for (size_t step = 1; step < threads; ++step) {
+            Queue& victim = queues_[(static_cast<size_t>(worker) + step) % threads];
+            std::vector<size_t> taken;
+            {
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                size_t count = (victim.tasks.size() + 1) / 2;
+                if (count == 0) continue;
+                taken.assign(victim.tasks.end() - static_cast<std::ptrdiff_t>(count), victim.tasks.end());
+                victim.tasks.resize(victim.tasks.size() - count);
+            }
+            steals_.fetch_add(1);
+
+            task = taken.front();
+            Queue& own = queues_[static_cast<size_t>(worker)];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            own.tasks.insert(own.tasks.end(), taken.begin() + 1, taken.end());
+            return true;
+        }
+        return false;
+    }
+};
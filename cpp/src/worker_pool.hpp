@@ -0,0 +1,138 @@
+// ------------------------------------------------------------
+// 작업자 스레드 풀
+// ------------------------------------------------------------
+// 고정된 개수의 std::thread 를 만들어 두고 parallelFor(count, fn) 으로
+// fn(0, worker) ... fn(count - 1, worker) 를 나눠 실행한다. 호출한 스레드도
+// (worker = 0 으로) 같이 일하고, 모든 작업이 끝나야 반환한다.
+// worker 번호(0 ~ size() - 1)는 스레드별 작업 공간을 나눠 쓰는 데 사용한다.
+//
+// WASM 빌드(-pthread)에서는 std::thread 가 Web Worker 로 만들어지므로
+// build.sh 에서 PTHREAD_POOL_SIZE 로 워커를 미리 띄워 둔다.
+// ------------------------------------------------------------
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkerPool {
+public:
+    // threads: 호출 스레드를 포함한 전체 스레드 수
+    explicit WorkerPool(int threads) {
+        for (int i = 1; i < threads; ++i) {
+            workers_.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread& worker : workers_) worker.join();
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    int size() const { return static_cast<int>(workers_.size()) + 1; }
+
+    void parallelFor(size_t count, const std::function<void(size_t, int)>& fn) {
+        if (workers_.empty() || count <= 1) {
+            for (size_t i = 0; i < count; ++i) fn(i, 0);
+            return;
+        }
+
+        // 한 번에 하나의 parallelFor 만 실행
+        std::lock_guard<std::mutex> runLock(runMutex_);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job_ = &fn;
+            jobCount_ = count;
+            next_.store(0);
+            active_ = workers_.size();
+            ++generation_;
+        }
+        wake_.notify_all();
+
+        runJob(fn, count, 0);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return active_ == 0; });
+        job_ = nullptr;
+    }
+
+private:
+    std::vector<std::thread> workers_;
+    std::mutex runMutex_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+
+    const std::function<void(size_t, int)>* job_ = nullptr;
+    size_t jobCount_ = 0;
+    std::atomic<size_t> next_{0};
+    size_t active_ = 0;         // 이번 작업을 아직 끝내지 않은 작업자 수
+    uint64_t generation_ = 0;   // parallelFor 호출마다 1 씩 증가
+    bool stop_ = false;
+
+    void runJob(const std::function<void(size_t, int)>& fn, size_t count, int worker) {
+        for (size_t i = next_.fetch_add(1); i < count; i = next_.fetch_add(1)) {
+            fn(i, worker);
+        }
+    }
+
+    void workerLoop(int worker) {
+        uint64_t seen = 0;
+        while (true) {
+            const std::function<void(size_t, int)>* job;
+            size_t count;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_) return;
+                seen = generation_;
+                job = job_;
+                count = jobCount_;
+            }
+
+            runJob(*job, count, worker);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                --active_;
+            }
+            done_.notify_one();
+        }
+    }
+};
+
+// ------------------------------------------------------------
+// 프로세스 전체에서 공유하는 풀
+//   threads <= 0 이면 하드웨어 스레드 수 사용. 요청한 크기가 바뀌면 새로 만든다.
+//   shared_ptr 로 돌려주므로 다른 호출이 풀을 바꿔도 쓰던 풀은 끝까지 유효하다.
+// ------------------------------------------------------------
+inline int resolveThreadCount(int threads) {
+    if (threads > 0) return threads;
+    unsigned hardware = std::thread::hardware_concurrency();
+    return hardware > 0 ? static_cast<int>(hardware) : 1;
+}
+
+inline std::shared_ptr<WorkerPool> sharedWorkerPool(int threads) {
+    static std::mutex poolMutex;
+    static std::shared_ptr<WorkerPool> pool;
+
+    int wanted = resolveThreadCount(threads);
+    std::lock_guard<std::mutex> lock(poolMutex);
+    if (!pool || pool->size() != wanted) {
+        pool = std::make_shared<WorkerPool>(wanted);
+    }
+    return pool;
+}
@@ -0,0 +1,118 @@
+// ------------------------------------------------------------
+// diff 워커 (web/src/utils/wasm-worker-pool.ts 가 여러 개 띄움)
+// ------------------------------------------------------------
+// 워커마다 main.js 로 WASM 인스턴스를 하나씩 올려 두고, 메인 스레드가 SharedArrayBuffer 에
+// 써 둔 입력 바이트의 (위치, 길이) 를 받아 diff 한 뒤 결과 바이트를 transferable 로 돌려준다.
+//   - main.js 를 importScripts 로 올려야 하므로 모듈 워커가 아닌 classic 워커 (그래서 public 에 둠)
+//   - 워커 하나가 청크 하나씩 맡으므로 C++ diff 스레드는 1 로 두고 pthread 도 미리 띄우지 않음
+//   - 결과는 바이너리(diff_text_binary, cpp/src/binary_result.hpp)가 기본이고,
+//     없는 이전 빌드에서는 JSON 문자열 바이트를 돌려줌
+//
+// 메시지
+//   받음: { type: 'diff', id, shared, baseOffset, baseLength, compareOffset, compareLength,
+//          algorithm, flags, budget: [maxCost, maxMemoryMb, timeLimitMs] }
+//   보냄: { type: 'ready' } / { type: 'failed', message }
+//         { type: 'result', id, format: 'binary' | 'json', buffer, pureAlgorithmTime, memoryAlloc }
+//         { type: 'error', id, message }
+// ------------------------------------------------------------
+
+var Module = {
+  // pthread 워커가 이 파일 대신 main.js 를 띄우도록
+  mainScriptUrlOrBlob: '/main.js',
+  // build.sh 의 PTHREAD_POOL_SIZE 가 먼저 보는 값 (미리 띄워 둘 pthread 없음)
+  diffPthreadPoolSize: 0,
+  onRuntimeInitialized: function () {
+    if (Module._diff_set_threads) Module._diff_set_threads(1);
+    self.postMessage({ type: 'ready' });
+  },
+  onAbort: function (reason) {
+    self.postMessage({ type: 'failed', message: String(reason) });
+  },
+};
+
+// 입력 버퍼 (청크보다 작으면 1.5배로 늘림)
+var inputPtr = 0;
+var inputSize = 0;
+var budgetKey = '0:0:0';
+
+function ensureInput(size) {
+  if (inputSize >= size) return inputPtr;
+  if (inputPtr) Module._free(inputPtr);
+  inputSize = Math.ceil(size * 1.5);
+  inputPtr = Module._malloc(inputSize);
+  if (!inputPtr) {
+    inputSize = 0;
+    throw new Error('메모리 할당 실패');
+  }
+  return inputPtr;
+}
+
+function applyBudget(budget) {
+  var key = budget.join(':');
+  if (key === budgetKey || !Module._diff_set_budget) return;
+  Module._diff_set_budget(budget[0], budget[1], budget[2]);
+  budgetKey = key;
+}
+
+function runDiff(job) {
+  var memAllocStart = performance.now();
+  // 양쪽을 '\0' 으로 끝나게 이어서 복사 (SharedArrayBuffer -> 이 워커의 WASM 메모리)
+  var ptr = ensureInput(job.baseLength + job.compareLength + 2);
+  var heap = Module.HEAPU8;
+  var comparePtr = ptr + job.baseLength + 1;
+  heap.set(new Uint8Array(job.shared, job.baseOffset, job.baseLength), ptr);
+  heap[ptr + job.baseLength] = 0;
+  heap.set(new Uint8Array(job.shared, job.compareOffset, job.compareLength), comparePtr);
+  heap[comparePtr + job.compareLength] = 0;
+  var memoryAlloc = performance.now() - memAllocStart;
+
+  applyBudget(job.budget);
+
+  var algorithmStart = performance.now();
+  var format = 'binary';
+  var resultPtr;
+  if (Module._diff_text_binary) {
+    resultPtr = Module._diff_text_binary(ptr, comparePtr, job.algorithm, job.flags);
+  } else {
+    format = 'json';
+    resultPtr =
+      Module._diff_text_ex && (job.algorithm !== 0 || job.flags !== 0)
+        ? Module._diff_text_ex(ptr, comparePtr, job.algorithm, job.flags)
+        : Module._diff_text(ptr, comparePtr);
+  }
+  var pureAlgorithmTime = performance.now() - algorithmStart;
+  if (!resultPtr) throw new Error('diff 결과 포인터가 유효하지 않습니다');
+
+  // 결과를 WASM 메모리 밖의 ArrayBuffer 로 복사해 소유권째 넘김
+  heap = Module.HEAPU8;
+  var end =
+    format === 'binary' ? resultPtr + new Uint32Array(heap.buffer, resultPtr, 8)[6] * 4 : heap.indexOf(0, resultPtr);
+  var buffer = heap.slice(resultPtr, end).buffer;
+  self.postMessage(
+    {
+      type: 'result',
+      id: job.id,
+      format: format,
+      buffer: buffer,
+      pureAlgorithmTime: pureAlgorithmTime,
+      memoryAlloc: memoryAlloc,
+    },
+    [buffer],
+  );
+}
+
+self.onmessage = function (event) {
+  var job = event.data;
+  if (job.type !== 'diff') return;
+  try {
+    runDiff(job);
+  } catch (error) {
+    self.postMessage({ type: 'error', id: job.id, message: String(error && error.message ? error.message : error) });
+  }
+};
+
+try {
+  importScripts('/main.js');
+} catch (error) {
+  self.postMessage({ type: 'failed', message: String(error) });
+}
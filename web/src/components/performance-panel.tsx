@@ -210,7 +210,7 @@ function WasmOverheadPanel({ metrics }: WasmOverheadPanelProps) {
         {/* 오버헤드 세부 내역 */}
         <div className="rounded-lg border border-slate-200 bg-white/70 p-3">
           <h5 className="mb-2 text-xs font-semibold text-slate-600">WASM 오버헤드 세부 내역</h5>
-          <div className="grid grid-cols-3 gap-2 text-center">
+          <div className="grid grid-cols-4 gap-2 text-center">
             <div className="rounded-lg bg-slate-50 p-2">
               <p className="text-[10px] text-slate-500">메모리 할당</p>
               <p className="font-mono text-sm font-semibold text-slate-700">
@@ -227,6 +227,12 @@ function WasmOverheadPanel({ metrics }: WasmOverheadPanelProps) {
               <p className="text-[10px] text-slate-500">JSON 파싱</p>
               <p className="font-mono text-sm font-semibold text-slate-700">{formatDuration(metrics.jsonParseTime)}</p>
             </div>
+            <div className="rounded-lg bg-slate-50 p-2">
+              <p className="text-[10px] text-slate-500">바이너리 읽기</p>
+              <p className="font-mono text-sm font-semibold text-slate-700">
+                {formatDuration(metrics.binaryDecodeTime)}
+              </p>
+            </div>
           </div>
         </div>
       </div>
@@ -234,6 +240,65 @@ function WasmOverheadPanel({ metrics }: WasmOverheadPanelProps) {
   );
 }
 
+/**
+ * C++ 엔진 단계별 분석 패널 (DIFF_STATS 빌드에서만 표시)
+ */
+interface EngineStatsPanelProps {
+  metrics: PerformanceMetrics;
+}
+
+function EngineStatsPanel({ metrics }: EngineStatsPanelProps) {
+  const stats = metrics.engineStats;
+  if (metrics.mode !== 'cpp' || !stats) return null;
+
+  const phases = [
+    { name: '줄 분할', duration: stats.splitMs, color: 'bg-sky-500' },
+    { name: '줄 diff', duration: stats.lineDiffMs, color: 'bg-blue-600' },
+    { name: 'row 묶기', duration: stats.buildRowsMs, color: 'bg-violet-500' },
+    { name: '토큰 diff', duration: stats.tokenDiffMs, color: 'bg-emerald-500' },
+    { name: '직렬화', duration: stats.serializeMs, color: 'bg-amber-500' },
+  ];
+  const counters = [
+    { label: '편집 거리 (D)', value: stats.editDistance.toLocaleString() },
+    { label: 'snake 수', value: stats.snakeCount.toLocaleString() },
+    { label: '최장 snake', value: `${stats.longestSnake.toLocaleString()}줄` },
+    { label: 'Myers 탐색', value: stats.myersSteps.toLocaleString() },
+    { label: '토큰 diff 줄', value: stats.tokenRows.toLocaleString() },
+    { label: '토큰 수', value: stats.tokenCount.toLocaleString() },
+    { label: '할당 횟수', value: stats.allocCount.toLocaleString() },
+    { label: '할당 크기', value: formatBytes(stats.allocBytes) },
+  ];
+  const hotspot = phases.reduce((a, b) => (b.duration > a.duration ? b : a));
+
+  return (
+    <div className="overflow-hidden rounded-xl border-2 border-indigo-200 bg-gradient-to-br from-indigo-50 to-slate-50">
+      <div className="border-b border-indigo-200 bg-indigo-100/50 px-4 py-3">
+        <h4 className="flex items-center gap-2 text-sm font-bold text-indigo-800">
+          <BarChart3 className="h-4 w-4" />
+          C++ 엔진 단계별 분석
+        </h4>
+        <p className="mt-1 text-xs text-indigo-600">
+          엔진 내부 {formatDuration(stats.totalMs)} 중 가장 오래 걸린 단계: {hotspot.name} (
+          {calculatePercentage(hotspot.duration, stats.totalMs).toFixed(0)}%)
+        </p>
+      </div>
+
+      <div className="space-y-4 p-4">
+        <TimelineBar phases={phases} totalTime={stats.totalMs} />
+
+        <div className="grid grid-cols-4 gap-2 text-center">
+          {counters.map((counter) => (
+            <div key={counter.label} className="rounded-lg bg-white/70 p-2">
+              <p className="text-[10px] text-slate-500">{counter.label}</p>
+              <p className="font-mono text-sm font-semibold text-slate-700">{counter.value}</p>
+            </div>
+          ))}
+        </div>
+      </div>
+    </div>
+  );
+}
+
 interface DetailedMetricsTableProps {
   metrics: PerformanceMetrics;
 }
@@ -433,6 +498,9 @@ export default function PerformancePanel({ metrics, className }: PerformancePane
       {/* WASM 오버헤드 분석 패널 (C++ 모드 전용) */}
       <WasmOverheadPanel metrics={metrics} />
 
+      {/* C++ 엔진 단계별 분석 (DIFF_STATS 빌드 전용) */}
+      <EngineStatsPanel metrics={metrics} />
+
       {/* 타임라인 바 */}
       <TimelineBar phases={phases} totalTime={metrics.totalTime} />
 
@@ -7,13 +7,27 @@ import { useState, useCallback, useMemo, useEffect } from 'react';
 import type { Nullish } from '@/types/common.ts';
 import { Button } from '@/components/shadcn/button.tsx';
 import { Loader, ChevronDown, ChevronUp, BarChart3 } from 'lucide-react';
-import { parseDiffOutput, type DiffPair, type DiffLine } from '@/utils/diff';
+import {
+  parseDiffOutput,
+  skippedPairs,
+  type DegradedReason,
+  type DiffPair,
+  type DiffLine,
+  type DiffSkip,
+} from '@/utils/diff';
 import DiffContainer from '@/components/diff-container';
 import { Label } from '@/components/shadcn/label';
 import { RadioGroup, RadioGroupItem } from '@/components/shadcn/radio-group';
-import { streamDiffJs, streamDiffWasm, type ProgressCallback, type StreamDiffResult } from '@/utils/stream-diff';
+import {
+  splitLines,
+  streamDiffJs,
+  streamDiffWasm,
+  type ProgressCallback,
+  type StreamDiffResult,
+} from '@/utils/stream-diff';
 import PerformancePanel from '@/components/performance-panel';
 import { type PerformanceMetrics } from '@/utils/performance';
+import { type DiffAlgorithm, type DiffBudget, type DiffOptions, type TokenMode } from '@/utils/algorithm';
 
 // 변경사항 앞뒤로 보여줄 컨텍스트 줄 수
 const CONTEXT_LINES = 3;
@@ -24,15 +38,45 @@ const MAX_VISIBLE_LINES = 500;
 // 더 보기 시 추가할 라인 수
 const LOAD_MORE_LINES = 300;
 
+// 줄 단위 diff 알고리즘 선택지
+const ALGORITHM_CHOICES: Array<{ value: DiffAlgorithm; label: string }> = [
+  { value: 'myers', label: 'Myers' },
+  { value: 'myers-linear', label: 'Myers (선형 공간)' },
+  { value: 'patience', label: 'Patience' },
+  { value: 'histogram', label: 'Histogram' },
+];
+
+// C++ 줄 diff 비용 상한: 한 번의 줄 diff 가 이 시간을 넘으면 남은 구간은 삭제/추가로 표시
+// (완전히 다른 큰 파일에서 브라우저가 멈추지 않도록)
+const DIFF_BUDGET: DiffBudget = { timeLimitMs: 3000 };
+
+// 최소 diff 가 아닐 수 있는 이유 표시
+const DEGRADED_LABELS: Record<DegradedReason, string> = {
+  cost: '편집 거리',
+  memory: '메모리',
+  time: '시간',
+};
+
+// 수정된 줄 안의 비교 단위 선택지
+const TOKEN_MODE_CHOICES: Array<{ value: TokenMode; label: string }> = [
+  { value: 'word', label: '단어 단위' },
+  { value: 'char', label: '글자 단위' },
+];
+
 // Hunk 타입: 변경사항 그룹 또는 숨겨진 컨텍스트
+// 숨겨진 hunk 는 줄 내용 없이 skip 범위만 들고 있다가 펼칠 때 원문에서 꺼냄
 type DiffHunk = {
   id: string;
   type: 'changes' | 'hidden';
   startIndex: number;
   endIndex: number;
   lines: DiffPair[];
+  skip?: DiffSkip;
 };
 
+// hunk 가 차지하는 줄 수 (숨겨진 hunk 는 접힌 줄 수)
+const hunkLineCount = (hunk: DiffHunk) => (hunk.skip ? hunk.skip.count : hunk.lines.length);
+
 // 숨겨진 라인들의 펼침 상태
 type ExpandedState = Record<string, boolean>;
 
@@ -41,9 +85,14 @@ export type IndexPageProps = Omit<React.ComponentProps<'div'>, 'children'> & {};
 export default function IndexPage({ className, ...props }: IndexPageProps) {
   const [files, setFiles] = useState<Nullish<File[]>>(null);
   const [diffView, setDiffView] = useState<Nullish<DiffPair[]>>(null);
+  // 접힌 줄을 펼칠 때 꺼내 볼 원문 줄
+  const [sourceLines, setSourceLines] = useState<{ base: string[]; compare: string[] }>({ base: [], compare: [] });
   const [loading, setLoading] = useState(false);
   const [mode, setMode] = useState<'cpp' | 'js'>('cpp');
+  const [algorithm, setAlgorithm] = useState<DiffAlgorithm>('myers');
+  const [tokenMode, setTokenMode] = useState<TokenMode>('word');
   const [performanceMetrics, setPerformanceMetrics] = useState<PerformanceMetrics | null>(null);
+  const [degraded, setDegraded] = useState<DegradedReason[]>([]);
   const [progress, setProgress] = useState<{ current: number; total: number; percentage: number } | null>(null);
   const [expandedHunks, setExpandedHunks] = useState<ExpandedState>({});
   const [maxVisibleLines, setMaxVisibleLines] = useState(MAX_VISIBLE_LINES);
@@ -54,7 +103,9 @@ export default function IndexPage({ className, ...props }: IndexPageProps) {
     setProgress(progressInfo);
   }, []);
 
-  // diffView를 Hunk로 분할 (변경사항 + 컨텍스트 기반)
+  // diffView를 Hunk로 분할
+  // - 같은 줄은 diff 결과에서 이미 앞뒤 CONTEXT_LINES 줄만 남기고 skip 으로 접혀 있음
+  // - skip 은 숨겨진 hunk 가 되고, MIN_HIDDEN_LINES 보다 적으면 바로 원문에서 꺼내 표시
   const hunks = useMemo((): DiffHunk[] => {
     if (!diffView || diffView.length === 0) return [];
 
@@ -62,106 +113,35 @@ export default function IndexPage({ className, ...props }: IndexPageProps) {
     let i = 0;
 
     while (i < diffView.length) {
-      const current = diffView[i];
-
-      // 변경사항 찾기 (change, add, delete)
-      if (current.type !== 'same') {
-        // 변경 시작점 찾기 (앞쪽 컨텍스트 포함)
-        const contextStart = Math.max(0, i - CONTEXT_LINES);
-
-        // 이전 hunk와 겹치는지 확인
-        if (result.length > 0) {
-          const lastHunk = result[result.length - 1];
-          if (lastHunk.type === 'hidden' && lastHunk.endIndex >= contextStart) {
-            // 숨겨진 영역이 컨텍스트와 겹치면 숨겨진 영역 축소 또는 제거
-            if (lastHunk.startIndex >= contextStart) {
-              // 완전히 겹침 - 숨겨진 hunk 제거
-              result.pop();
-            } else {
-              // 부분적으로 겹침 - 숨겨진 영역 축소
-              lastHunk.endIndex = contextStart - 1;
-              lastHunk.lines = diffView.slice(lastHunk.startIndex, lastHunk.endIndex + 1);
-              if (lastHunk.lines.length < MIN_HIDDEN_LINES) {
-                // 너무 적으면 그냥 제거하고 changes에 포함
-                result.pop();
-              }
-            }
-          }
-        }
-
-        // 연속된 변경사항 찾기
-        let changeEnd = i;
-        while (changeEnd < diffView.length && diffView[changeEnd].type !== 'same') {
-          changeEnd++;
-        }
+      const skip = diffView[i].skip;
 
-        // 뒤쪽 컨텍스트 포함
-        const contextEnd = Math.min(diffView.length - 1, changeEnd + CONTEXT_LINES - 1);
-
-        // 실제 시작점 결정 (이전 hunk 이후부터)
-        let actualStart = contextStart;
-        if (result.length > 0) {
-          const lastHunk = result[result.length - 1];
-          actualStart = Math.max(contextStart, lastHunk.endIndex + 1);
-        }
-
-        result.push({
-          id: `changes-${actualStart}`,
-          type: 'changes',
-          startIndex: actualStart,
-          endIndex: contextEnd,
-          lines: diffView.slice(actualStart, contextEnd + 1),
-        });
-
-        i = contextEnd + 1;
-      } else {
-        // 같은 줄들의 시작
-        const sameStart = i;
-        while (i < diffView.length && diffView[i].type === 'same') {
-          i++;
-        }
-        const sameEnd = i - 1;
-
-        // 이전 hunk의 끝 이후부터 시작
-        let actualStart = sameStart;
-        if (result.length > 0) {
-          const lastHunk = result[result.length - 1];
-          actualStart = Math.max(sameStart, lastHunk.endIndex + 1);
-        }
+      if (skip && skip.count >= MIN_HIDDEN_LINES) {
+        result.push({ id: `hidden-${i}`, type: 'hidden', startIndex: i, endIndex: i, lines: [], skip });
+        i++;
+        continue;
+      }
 
-        if (actualStart <= sameEnd) {
-          const lineCount = sameEnd - actualStart + 1;
-          if (lineCount >= MIN_HIDDEN_LINES) {
-            // 숨김 처리
-            result.push({
-              id: `hidden-${actualStart}`,
-              type: 'hidden',
-              startIndex: actualStart,
-              endIndex: sameEnd,
-              lines: diffView.slice(actualStart, sameEnd + 1),
-            });
-          } else {
-            // 너무 적으면 그냥 표시 (이전 changes에 합침 또는 새 changes 생성)
-            if (result.length > 0 && result[result.length - 1].type === 'changes') {
-              const lastHunk = result[result.length - 1];
-              lastHunk.endIndex = sameEnd;
-              lastHunk.lines = diffView.slice(lastHunk.startIndex, sameEnd + 1);
-            } else {
-              result.push({
-                id: `changes-${actualStart}`,
-                type: 'changes',
-                startIndex: actualStart,
-                endIndex: sameEnd,
-                lines: diffView.slice(actualStart, sameEnd + 1),
-              });
-            }
-          }
-        }
+      // 다음 숨김 전까지의 줄들 (짧은 skip 은 펼쳐서 포함)
+      const changesStart = i;
+      const lines: DiffPair[] = [];
+      while (i < diffView.length) {
+        const pair = diffView[i];
+        if (pair.skip && pair.skip.count >= MIN_HIDDEN_LINES) break;
+        if (pair.skip) lines.push(...skippedPairs(pair.skip, sourceLines.base, sourceLines.compare));
+        else lines.push(pair);
+        i++;
       }
+      result.push({ id: `changes-${changesStart}`, type: 'changes', startIndex: changesStart, endIndex: i - 1, lines });
     }
 
     return result;
-  }, [diffView]);
+  }, [diffView, sourceLines]);
+
+  // 접힌 줄까지 포함한 전체 행 수
+  const totalRows = useMemo(
+    () => (diffView ? diffView.reduce((sum, pair) => sum + (pair.skip ? pair.skip.count : 1), 0) : 0),
+    [diffView],
+  );
 
   // 변경사항 통계
   const changeStats = useMemo(() => {
@@ -189,12 +169,12 @@ export default function IndexPage({ className, ...props }: IndexPageProps) {
 
     while (i < hunks.length && lineCount < maxVisibleLines) {
       const hunk = hunks[i];
-      const hunkLineCount = hunk.lines.length;
+      const count = hunkLineCount(hunk);
 
-      if (lineCount + hunkLineCount <= maxVisibleLines) {
+      if (lineCount + count <= maxVisibleLines) {
         // 전체 hunk 포함
         result.push(hunk);
-        lineCount += hunkLineCount;
+        lineCount += count;
       } else {
         // 부분적으로 포함 (hunk를 자르기)
         const remainingCapacity = maxVisibleLines - lineCount;
@@ -202,8 +182,8 @@ export default function IndexPage({ className, ...props }: IndexPageProps) {
           result.push({
             ...hunk,
             id: `${hunk.id}-partial`,
-            endIndex: hunk.startIndex + remainingCapacity - 1,
             lines: hunk.lines.slice(0, remainingCapacity),
+            skip: hunk.skip && { ...hunk.skip, count: remainingCapacity },
           });
           lineCount += remainingCapacity;
         }
@@ -213,7 +193,7 @@ export default function IndexPage({ className, ...props }: IndexPageProps) {
     }
 
     // 전체 라인 수 계산
-    const totalLines = hunks.reduce((sum, h) => sum + h.lines.length, 0);
+    const totalLines = hunks.reduce((sum, h) => sum + hunkLineCount(h), 0);
     const remaining = totalLines - lineCount;
 
     return {
@@ -270,6 +250,7 @@ export default function IndexPage({ className, ...props }: IndexPageProps) {
     try {
       setLoading(true);
       setPerformanceMetrics(null);
+      setDegraded([]);
       setProgress(null);
 
       // 파일 읽기 시간 측정
@@ -282,11 +263,21 @@ export default function IndexPage({ className, ...props }: IndexPageProps) {
         `파일 크기: Base=${(baseText.length / 1024).toFixed(2)}KB, Compare=${(changedText.length / 1024).toFixed(2)}KB`,
       );
 
+      // 앞/뒤 공통 줄 잘라내기는 결과가 같으므로 항상 사용
+      // 같은 줄은 변경 앞뒤 CONTEXT_LINES 줄만 받고 나머지는 skip 으로 접어서 받음
+      const diffOptions: DiffOptions = {
+        algorithm,
+        trimCommon: true,
+        tokenMode,
+        budget: DIFF_BUDGET,
+        context: CONTEXT_LINES,
+      };
+
       // 스트리밍 처리를 사용한 diff 연산
       const streamResult: StreamDiffResult =
         mode === 'cpp'
-          ? await streamDiffWasm({ baseText, compareText: changedText, onProgress })
-          : await streamDiffJs(baseText, changedText, onProgress);
+          ? await streamDiffWasm({ baseText, compareText: changedText, onProgress, diffOptions })
+          : await streamDiffJs(baseText, changedText, onProgress, diffOptions);
 
       if (streamResult && streamResult.response) {
         // 파싱 시간 측정
@@ -295,7 +286,9 @@ export default function IndexPage({ className, ...props }: IndexPageProps) {
         const parseTime = performance.now() - parseStart;
 
         console.log('파싱된 diffData:', diffData);
+        setSourceLines({ base: splitLines(baseText), compare: splitLines(changedText) });
         setDiffView(diffData);
+        setDegraded(streamResult.response.degraded ?? []);
 
         // 결과 통계 계산
         const stats = diffData.reduce(
@@ -314,7 +307,7 @@ export default function IndexPage({ className, ...props }: IndexPageProps) {
           fileReadTime,
           parseTime,
           totalTime: streamResult.metrics.totalTime + fileReadTime + parseTime,
-          totalLines: diffData.length,
+          totalLines: diffData.reduce((sum, pair) => sum + (pair.skip ? pair.skip.count : 1), 0),
           addedLines: stats.added,
           deletedLines: stats.deleted,
           changedLines: stats.changed,
@@ -376,6 +369,34 @@ export default function IndexPage({ className, ...props }: IndexPageProps) {
               </Label>
             </div>
           </RadioGroup>
+          <RadioGroup
+            value={algorithm}
+            onValueChange={(val) => setAlgorithm(val as DiffAlgorithm)}
+            className="mb-4 flex flex-wrap justify-start gap-4"
+          >
+            {ALGORITHM_CHOICES.map((choice) => (
+              <div key={choice.value} className="flex items-center gap-2">
+                <RadioGroupItem value={choice.value} id={`algorithm-${choice.value}`} />
+                <Label htmlFor={`algorithm-${choice.value}`} className="cursor-pointer text-slate-600">
+                  {choice.label}
+                </Label>
+              </div>
+            ))}
+          </RadioGroup>
+          <RadioGroup
+            value={tokenMode}
+            onValueChange={(val) => setTokenMode(val as TokenMode)}
+            className="mb-4 flex flex-wrap justify-start gap-4"
+          >
+            {TOKEN_MODE_CHOICES.map((choice) => (
+              <div key={choice.value} className="flex items-center gap-2">
+                <RadioGroupItem value={choice.value} id={`token-mode-${choice.value}`} />
+                <Label htmlFor={`token-mode-${choice.value}`} className="cursor-pointer text-slate-600">
+                  {choice.label}
+                </Label>
+              </div>
+            ))}
+          </RadioGroup>
           <Upload files={files} onChange={setFiles} />
           {files && (
             <Button variant="outline" className="h-[46px] w-full" onClick={handleCompare} disabled={loading}>
@@ -438,7 +459,7 @@ export default function IndexPage({ className, ...props }: IndexPageProps) {
                 {/* 변경사항 통계 */}
                 <div className="mb-3 flex flex-wrap items-center gap-3 text-sm">
                   <span className="text-slate-600">
-                    {totalVisibleLines.toLocaleString()} / {diffView.length.toLocaleString()}행 표시 중:
+                    {totalVisibleLines.toLocaleString()} / {totalRows.toLocaleString()}행 표시 중:
                   </span>
                   {changeStats.added > 0 && (
                     <span className="rounded bg-green-100 px-2 py-0.5 text-green-700">
@@ -455,6 +476,14 @@ export default function IndexPage({ className, ...props }: IndexPageProps) {
                       ~{changeStats.changed.toLocaleString()} 수정
                     </span>
                   )}
+                  {degraded.length > 0 && (
+                    <span
+                      className="rounded bg-orange-100 px-2 py-0.5 text-orange-700"
+                      title="비교 비용 상한에 걸려 일부 구간은 최소 diff 대신 삭제/추가로 표시됩니다"
+                    >
+                      근사 결과 ({degraded.map((reason) => DEGRADED_LABELS[reason]).join(', ')} 상한)
+                    </span>
+                  )}
                   <div className="ml-auto flex gap-2">
                     <Button variant="ghost" size="sm" onClick={expandAll} className="text-xs">
                       모두 펼치기
@@ -480,7 +509,7 @@ export default function IndexPage({ className, ...props }: IndexPageProps) {
                     // 숨겨진 영역
                     if (hunk.type === 'hidden') {
                       const isExpanded = expandedHunks[hunk.id];
-                      const hiddenCount = hunk.lines.length;
+                      const hiddenCount = hunkLineCount(hunk);
 
                       if (isExpanded) {
                         // 펼쳐진 상태: 라인들 표시 + 접기 버튼
@@ -493,7 +522,7 @@ export default function IndexPage({ className, ...props }: IndexPageProps) {
                               <ChevronUp className="h-3 w-3" />
                               {hiddenCount.toLocaleString()}줄 접기
                             </button>
-                            {hunk.lines.map((pair, idx) => (
+                            {skippedPairs(hunk.skip!, sourceLines.base, sourceLines.compare).map((pair, idx) => (
                               <DiffRow key={`${hunk.id}-${idx}`} pair={pair} />
                             ))}
                           </div>
@@ -536,9 +565,9 @@ export default function IndexPage({ className, ...props }: IndexPageProps) {
                 )}
 
                 {/* 모두 표시됨 */}
-                {!hasMoreLines && diffView.length > MAX_VISIBLE_LINES && (
+                {!hasMoreLines && totalRows > MAX_VISIBLE_LINES && (
                   <div className="mt-4 text-center text-sm text-slate-500">
-                    ✓ 모든 {diffView.length.toLocaleString()}행을 표시했습니다
+                    ✓ 모든 {totalRows.toLocaleString()}행을 표시했습니다
                   </div>
                 )}
               </div>
@@ -1,11 +1,99 @@
 import type { WasmDiffResponse, WasmDiffItem, WordToken } from '@/utils/diff';
 
 // ------------------------------------------------------------
-// 줄 단위 diff 결과를 담는 구조체
+// 줄 단위 diff 알고리즘 선택 (C++ DiffAlgorithm 과 동일한 구성)
 // ------------------------------------------------------------
-interface Edit {
+export type DiffAlgorithm = 'myers' | 'myers-linear' | 'patience' | 'histogram';
+
+// replace 줄 안의 토큰 단위 (C++ TokenMode 와 동일)
+export type TokenMode = 'word' | 'char';
+
+// 줄 diff 비용 상한 (C++ DiffBudget 과 동일, 0 또는 없으면 제한 없음)
+// 상한에 걸리면 결과는 유효하지만 최소 diff 가 아닐 수 있고 response.degraded 에 이유가 붙음
+export interface DiffBudget {
+  maxCost?: number; // Myers 탐색 한 번의 최대 D
+  maxMemoryMb?: number; // Myers 탐색 상태의 최대 크기 (MB)
+  timeLimitMs?: number; // 줄 diff 한 번의 제한 시간
+}
+
+export interface DiffOptions {
+  algorithm?: DiffAlgorithm;
+  trimCommon?: boolean; // Myers 계열에서 앞/뒤 공통 줄을 먼저 잘라냄
+  tokenMode?: TokenMode; // 기본: 띄어쓰기 기준 단어
+  budget?: DiffBudget; // WASM 엔진에서만 적용 (JS 엔진은 항상 최소 diff)
+  context?: number; // 0 이상이면 streamDiff* 결과에서 변경 앞뒤 context 줄만 남기고 같은 줄은 skip row 로 접음
+  // 줄 비교 정규화 (C++ LINE_IGNORE_*), 결과 row 에는 원문 줄이 그대로 나감
+  ignoreTrailingCr?: boolean; // 줄 끝 '\r' 무시 (CRLF 와 LF 를 같게)
+  ignoreAllSpace?: boolean; // 공백 모두 무시
+  ignoreSpaceChange?: boolean; // 공백 개수 차이와 줄 끝 공백 무시
+  ignoreCase?: boolean; // ASCII 대소문자 무시
+}
+
+// C++ enum class DiffAlgorithm 의 값
+export const DIFF_ALGORITHM_CODES: Record<DiffAlgorithm, number> = {
+  myers: 0,
+  'myers-linear': 1,
+  patience: 2,
+  histogram: 3,
+};
+
+// C++ DIFF_FLAG_* 비트
+export const DIFF_FLAG_TRIM_COMMON = 1 << 0;
+export const DIFF_FLAG_CHAR_TOKENS = 1 << 1;
+export const DIFF_FLAG_IGNORE_CR = 1 << 2;
+export const DIFF_FLAG_IGNORE_ALL_SPACE = 1 << 3;
+export const DIFF_FLAG_IGNORE_SPACE_CHANGE = 1 << 4;
+export const DIFF_FLAG_IGNORE_CASE = 1 << 5;
+
+export function toDiffFlags(options: DiffOptions): number {
+  let flags = 0;
+  if (options.trimCommon) flags |= DIFF_FLAG_TRIM_COMMON;
+  if (options.tokenMode === 'char') flags |= DIFF_FLAG_CHAR_TOKENS;
+  if (options.ignoreTrailingCr) flags |= DIFF_FLAG_IGNORE_CR;
+  if (options.ignoreAllSpace) flags |= DIFF_FLAG_IGNORE_ALL_SPACE;
+  if (options.ignoreSpaceChange) flags |= DIFF_FLAG_IGNORE_SPACE_CHANGE;
+  if (options.ignoreCase) flags |= DIFF_FLAG_IGNORE_CASE;
+  return flags;
+}
+
+// ------------------------------------------------------------
+// 줄 비교 정규화 (C++ NormalizedLineCursor 와 같은 규칙)
+//   - 공백: ' ', '\t', '\r', '\v', '\f'
+//   - 대소문자: ASCII 만
+//   JS 엔진은 문자열 비교 / Map 키로 줄을 맞추므로 정규화한 비교 키를 줄마다 만든다
+//   (C++ 처럼 원문을 가리키는 view 가 없음). 정규화 옵션이 없으면 null
+// ------------------------------------------------------------
+export type LineNormalizer = (line: string) => string;
+
+const TRAILING_SPACE = /[ \t\r\v\f]+$/;
+const SPACE_RUN = /[ \t\r\v\f]+/g;
+const ASCII_UPPER = /[A-Z]+/g;
+
+export function lineNormalizer(options: DiffOptions): LineNormalizer | null {
+  const { ignoreTrailingCr, ignoreAllSpace, ignoreSpaceChange, ignoreCase } = options;
+  if (!ignoreTrailingCr && !ignoreAllSpace && !ignoreSpaceChange && !ignoreCase) {
+    return null;
+  }
+  return (line: string) => {
+    let key = ignoreTrailingCr && line.endsWith('\r') ? line.slice(0, -1) : line;
+    if (ignoreAllSpace) {
+      key = key.replace(SPACE_RUN, '');
+    } else if (ignoreSpaceChange) {
+      key = key.replace(TRAILING_SPACE, '').replace(SPACE_RUN, ' ');
+    }
+    if (ignoreCase) {
+      key = key.replace(ASCII_UPPER, (upper) => upper.toLowerCase());
+    }
+    return key;
+  };
+}
+
+// ------------------------------------------------------------
+// diff 결과를 담는 구조체 (T: 줄 / 단어 / 글자 토큰)
+// ------------------------------------------------------------
+interface Edit<T = string> {
   op: ' ' | '-' | '+'; // ' ' (equal), '-' (delete), '+' (insert)
-  text: string;
+  text: T;
 }
 
 // ------------------------------------------------------------
@@ -15,31 +103,17 @@ function splitLines(text: string): string[] {
   if (!text) {
     return [];
   }
-  // C++ splitLines logic: splits by \n, keeps accumulating.
-  // However, JS split('\n') is slightly different regarding trailing newlines compared to the C++ manual loop.
-  // The C++ loop:
+  // C++ splitLineViews 와 같은 규칙:
   // "A\nB" -> ["A", "B"]
   // "A\nB\n" -> ["A", "B", ""]
-  // Let's match the C++ logic exactly.
-  const lines: string[] = [];
-  let current = '';
-  for (let i = 0; i < text.length; i++) {
-    const c = text[i];
-    if (c === '\n') {
-      lines.push(current);
-      current = '';
-    } else {
-      current += c;
-    }
-  }
-  lines.push(current);
-  return lines;
+  // 빈 문자열이 아니면 split('\n') 결과와 같으므로 엔진의 split 으로 한 번에 자름
+  return text.split('\n');
 }
 
 // ------------------------------------------------------------
-// Myers 알고리즘: 줄 단위 diff
+// Myers 알고리즘: 줄 단위 diff (큰 단어 / 글자 토큰 배열에도 같은 함수를 씀)
 // ------------------------------------------------------------
-function myersDiff(a: string[], b: string[]): Edit[] {
+function myersDiff<T>(a: T[], b: T[]): Edit<T>[] {
   const n = a.length;
   const m = b.length;
   const maxD = n + m;
@@ -111,7 +185,7 @@ function myersDiff(a: string[], b: string[]): Edit[] {
   // Backtracking
   let x = n;
   let y = m;
-  const edits: Edit[] = [];
+  const edits: Edit<T>[] = [];
 
   for (let d = finalD; d > 0; d--) {
     const vPrev = trace[d - 1];
@@ -159,37 +233,362 @@ function myersDiff(a: string[], b: string[]): Edit[] {
   return edits.reverse();
 }
 
+// ------------------------------------------------------------
+// 같은 줄 쌍 (기준 줄 번호, 변경 줄 번호)
+// ------------------------------------------------------------
+interface LineMatch {
+  aIndex: number;
+  bIndex: number;
+}
+
+// ------------------------------------------------------------
+// a[aLo, aHi), b[bLo, bHi) 구간을 Myers 로 처리해 같은 줄 쌍을 out 에 추가
+// ------------------------------------------------------------
+function myersMatches<T>(
+  a: T[],
+  b: T[],
+  aLo: number,
+  aHi: number,
+  bLo: number,
+  bHi: number,
+  out: LineMatch[],
+): void {
+  const edits = myersDiff(a.slice(aLo, aHi), b.slice(bLo, bHi));
+  let x = aLo;
+  let y = bLo;
+  for (const e of edits) {
+    if (e.op === ' ') {
+      out.push({ aIndex: x, bIndex: y });
+      x++;
+      y++;
+    } else if (e.op === '-') {
+      x++;
+    } else {
+      y++;
+    }
+  }
+}
+
+// ------------------------------------------------------------
+// 앞/뒤 공통 구간 잘라내기 (앞쪽 match 는 out 에 바로 추가, 뒤쪽 줄 수 반환)
+// ------------------------------------------------------------
+interface LineRange {
+  aLo: number;
+  aHi: number;
+  bLo: number;
+  bHi: number;
+}
+
+function trimCommonEnds(a: string[], b: string[], range: LineRange, out: LineMatch[]): number {
+  while (range.aLo < range.aHi && range.bLo < range.bHi && a[range.aLo] === b[range.bLo]) {
+    out.push({ aIndex: range.aLo, bIndex: range.bLo });
+    range.aLo++;
+    range.bLo++;
+  }
+  let suffix = 0;
+  while (range.aHi > range.aLo && range.bHi > range.bLo && a[range.aHi - 1] === b[range.bHi - 1]) {
+    range.aHi--;
+    range.bHi--;
+    suffix++;
+  }
+  return suffix;
+}
+
+function pushSuffixMatches(range: LineRange, suffix: number, out: LineMatch[]): void {
+  for (let i = 0; i < suffix; i++) {
+    out.push({ aIndex: range.aHi + i, bIndex: range.bHi + i });
+  }
+}
+
+// ------------------------------------------------------------
+// Patience diff: 양쪽에 한 번씩만 나오는 줄 중 순서가 유지되는 가장 긴 열을 앵커로 사용
+// ------------------------------------------------------------
+function patienceMatches(a: string[], b: string[], initial: LineRange, out: LineMatch[]): void {
+  const range = { ...initial };
+  const suffix = trimCommonEnds(a, b, range, out);
+  const { aLo, aHi, bLo, bHi } = range;
+
+  if (aLo < aHi && bLo < bHi) {
+    const counts = new Map<string, { countA: number; countB: number; bIndex: number }>();
+    for (let i = aLo; i < aHi; i++) {
+      const entry = counts.get(a[i]);
+      if (entry) entry.countA++;
+      else counts.set(a[i], { countA: 1, countB: 0, bIndex: -1 });
+    }
+    for (let j = bLo; j < bHi; j++) {
+      const entry = counts.get(b[j]);
+      if (entry) {
+        entry.countB++;
+        entry.bIndex = j;
+      }
+    }
+
+    const candidates: LineMatch[] = [];
+    for (let i = aLo; i < aHi; i++) {
+      const entry = counts.get(a[i])!;
+      if (entry.countA === 1 && entry.countB === 1) {
+        candidates.push({ aIndex: i, bIndex: entry.bIndex });
+      }
+    }
+
+    if (candidates.length === 0) {
+      myersMatches(a, b, aLo, aHi, bLo, bHi, out);
+    } else {
+      // patience sorting 으로 bIndex 의 최장 증가 부분열 찾기
+      const tails: number[] = [];
+      const prev: number[] = new Array(candidates.length).fill(-1);
+      for (let c = 0; c < candidates.length; c++) {
+        let lo = 0;
+        let hi = tails.length;
+        while (lo < hi) {
+          const mid = (lo + hi) >> 1;
+          if (candidates[tails[mid]].bIndex < candidates[c].bIndex) lo = mid + 1;
+          else hi = mid;
+        }
+        if (lo > 0) prev[c] = tails[lo - 1];
+        tails[lo] = c;
+      }
+
+      const anchors: LineMatch[] = [];
+      for (let c = tails[tails.length - 1]; c >= 0; c = prev[c]) {
+        anchors.push(candidates[c]);
+      }
+      anchors.reverse();
+
+      let x = aLo;
+      let y = bLo;
+      for (const anchor of anchors) {
+        patienceMatches(a, b, { aLo: x, aHi: anchor.aIndex, bLo: y, bHi: anchor.bIndex }, out);
+        out.push(anchor);
+        x = anchor.aIndex + 1;
+        y = anchor.bIndex + 1;
+      }
+      patienceMatches(a, b, { aLo: x, aHi, bLo: y, bHi }, out);
+    }
+  }
+
+  pushSuffixMatches(range, suffix, out);
+}
+
+// ------------------------------------------------------------
+// Histogram diff: 가장 드물게 나오는 줄을 포함하는 공통 영역을 앵커로 사용
+// ------------------------------------------------------------
+const HISTOGRAM_MAX_CHAIN_LENGTH = 64;
+
+function histogramMatches(a: string[], b: string[], initial: LineRange, out: LineMatch[]): void {
+  const range = { ...initial };
+  const suffix = trimCommonEnds(a, b, range, out);
+  const { aLo, aHi, bLo, bHi } = range;
+
+  if (aLo < aHi && bLo < bHi) {
+    // 줄 내용 -> a 구간 안의 등장 위치 목록
+    const positions = new Map<string, number[]>();
+    for (let i = aLo; i < aHi; i++) {
+      const list = positions.get(a[i]);
+      if (list) list.push(i);
+      else positions.set(a[i], [i]);
+    }
+    const countOf = (line: string) => positions.get(line)?.length ?? 0;
+
+    let bestCount = HISTOGRAM_MAX_CHAIN_LENGTH + 1;
+    let bestLength = 0;
+    let bestA = 0;
+    let bestB = 0;
+
+    for (let j = bLo; j < bHi; ) {
+      const list = positions.get(b[j]);
+      if (!list || list.length > bestCount) {
+        j++;
+        continue;
+      }
+
+      let nextJ = j + 1;
+      for (const i of list) {
+        let as = i;
+        let bs = j;
+        let ae = i + 1;
+        let be = j + 1;
+        let regionCount = list.length;
+
+        while (as > aLo && bs > bLo && a[as - 1] === b[bs - 1]) {
+          as--;
+          bs--;
+          regionCount = Math.min(regionCount, countOf(a[as]));
+        }
+        while (ae < aHi && be < bHi && a[ae] === b[be]) {
+          regionCount = Math.min(regionCount, countOf(a[ae]));
+          ae++;
+          be++;
+        }
+
+        const length = ae - as;
+        if (regionCount < bestCount || (regionCount === bestCount && length > bestLength)) {
+          bestCount = regionCount;
+          bestLength = length;
+          bestA = as;
+          bestB = bs;
+        }
+        nextJ = Math.max(nextJ, be);
+      }
+      j = nextJ;
+    }
+
+    if (bestLength === 0) {
+      myersMatches(a, b, aLo, aHi, bLo, bHi, out);
+    } else {
+      histogramMatches(a, b, { aLo, aHi: bestA, bLo, bHi: bestB }, out);
+      for (let k = 0; k < bestLength; k++) {
+        out.push({ aIndex: bestA + k, bIndex: bestB + k });
+      }
+      histogramMatches(a, b, { aLo: bestA + bestLength, aHi, bLo: bestB + bestLength, bHi }, out);
+    }
+  }
+
+  pushSuffixMatches(range, suffix, out);
+}
+
+// ------------------------------------------------------------
+// 같은 줄 쌍 목록 -> 편집 목록 (빈 구간은 "삭제 블록 -> 추가 블록" 순서)
+// ------------------------------------------------------------
+function editsFromMatches(a: string[], b: string[], matches: LineMatch[]): Edit[] {
+  const edits: Edit[] = [];
+  let x = 0;
+  let y = 0;
+  const fillGap = (xEnd: number, yEnd: number) => {
+    for (; x < xEnd; x++) edits.push({ op: '-', text: a[x] });
+    for (; y < yEnd; y++) edits.push({ op: '+', text: b[y] });
+  };
+
+  for (const match of matches) {
+    fillGap(match.aIndex, match.bIndex);
+    edits.push({ op: ' ', text: a[x] });
+    x++;
+    y++;
+  }
+  fillGap(a.length, b.length);
+  return edits;
+}
+
+// ------------------------------------------------------------
+// 옵션에 따라 줄 단위 diff 실행
+//   - JS 에는 선형 공간 Myers 가 따로 없으므로 'myers-linear' 는 Myers 로 처리
+// ------------------------------------------------------------
+function lineDiff(a: string[], b: string[], options: DiffOptions): Edit[] {
+  const algorithm = options.algorithm ?? 'myers';
+  const full: LineRange = { aLo: 0, aHi: a.length, bLo: 0, bHi: b.length };
+
+  if (algorithm === 'patience' || algorithm === 'histogram') {
+    const matches: LineMatch[] = [];
+    if (algorithm === 'patience') patienceMatches(a, b, full, matches);
+    else histogramMatches(a, b, full, matches);
+    return editsFromMatches(a, b, matches);
+  }
+
+  if (options.trimCommon) {
+    const matches: LineMatch[] = [];
+    const range = { ...full };
+    const suffix = trimCommonEnds(a, b, range, matches);
+    myersMatches(a, b, range.aLo, range.aHi, range.bLo, range.bHi, matches);
+    pushSuffixMatches(range, suffix, matches);
+    return editsFromMatches(a, b, matches);
+  }
+
+  return myersDiff(a, b);
+}
+
 // ------------------------------------------------------------
 // 공백(스페이스) 기준으로 "단어"들을 잘라내는 함수
+//   - 문자를 하나씩 이어 붙이지 않고 공백 위치(indexOf)로 원본을 잘라냄
+//   - 연속된 공백 사이의 빈 단어는 건너뜀
 // ------------------------------------------------------------
 function splitWordsBySpace(line: string): string[] {
   const result: string[] = [];
-  let word = '';
-
-  for (let i = 0; i < line.length; i++) {
-    const c = line[i];
-    if (c === ' ') {
-      if (word.length > 0) {
-        result.push(word);
-        word = '';
-      }
-    } else {
-      word += c;
+  let wordStart = 0;
+
+  for (let space = line.indexOf(' '); space !== -1; space = line.indexOf(' ', wordStart)) {
+    if (space > wordStart) {
+      result.push(line.slice(wordStart, space));
     }
+    wordStart = space + 1;
   }
-  if (word.length > 0) {
-    result.push(word);
+  if (line.length > wordStart) {
+    result.push(line.slice(wordStart));
+  }
+  return result;
+}
+
+// ------------------------------------------------------------
+// 글자 단위로 자르는 함수 (C++ splitUtf8Chars 와 같은 규칙)
+//   - 코드 포인트 하나에 뒤따르는 결합 문자 / 이체 선택자 / 피부색 / 한글 중성·종성 자모,
+//     ZWJ 로 이어진 다음 코드 포인트, 국기(지역 표시 문자 두 개)를 한 글자로 묶음
+// ------------------------------------------------------------
+const ZWJ = 0x200d;
+
+function isClusterExtender(cp: number): boolean {
+  return (
+    (cp >= 0x0300 && cp <= 0x036f) ||
+    (cp >= 0x1ab0 && cp <= 0x1aff) ||
+    (cp >= 0x1dc0 && cp <= 0x1dff) ||
+    (cp >= 0x20d0 && cp <= 0x20ff) ||
+    (cp >= 0xfe00 && cp <= 0xfe0f) ||
+    (cp >= 0xfe20 && cp <= 0xfe2f) ||
+    (cp >= 0x1160 && cp <= 0x11ff) ||
+    (cp >= 0xd7b0 && cp <= 0xd7ff) ||
+    (cp >= 0x1f3fb && cp <= 0x1f3ff) ||
+    (cp >= 0xe0100 && cp <= 0xe01ef) ||
+    cp === ZWJ
+  );
+}
+
+function isRegionalIndicator(cp: number): boolean {
+  return cp >= 0x1f1e6 && cp <= 0x1f1ff;
+}
+
+function splitChars(line: string): string[] {
+  const result: string[] = [];
+  let current = '';
+  let joinNext = false;
+  let flagOpen = false;
+
+  for (const ch of line) {
+    const cp = ch.codePointAt(0)!;
+    if (current && (joinNext || (flagOpen && isRegionalIndicator(cp)) || isClusterExtender(cp))) {
+      current += ch;
+      joinNext = cp === ZWJ;
+      flagOpen = false;
+      continue;
+    }
+    if (current) result.push(current);
+    current = ch;
+    joinNext = cp === ZWJ;
+    flagOpen = isRegionalIndicator(cp);
   }
+  if (current) result.push(current);
   return result;
 }
 
 // ------------------------------------------------------------
-// 한 줄(oldLine, newLine)에 대해 "단어 단위 diff" 를 계산
+// 같은 op 가 이어지는 글자 토큰을 하나로 합침 (C++ 글자 단위 모드와 같은 결과)
 // ------------------------------------------------------------
-function makeWordTokens(oldLine: string, newLine: string): WordToken[] {
-  const a = splitWordsBySpace(oldLine);
-  const b = splitWordsBySpace(newLine);
+function mergeCharTokens(tokens: WordToken[]): WordToken[] {
+  const merged: WordToken[] = [];
+  for (const token of tokens) {
+    if (!token.left && !token.right) continue;
+    const last = merged[merged.length - 1];
+    if (last && last.op === token.op) {
+      last.left += token.left;
+      last.right += token.right;
+    } else {
+      merged.push({ ...token });
+    }
+  }
+  return merged;
+}
 
+// ------------------------------------------------------------
+// 토큰 배열 두 개를 LCS 로 정렬
+// ------------------------------------------------------------
+function lcsTokens(a: string[], b: string[]): WordToken[] {
   const n = a.length;
   const m = b.length;
 
@@ -231,16 +630,96 @@ function makeWordTokens(oldLine: string, newLine: string): WordToken[] {
   return revTokens.reverse();
 }
 
+// LCS 로 정렬하는 최대 크기 (C++ SequenceDiffer::LCS_MAX_CELLS 와 같음)
+const TOKEN_LCS_MAX_CELLS = 1 << 22;
+
+// ------------------------------------------------------------
+// 토큰 배열 두 개의 정렬 (C++ SequenceDiffer 와 같은 규칙)
+//   - 토큰 수의 곱이 TOKEN_LCS_MAX_CELLS 이하면 LCS
+//   - 넘으면 줄 diff 와 같은 Myers 로 같은 토큰 쌍을 구하고, 사이 구간은 delete 블록 -> insert 블록
+//     (편집 수는 최소지만 같은 길이의 정렬 중 어느 것을 고르는지는 C++ 선형 공간 Myers 와 다를 수 있음)
+// ------------------------------------------------------------
+function alignTokenArrays(a: string[], b: string[]): WordToken[] {
+  if (a.length * b.length <= TOKEN_LCS_MAX_CELLS) {
+    return lcsTokens(a, b);
+  }
+
+  const matches: LineMatch[] = [];
+  myersMatches(a, b, 0, a.length, 0, b.length, matches);
+  const tokens: WordToken[] = [];
+  let x = 0;
+  let y = 0;
+  const fillGap = (xEnd: number, yEnd: number) => {
+    for (; x < xEnd; x++) tokens.push({ op: 'delete', left: a[x], right: '' });
+    for (; y < yEnd; y++) tokens.push({ op: 'insert', left: '', right: b[y] });
+  };
+  for (const match of matches) {
+    fillGap(match.aIndex, match.bIndex);
+    tokens.push({ op: 'equal', left: a[x], right: b[y] });
+    x++;
+    y++;
+  }
+  fillGap(a.length, b.length);
+  return tokens;
+}
+
+// ------------------------------------------------------------
+// 글자 단위 정렬: 같은 앞 / 뒤 글자는 equal 로 두고 가운데만 정렬
+// ------------------------------------------------------------
+function makeCharTokens(oldLine: string, newLine: string): WordToken[] {
+  const a = splitChars(oldLine);
+  const b = splitChars(newLine);
+
+  let prefix = 0;
+  while (prefix < a.length && prefix < b.length && a[prefix] === b[prefix]) prefix++;
+  let suffix = 0;
+  while (
+    suffix < a.length - prefix &&
+    suffix < b.length - prefix &&
+    a[a.length - 1 - suffix] === b[b.length - 1 - suffix]
+  ) {
+    suffix++;
+  }
+
+  const aMiddle = a.slice(prefix, a.length - suffix);
+  const bMiddle = b.slice(prefix, b.length - suffix);
+  const same = a.slice(0, prefix).join('');
+  const tail = a.slice(a.length - suffix).join('');
+
+  const tokens: WordToken[] = [{ op: 'equal', left: same, right: same }];
+  for (const token of alignTokenArrays(aMiddle, bMiddle)) tokens.push(token);
+  tokens.push({ op: 'equal', left: tail, right: tail });
+  return mergeCharTokens(tokens);
+}
+
+// ------------------------------------------------------------
+// 한 줄(oldLine, newLine)에 대해 단어 / 글자 단위 diff 를 계산
+// ------------------------------------------------------------
+function makeWordTokens(oldLine: string, newLine: string, tokenMode: TokenMode = 'word'): WordToken[] {
+  if (tokenMode === 'char') return makeCharTokens(oldLine, newLine);
+  return alignTokenArrays(splitWordsBySpace(oldLine), splitWordsBySpace(newLine));
+}
+
 // ------------------------------------------------------------
 // 메인 JS diff 함수
+//   - 정규화 옵션이 있으면 비교 키로 줄 diff 를 하고, row 에는 편집 순서대로 원문 줄을 넣음
 // ------------------------------------------------------------
-export function diffTextJs(baseText: string, changedText: string): WasmDiffResponse {
-  const baseLines = splitLines(baseText);
-  const changedLines = splitLines(changedText);
+export function diffTextJs(baseText: string, changedText: string, options: DiffOptions = {}): WasmDiffResponse {
+  return diffLinesJs(splitLines(baseText), splitLines(changedText), options);
+}
 
-  const edits = myersDiff(baseLines, changedLines);
+// ------------------------------------------------------------
+// 이미 나눠 둔 줄 배열의 JS diff (증분 diff 처럼 파일 일부 줄만 다시 비교할 때)
+// ------------------------------------------------------------
+export function diffLinesJs(baseLines: string[], changedLines: string[], options: DiffOptions = {}): WasmDiffResponse {
+  const normalize = lineNormalizer(options);
+  const edits = normalize
+    ? lineDiff(baseLines.map(normalize), changedLines.map(normalize), options)
+    : lineDiff(baseLines, changedLines, options);
 
   const resultRows: WasmDiffItem[] = [];
+  let x = 0; // 다음 기준 줄 번호
+  let y = 0; // 다음 변경 줄 번호
 
   for (let i = 0; i < edits.length; i++) {
     const e = edits[i];
@@ -248,8 +727,8 @@ export function diffTextJs(baseText: string, changedText: string): WasmDiffRespo
     if (e.op === ' ') {
       resultRows.push({
         op: 'equal',
-        left: e.text,
-        right: e.text,
+        left: baseLines[x++],
+        right: changedLines[y++],
         left_start: -1,
         left_end: -1,
         right_start: -1,
@@ -259,13 +738,14 @@ export function diffTextJs(baseText: string, changedText: string): WasmDiffRespo
     } else if (e.op === '-') {
       // Check if next is '+'
       if (i + 1 < edits.length && edits[i + 1].op === '+') {
-        const nextE = edits[i + 1];
-        const tokens = makeWordTokens(e.text, nextE.text);
+        const left = baseLines[x++];
+        const right = changedLines[y++];
+        const tokens = makeWordTokens(left, right, options.tokenMode);
 
         resultRows.push({
           op: 'replace',
-          left: e.text,
-          right: nextE.text,
+          left,
+          right,
           left_start: -1,
           left_end: -1,
           right_start: -1,
@@ -276,7 +756,7 @@ export function diffTextJs(baseText: string, changedText: string): WasmDiffRespo
       } else {
         resultRows.push({
           op: 'delete',
-          left: e.text,
+          left: baseLines[x++],
           right: '',
           left_start: -1,
           left_end: -1,
@@ -289,7 +769,7 @@ export function diffTextJs(baseText: string, changedText: string): WasmDiffRespo
       resultRows.push({
         op: 'insert',
         left: '',
-        right: e.text,
+        right: changedLines[y++],
         left_start: -1,
         left_end: -1,
         right_start: -1,
@@ -4,8 +4,10 @@ export type WordToken = {
   right: string;
 };
 
+// op 가 'skip' 이면 같은 줄 count 개를 접은 row (DiffOptions.context, left / right / tokens 는 없음)
+// left_line / right_line 은 접힌 첫 줄의 [기준, 비교] 줄 번호로, 원문에서 skippedPairs 로 꺼내 봄
 export type WasmDiffItem = {
-  op: 'equal' | 'delete' | 'insert' | 'replace';
+  op: 'equal' | 'delete' | 'insert' | 'replace' | 'skip';
   left: string;
   right: string;
   left_start?: number;
@@ -13,10 +15,25 @@ export type WasmDiffItem = {
   right_start?: number;
   right_end?: number;
   tokens: WordToken[];
+  count?: number;
+  left_line?: number;
+  right_line?: number;
 };
 
+// 예산(DiffOptions.budget) 때문에 최소 diff 가 아닐 수 있는 이유 (C++ DIFF_DEGRADED_* 와 동일)
+export type DegradedReason = 'cost' | 'memory' | 'time';
+
 export type WasmDiffResponse = {
   rows: WasmDiffItem[];
+  degraded?: DegradedReason[]; // 상한에 걸리지 않았으면 없음
+  start?: [number, number]; // 일부 row 만 받은 경우 첫 row 앞의 [기준, 비교] 줄 수 (없으면 0, 0)
+};
+
+// 증분 diff 의 결과: 접지 않은 이전 row 목록의 [row, row + removed) 를 rows 로 바꿈
+// (start 는 rows 첫 row 앞의 [기준, 비교] 줄 수라서 parseDiffOutput 에 그대로 넣을 수 있음)
+export type DiffRowPatch = WasmDiffResponse & {
+  row: number;
+  removed: number;
 };
 
 export type DiffLine = {
@@ -28,24 +45,122 @@ export type DiffLine = {
   tokens?: WordToken[];
 };
 
+// 접힌 같은 줄 묶음: 기준 [leftLine, leftLine + count), 비교 [rightLine, rightLine + count)
+export type DiffSkip = {
+  count: number;
+  leftLine: number;
+  rightLine: number;
+};
+
 export type DiffPair = {
-  type: 'same' | 'change' | 'add' | 'delete';
+  type: 'same' | 'change' | 'add' | 'delete' | 'skip';
   before: DiffLine | null;
   after: DiffLine | null;
+  skip?: DiffSkip; // type 이 'skip' 일 때만
+};
+
+/**
+ * 같은 줄 묶음을 접은 응답 (C++ appendFoldedRowsJson 과 같은 규칙)
+ * - 변경 row 앞뒤로 context 개의 equal row 만 남기고 나머지는 skip row 하나로 바꿈
+ * - 파일 맨 앞 / 맨 뒤의 같은 줄 묶음은 변경 쪽 문맥만 남김
+ * - 이미 접힌 응답을 다시 넣어도 그대로 (context 가 없거나 음수면 접지 않음)
+ */
+export const foldDiffRows = (response: WasmDiffResponse, context?: number): WasmDiffResponse => {
+  if (context === undefined || context < 0) return response;
+
+  const rows = response.rows;
+  const folded: WasmDiffItem[] = [];
+  let leftLine = response.start?.[0] ?? 0;
+  let rightLine = response.start?.[1] ?? 0;
+  let i = 0;
+
+  while (i < rows.length) {
+    if (rows[i].op !== 'equal') {
+      const row = rows[i++];
+      const count = row.op === 'skip' ? (row.count ?? 0) : 1;
+      if (row.op !== 'insert') leftLine += count;
+      if (row.op !== 'delete') rightLine += count;
+      folded.push(row);
+      continue;
+    }
+
+    const runStart = i;
+    while (i < rows.length && rows[i].op === 'equal') i++;
+    const head = runStart === 0 ? 0 : context; // 앞 변경 뒤의 문맥
+    const tail = i === rows.length ? 0 : context; // 다음 변경 앞의 문맥
+    const runLength = i - runStart;
+
+    if (head + tail >= runLength) {
+      for (let k = runStart; k < i; k++) folded.push(rows[k]);
+    } else {
+      for (let k = runStart; k < runStart + head; k++) folded.push(rows[k]);
+      folded.push({
+        op: 'skip',
+        left: '',
+        right: '',
+        tokens: [],
+        count: runLength - head - tail,
+        left_line: leftLine + head,
+        right_line: rightLine + head,
+      });
+      for (let k = i - tail; k < i; k++) folded.push(rows[k]);
+    }
+    leftLine += runLength;
+    rightLine += runLength;
+  }
+
+  return { ...response, rows: folded };
+};
+
+/**
+ * 접힌 묶음의 [begin, end) 번째 줄을 원문에서 꺼내 'same' 쌍으로 만듦
+ * - 접힌 줄은 양쪽 내용이 같으므로 diff 를 다시 돌리지 않음
+ * - parseDiffOutput 과 같이 양쪽이 빈 줄인 row 는 건너뜀
+ */
+export const skippedPairs = (
+  skip: DiffSkip,
+  baseLines: string[],
+  compareLines: string[],
+  begin: number = 0,
+  end: number = skip.count,
+): DiffPair[] => {
+  const pairs: DiffPair[] = [];
+  for (let k = Math.max(0, begin); k < Math.min(end, skip.count); k++) {
+    const left = baseLines[skip.leftLine + k] ?? '';
+    const right = compareLines[skip.rightLine + k] ?? '';
+    if (left === '' && right === '') continue;
+    pairs.push({
+      type: 'same',
+      before: { type: 'same', content: left, lineNum: skip.leftLine + k },
+      after: { type: 'same', content: right, lineNum: skip.rightLine + k },
+    });
+  }
+  return pairs;
 };
 
 export const parseDiffOutput = (diffOutput: string | WasmDiffResponse): DiffPair[] => {
   try {
     const data: WasmDiffResponse = typeof diffOutput === 'string' ? JSON.parse(diffOutput) : diffOutput;
     const pairs: DiffPair[] = [];
-    let beforeLineNum = 0;
-    let afterLineNum = 0;
+    let beforeLineNum = data.start?.[0] ?? 0;
+    let afterLineNum = data.start?.[1] ?? 0;
     let i = 0;
 
     while (i < data.rows.length) {
       const item = data.rows[i];
 
-      if (item.op === 'equal') {
+      if (item.op === 'skip') {
+        // 접힌 같은 줄 묶음: 줄 번호만 건너뛰고 내용은 펼칠 때 skippedPairs 로 꺼냄
+        const skip: DiffSkip = {
+          count: item.count ?? 0,
+          leftLine: item.left_line ?? beforeLineNum,
+          rightLine: item.right_line ?? afterLineNum,
+        };
+        pairs.push({ type: 'skip', before: null, after: null, skip });
+        beforeLineNum = skip.leftLine + skip.count;
+        afterLineNum = skip.rightLine + skip.count;
+        i++;
+      } else if (item.op === 'equal') {
         // Skip empty equal operations (e.g., final newline-only lines)
         if (item.left !== '' || item.right !== '') {
           pairs.push({
@@ -15,6 +15,29 @@ export interface WasmOverheadTiming {
   memoryAlloc: number; // 메모리 할당 시간
   stringConvert: number; // 문자열 변환 시간
   jsonParse: number; // JSON 파싱 시간
+  binaryDecode: number; // 바이너리 결과 읽기 시간 (바이너리 형식 사용 시)
+}
+
+/**
+ * C++ 엔진 내부 단계별 측정 값 (cpp/src/diff_stats.hpp 의 DiffStats)
+ * - DIFF_STATS=1 로 빌드한 WASM 에서만 값이 있음
+ */
+export interface EngineStats {
+  totalMs: number; // 엔진 내부 전체 시간
+  splitMs: number; // 줄 분할 + 줄 ID 부여
+  lineDiffMs: number; // 줄 단위 diff (Myers 등)
+  buildRowsMs: number; // 편집 스크립트 -> row
+  tokenDiffMs: number; // replace 줄의 토큰 diff
+  serializeMs: number; // JSON / 바이너리 작성 (토큰 diff 제외)
+  editDistance: number; // D (삭제 + 추가 줄 수)
+  snakeCount: number; // 같은 줄 구간(snake) 수
+  snakeLines: number; // snake 에 속한 줄 수
+  longestSnake: number; // 가장 긴 snake
+  myersSteps: number; // Myers 계열이 탐색한 (d, k) 지점 수
+  tokenRows: number; // 토큰 diff 한 row 수
+  tokenCount: number; // 만들어진 토큰 수
+  allocCount: number; // C++ 할당 횟수
+  allocBytes: number; // C++ 할당 바이트
 }
 
 export interface PerformanceMetrics {
@@ -43,6 +66,10 @@ export interface PerformanceMetrics {
   memoryAllocTime: number; // 메모리 할당 시간 (ms)
   stringConvertTime: number; // 문자열 변환 시간 (ms)
   jsonParseTime: number; // JSON 파싱 시간 (ms)
+  binaryDecodeTime: number; // 바이너리 결과 읽기 시간 (ms)
+
+  // C++ 엔진 내부 단계별 측정 (DIFF_STATS 빌드에서만, 모든 청크 합계)
+  engineStats: EngineStats | null;
 
   // 파싱 관련
   parseTime: number; // 결과 파싱 시간 (ms)
@@ -65,6 +92,7 @@ export class PerformanceTracker {
   private timings: Map<string, TimingEntry> = new Map();
   private chunkTimings: ChunkTiming[] = [];
   private wasmOverheadTimings: WasmOverheadTiming[] = [];
+  private engineStats: EngineStats | null = null;
   private startTime: number = 0;
   private metrics: Partial<PerformanceMetrics> = {};
 
@@ -81,6 +109,7 @@ export class PerformanceTracker {
     this.timings.clear();
     this.chunkTimings = [];
     this.wasmOverheadTimings = [];
+    this.engineStats = null;
   }
 
   /**
@@ -126,6 +155,20 @@ export class PerformanceTracker {
     this.wasmOverheadTimings.push(overhead);
   }
 
+  /**
+   * C++ 엔진 단계별 측정 값 누적 (longestSnake 는 최댓값, 나머지는 합계)
+   */
+  recordEngineStats(stats: EngineStats): void {
+    if (!this.engineStats) {
+      this.engineStats = { ...stats };
+      return;
+    }
+    const total = this.engineStats;
+    for (const key of Object.keys(stats) as (keyof EngineStats)[]) {
+      total[key] = key === 'longestSnake' ? Math.max(total[key], stats[key]) : total[key] + stats[key];
+    }
+  }
+
   /**
    * 파일 크기 기록
    */
@@ -173,7 +216,8 @@ export class PerformanceTracker {
     const totalMemoryAlloc = this.wasmOverheadTimings.reduce((a, b) => a + b.memoryAlloc, 0);
     const totalStringConvert = this.wasmOverheadTimings.reduce((a, b) => a + b.stringConvert, 0);
     const totalJsonParse = this.wasmOverheadTimings.reduce((a, b) => a + b.jsonParse, 0);
-    const wasmOverhead = totalMemoryAlloc + totalStringConvert + totalJsonParse;
+    const totalBinaryDecode = this.wasmOverheadTimings.reduce((a, b) => a + b.binaryDecode, 0);
+    const wasmOverhead = totalMemoryAlloc + totalStringConvert + totalJsonParse + totalBinaryDecode;
 
     return {
       fileReadTime: this.timings.get('fileRead')?.duration ?? 0,
@@ -192,6 +236,8 @@ export class PerformanceTracker {
       memoryAllocTime: totalMemoryAlloc,
       stringConvertTime: totalStringConvert,
       jsonParseTime: totalJsonParse,
+      binaryDecodeTime: totalBinaryDecode,
+      engineStats: this.engineStats,
       parseTime: this.timings.get('parse')?.duration ?? 0,
       totalTime,
       totalLines: this.metrics.totalLines ?? 0,
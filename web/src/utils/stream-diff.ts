@@ -1,32 +1,36 @@
-import type { WasmDiffResponse, WasmDiffItem } from './diff';
-import { diffTextJs } from './algorithm';
-import { PerformanceTracker, type PerformanceMetrics, type WasmOverheadTiming } from './performance';
-import { processWasmChunkOptimized, getOptimizationStatus } from './wasm-optimized';
-
-// 청크 설정: 라인 수 기준 (500줄씩 처리)
+import { foldDiffRows, type DegradedReason, type DiffRowPatch, type WasmDiffResponse, type WasmDiffItem } from './diff';
+import { diffLinesJs, diffTextJs, lineNormalizer, type DiffOptions, type LineNormalizer } from './algorithm';
+import { PerformanceTracker, type EngineStats, type PerformanceMetrics, type WasmOverheadTiming } from './performance';
+import {
+  processWasmChunkOptimized,
+  getOptimizationStatus,
+  callDiffText,
+  configureWasmBudget,
+  configureWasmContext,
+  configureWasmThreads,
+  getWasmBaseIndex,
+  readEngineStats,
+  WasmIncrementalDiff,
+  WasmStreamSession,
+  type DiffSide,
+} from './wasm-optimized';
+import { createSharedDiffInput, getWasmWorkerPool, lineByteStarts, type WasmWorkerPool } from './wasm-worker-pool';
+
+// 청크 설정: 라인 수 기준 (500줄 창에서 앵커를 찾아 자름)
 export const CHUNK_SIZE_LINES = 500;
 
+// 앵커를 못 찾으면 창을 두 배씩 늘리다가, 이 배수를 넘으면 창 끝에서 강제로 자름
+const MAX_WINDOW_CHUNKS = 8;
+
 /**
  * 텍스트를 줄 단위로 분리
+ * - C++ splitLineViews 와 같은 규칙 (마지막 줄은 '\n' 이 없어도 한 줄, "a\n" -> ["a", ""])
+ * - 문자를 하나씩 이어 붙이지 않고 엔진의 split 으로 원본을 한 번에 잘라냄
+ *   (빈 문자열만 [] 로 따로 처리)
  */
 export function splitLines(text: string): string[] {
   if (!text) return [];
-
-  const lines: string[] = [];
-  let current = '';
-
-  for (let i = 0; i < text.length; i++) {
-    const c = text[i];
-    if (c === '\n') {
-      lines.push(current);
-      current = '';
-    } else {
-      current += c;
-    }
-  }
-  lines.push(current);
-
-  return lines;
+  return text.split('\n');
 }
 
 /**
@@ -37,12 +41,14 @@ export function joinLines(lines: string[]): string {
 }
 
 /**
- * 청크 정보 타입
+ * 청크 정보 타입 (양쪽 줄 범위가 서로 다를 수 있음)
  */
 export interface ChunkInfo {
   index: number;
-  startLine: number;
-  endLine: number;
+  baseStart: number;
+  baseEnd: number;
+  compareStart: number;
+  compareEnd: number;
   baseLines: string[];
   compareLines: string[];
 }
@@ -60,33 +66,150 @@ export interface StreamDiffResult {
   metrics: PerformanceMetrics;
 }
 
+/**
+ * 청크별 row 를 하나의 응답으로 합침
+ * - 예산(DiffOptions.budget)에 걸린 청크가 하나라도 있으면 그 이유들을 degraded 로 모음
+ */
+function mergeChunkRows(rows: WasmDiffItem[], degraded: Set<DegradedReason>): WasmDiffResponse {
+  return degraded.size > 0 ? { rows, degraded: [...degraded] } : { rows };
+}
+
+/**
+ * 두 창(base[baseStart, baseEnd), compare[compareStart, compareEnd))에서 청크를 끊을 앵커 찾기
+ * - 양쪽에 한 번씩만 나오는 줄 중 순서가 유지되는 가장 긴 열(LIS)을 만들고
+ * - 바로 앞 줄도 앵커인(두 줄 연속으로 맞는) 마지막 쌍을 고름 (없으면 열의 마지막)
+ * - C++ stream_session.hpp 의 findStreamAnchor 와 같은 규칙
+ */
+function findChunkAnchor(
+  baseLines: string[],
+  baseStart: number,
+  baseEnd: number,
+  compareLines: string[],
+  compareStart: number,
+  compareEnd: number,
+): { base: number; compare: number } | null {
+  const counts = new Map<string, { base: number; compare: number; comparePos: number }>();
+  for (let i = baseStart; i < baseEnd; i++) {
+    const entry = counts.get(baseLines[i]);
+    if (entry) entry.base++;
+    else counts.set(baseLines[i], { base: 1, compare: 0, comparePos: -1 });
+  }
+  for (let j = compareStart; j < compareEnd; j++) {
+    const entry = counts.get(compareLines[j]);
+    if (entry) {
+      entry.compare++;
+      entry.comparePos = j;
+    }
+  }
+
+  const candidates: { base: number; compare: number }[] = [];
+  for (let i = baseStart; i < baseEnd; i++) {
+    const entry = counts.get(baseLines[i])!;
+    if (entry.base === 1 && entry.compare === 1) {
+      candidates.push({ base: i, compare: entry.comparePos });
+    }
+  }
+  if (candidates.length === 0) {
+    return null;
+  }
+
+  // tails[k] : 길이 k+1 인 증가열의 마지막 후보 번호
+  const tails: number[] = [];
+  const prev = new Array<number>(candidates.length).fill(-1);
+  for (let c = 0; c < candidates.length; c++) {
+    let lo = 0;
+    let hi = tails.length;
+    while (lo < hi) {
+      const mid = (lo + hi) >> 1;
+      if (candidates[tails[mid]].compare < candidates[c].compare) lo = mid + 1;
+      else hi = mid;
+    }
+    if (lo > 0) prev[c] = tails[lo - 1];
+    tails[lo] = c;
+  }
+
+  for (let c = tails[tails.length - 1]; c >= 0 && prev[c] >= 0; c = prev[c]) {
+    const before = candidates[prev[c]];
+    if (before.base + 1 === candidates[c].base && before.compare + 1 === candidates[c].compare) {
+      return candidates[c];
+    }
+  }
+  return candidates[tails[tails.length - 1]];
+}
+
 /**
  * 파일을 청크로 분할
+ * - 같은 줄 번호로 자르지 않고, 양쪽의 같은 줄(앵커) 바로 뒤에서 자름
+ *   (앞쪽에 줄이 추가/삭제돼도 이후 청크가 어긋나지 않음)
+ * - normalize 가 있으면 정규화한 키로 앵커를 찾음 (CRLF / LF 처럼 원문이 전부 달라도 같은 줄에서 자름)
  */
 export function splitIntoChunks(
   baseLines: string[],
   compareLines: string[],
   chunkSize: number = CHUNK_SIZE_LINES,
+  normalize: LineNormalizer | null = null,
 ): ChunkInfo[] {
+  const baseKeys = normalize ? baseLines.map(normalize) : baseLines;
+  const compareKeys = normalize ? compareLines.map(normalize) : compareLines;
   const chunks: ChunkInfo[] = [];
-  const maxLines = Math.max(baseLines.length, compareLines.length);
-
-  for (let i = 0; i < maxLines; i += chunkSize) {
-    const startLine = i;
-    const endLine = Math.min(i + chunkSize, maxLines);
+  const maxWindow = chunkSize * MAX_WINDOW_CHUNKS;
+  let baseStart = 0;
+  let compareStart = 0;
+  let window = chunkSize;
+
+  while (baseStart < baseLines.length || compareStart < compareLines.length) {
+    let baseEnd = baseLines.length;
+    let compareEnd = compareLines.length;
+
+    // 남은 줄이 창보다 많으면 창 안의 앵커에서 자름
+    if (baseEnd - baseStart > window || compareEnd - compareStart > window) {
+      const baseWindowEnd = Math.min(baseStart + window, baseLines.length);
+      const compareWindowEnd = Math.min(compareStart + window, compareLines.length);
+      const anchor = findChunkAnchor(baseKeys, baseStart, baseWindowEnd, compareKeys, compareStart, compareWindowEnd);
+
+      if (anchor) {
+        baseEnd = anchor.base + 1;
+        compareEnd = anchor.compare + 1;
+      } else if (window < maxWindow) {
+        window *= 2;
+        continue;
+      } else {
+        baseEnd = baseWindowEnd;
+        compareEnd = compareWindowEnd;
+      }
+    }
 
     chunks.push({
       index: chunks.length,
-      startLine,
-      endLine,
-      baseLines: baseLines.slice(startLine, endLine),
-      compareLines: compareLines.slice(startLine, endLine),
+      baseStart,
+      baseEnd,
+      compareStart,
+      compareEnd,
+      baseLines: baseLines.slice(baseStart, baseEnd),
+      compareLines: compareLines.slice(compareStart, compareEnd),
     });
+
+    baseStart = baseEnd;
+    compareStart = compareEnd;
+    window = chunkSize;
   }
 
   return chunks;
 }
 
+/**
+ * text[from] 부터 lineCount 줄 뒤의 위치 ('\n' 포함, 없으면 텍스트 끝)
+ */
+function advanceLines(text: string, from: number, lineCount: number): number {
+  let pos = from;
+  for (let i = 0; i < lineCount; i++) {
+    const newline = text.indexOf('\n', pos);
+    if (newline < 0) return text.length;
+    pos = newline + 1;
+  }
+  return pos;
+}
+
 /**
  * 이벤트 루프 양보 (UI 반응성 유지)
  */
@@ -103,6 +226,7 @@ export async function streamDiffJs(
   baseText: string,
   compareText: string,
   onProgress?: ProgressCallback,
+  options: DiffOptions = {},
 ): Promise<StreamDiffResult> {
   const tracker = new PerformanceTracker('js');
   tracker.start();
@@ -127,16 +251,16 @@ export async function streamDiffJs(
     // Diff 연산 시작
     tracker.startPhase('diffProcess');
     const chunkStart = performance.now();
-    const response = diffTextJs(baseText, compareText);
+    const response = diffTextJs(baseText, compareText, options);
     const chunkDuration = performance.now() - chunkStart;
     tracker.recordChunkTime(0, chunkDuration);
     tracker.endPhase('diffProcess');
 
     const metrics = tracker.finalize();
-    return { response, metrics };
+    return { response: foldDiffRows(response, options.context), metrics };
   }
 
-  const chunks = splitIntoChunks(baseLines, compareLines);
+  const chunks = splitIntoChunks(baseLines, compareLines, CHUNK_SIZE_LINES, lineNormalizer(options));
   tracker.endPhase('chunkSplit');
   tracker.setChunkCount(chunks.length);
 
@@ -164,7 +288,7 @@ export async function streamDiffJs(
     const chunkCompareText = joinLines(chunk.compareLines);
 
     const chunkStart = performance.now();
-    const result = diffTextJs(chunkBaseText, chunkCompareText);
+    const result = diffTextJs(chunkBaseText, chunkCompareText, options);
     const chunkDuration = performance.now() - chunkStart;
     tracker.recordChunkTime(i, chunkDuration);
 
@@ -179,7 +303,7 @@ export async function streamDiffJs(
 
   console.log(`[JS] 처리 완료: ${allRows.length}개 행`);
 
-  const response = { rows: allRows };
+  const response = foldDiffRows({ rows: allRows }, options.context);
   const metrics = tracker.finalize();
 
   return { response, metrics };
@@ -210,6 +334,13 @@ export interface WasmStreamDiffOptions {
   baseText: string;
   compareText: string;
   onProgress?: ProgressCallback;
+  diffOptions?: DiffOptions;
+  // 기준 파일 인덱스(cpp/src/base_index.hpp)로 한 번에 비교
+  // 같은 기준으로 다시 부르면 기준을 다시 나누지 않고, 같은 비교 텍스트면 기억해 둔 결과를 씀
+  reuseBaseIndex?: boolean;
+  // 큰 파일의 청크를 워커 풀(wasm-worker-pool.ts)에서 메인 스레드 밖으로 나눠 처리 (기본: 사용)
+  // cross-origin isolated 가 아니면 자동으로 메인 스레드 처리로 돌아감
+  useWorkers?: boolean;
 }
 
 /**
@@ -219,12 +350,18 @@ interface WasmChunkResult {
   response: WasmDiffResponse;
   pureAlgorithmTime: number; // 순수 C++ 알고리즘 실행 시간
   overhead: WasmOverheadTiming; // WASM 오버헤드
+  engineStats?: EngineStats | null; // 엔진 단계별 측정 (DIFF_STATS 빌드에서만)
 }
 
 /**
  * WASM 단일 청크 처리 (타임아웃 포함, 세부 타이밍 측정)
  */
-function processWasmChunk(baseText: string, compareText: string, timeoutMs: number = 30000): Promise<WasmChunkResult> {
+function processWasmChunk(
+  baseText: string,
+  compareText: string,
+  options: DiffOptions = {},
+  timeoutMs: number = 30000,
+): Promise<WasmChunkResult> {
   return new Promise((resolve, reject) => {
     const timeoutId = setTimeout(() => {
       reject(new Error('WASM 청크 처리 타임아웃'));
@@ -257,7 +394,7 @@ function processWasmChunk(baseText: string, compareText: string, timeoutMs: numb
       try {
         // 2. 순수 C++ 알고리즘 실행 시간 측정
         const algorithmStart = performance.now();
-        const resultPtr = module._diff_text(baseTextPtr, changedTextPtr);
+        const resultPtr = callDiffText(module, baseTextPtr, changedTextPtr, options);
         const pureAlgorithmTime = performance.now() - algorithmStart;
 
         if (resultPtr) {
@@ -279,7 +416,9 @@ function processWasmChunk(baseText: string, compareText: string, timeoutMs: numb
               memoryAlloc: memAllocTime,
               stringConvert: strConvertTime,
               jsonParse: jsonParseTime,
+              binaryDecode: 0,
             },
+            engineStats: readEngineStats(module),
           });
         } else {
           clearTimeout(timeoutId);
@@ -297,11 +436,169 @@ function processWasmChunk(baseText: string, compareText: string, timeoutMs: numb
   });
 }
 
+/**
+ * WASM 스트리밍 세션으로 처리
+ * - 양쪽을 CHUNK_SIZE_LINES 줄씩 넣고, 그때마다 확정된 row 를 받아 이어 붙임
+ * - 청크 경계 정렬과 꼬리 이월은 C++ 세션이 담당
+ */
+async function streamDiffWasmSession(
+  session: WasmStreamSession,
+  baseText: string,
+  compareText: string,
+  baseLineCount: number,
+  compareLineCount: number,
+  tracker: PerformanceTracker,
+  onProgress?: ProgressCallback,
+): Promise<StreamDiffResult> {
+  const feedCount = Math.ceil(Math.max(baseLineCount, compareLineCount) / CHUNK_SIZE_LINES);
+  const total = feedCount + 1; // 마지막 finish 포함
+  tracker.setChunkCount(total);
+
+  const allRows: WasmDiffItem[] = [];
+  const degraded = new Set<DegradedReason>();
+  let basePos = 0;
+  let comparePos = 0;
+
+  console.log(`[WASM] 스트리밍 세션으로 ${feedCount}번 나눠 입력`);
+
+  tracker.startPhase('diffProcess');
+
+  for (let i = 0; i < total; i++) {
+    if (onProgress) {
+      onProgress({
+        current: i + 1,
+        total,
+        percentage: Math.round(((i + 1) / total) * 100),
+      });
+    }
+
+    const chunkStart = performance.now();
+    let result;
+    if (i < feedCount) {
+      const baseEnd = advanceLines(baseText, basePos, CHUNK_SIZE_LINES);
+      const compareEnd = advanceLines(compareText, comparePos, CHUNK_SIZE_LINES);
+      result = session.feed(baseText.slice(basePos, baseEnd), compareText.slice(comparePos, compareEnd));
+      basePos = baseEnd;
+      comparePos = compareEnd;
+    } else {
+      result = session.finish();
+    }
+    const chunkDuration = performance.now() - chunkStart;
+
+    tracker.recordChunkTime(i, chunkDuration, result.pureAlgorithmTime);
+    tracker.recordWasmOverhead(result.overhead);
+    allRows.push(...result.response.rows);
+    result.response.degraded?.forEach((reason) => degraded.add(reason));
+
+    // UI 반응성을 위해 이벤트 루프 양보
+    await yieldToMain();
+  }
+
+  tracker.endPhase('diffProcess');
+
+  console.log(`[WASM] 처리 완료: ${allRows.length}개 행`);
+
+  const response = mergeChunkRows(allRows, degraded);
+  const metrics = tracker.finalize();
+
+  return { response, metrics };
+}
+
+/**
+ * WASM 워커 풀로 처리
+ * - 양쪽을 공유 버퍼에 한 번 인코딩하고, 앵커로 나눈 청크의 바이트 범위만 워커에 보냄
+ * - 청크는 워커 수만큼 동시에 돌고, 결과는 청크 순서대로 이어 붙임
+ * - 메인 스레드는 결과를 기다리는 동안 비어 있으므로 yieldToMain 이 필요 없음
+ */
+async function streamDiffWasmWorkers(
+  pool: WasmWorkerPool,
+  baseText: string,
+  compareText: string,
+  baseLines: string[],
+  compareLines: string[],
+  diffOptions: DiffOptions,
+  tracker: PerformanceTracker,
+  onProgress?: ProgressCallback,
+): Promise<StreamDiffResult> {
+  const memAllocStart = performance.now();
+  const input = createSharedDiffInput(baseText, compareText);
+  const baseStarts = lineByteStarts(input.bytes, 0, input.baseLength);
+  const compareStarts = lineByteStarts(input.bytes, input.baseLength, input.baseLength + input.compareLength);
+  const encodeTime = performance.now() - memAllocStart;
+
+  const chunks = splitIntoChunks(baseLines, compareLines, CHUNK_SIZE_LINES, lineNormalizer(diffOptions));
+  tracker.endPhase('chunkSplit');
+  tracker.setChunkCount(chunks.length);
+
+  // [start, end) 줄의 (바이트 위치, 길이) (마지막 줄 뒤 '\n' 은 빼고, 줄이 없으면 길이 0)
+  const byteRange = (starts: number[], start: number, end: number): [number, number] =>
+    end > start ? [starts[start], starts[end] - 1 - starts[start]] : [0, 0];
+
+  console.log(`[WASM] 총 ${chunks.length}개 청크를 워커 ${pool.size}개로 처리 시작`);
+
+  tracker.startPhase('diffProcess');
+  tracker.recordWasmOverhead({ memoryAlloc: encodeTime, stringConvert: 0, jsonParse: 0, binaryDecode: 0 });
+
+  const chunkRows: WasmDiffItem[][] = new Array(chunks.length);
+  const degraded = new Set<DegradedReason>();
+  let completed = 0;
+
+  await Promise.all(
+    chunks.map(async (chunk, i) => {
+      const chunkBaseText = joinLines(chunk.baseLines);
+      const chunkCompareText = joinLines(chunk.compareLines);
+      const [baseOffset, baseLength] = byteRange(baseStarts, chunk.baseStart, chunk.baseEnd);
+      const [compareOffset, compareLength] = byteRange(compareStarts, chunk.compareStart, chunk.compareEnd);
+      const span = { baseOffset, baseLength, compareOffset, compareLength };
+
+      const chunkStart = performance.now();
+      try {
+        const result = await pool.diff(input, span, chunkBaseText, chunkCompareText, diffOptions);
+        tracker.recordChunkTime(i, performance.now() - chunkStart, result.pureAlgorithmTime);
+        tracker.recordWasmOverhead(result.overhead);
+        chunkRows[i] = result.response.rows;
+        result.response.degraded?.forEach((reason) => degraded.add(reason));
+      } catch (error) {
+        // 실패한 청크는 JS로 처리
+        console.debug(`청크 ${i + 1} 워커 처리 실패, JS로 폴백:`, error);
+        const fallbackStart = performance.now();
+        chunkRows[i] = diffTextJs(chunkBaseText, chunkCompareText, diffOptions).rows;
+        const fallbackDuration = performance.now() - fallbackStart;
+        tracker.recordChunkTime(i, fallbackDuration, fallbackDuration);
+      }
+
+      completed++;
+      onProgress?.({
+        current: completed,
+        total: chunks.length,
+        percentage: Math.round((completed / chunks.length) * 100),
+      });
+    }),
+  );
+
+  tracker.endPhase('diffProcess');
+
+  const allRows = chunkRows.flat();
+  console.log(`[WASM] 처리 완료: ${allRows.length}개 행`);
+
+  const response = mergeChunkRows(allRows, degraded);
+  const metrics = tracker.finalize();
+
+  return { response, metrics };
+}
+
 /**
  * WASM 모드 스트리밍 diff (최적화된 메모리 접근 사용)
+ * - diffOptions.context 가 있으면 같은 줄 묶음을 skip row 로 접은 응답을 반환
+ *   (C++ 가 접지 않은 경로 - 바이너리 결과, 청크 처리 - 는 JS 에서 마저 접음)
  */
 export async function streamDiffWasm(options: WasmStreamDiffOptions): Promise<StreamDiffResult> {
-  const { baseText, compareText, onProgress } = options;
+  const result = await streamDiffWasmRows(options);
+  return { ...result, response: foldDiffRows(result.response, options.diffOptions?.context) };
+}
+
+async function streamDiffWasmRows(options: WasmStreamDiffOptions): Promise<StreamDiffResult> {
+  const { baseText, compareText, onProgress, diffOptions = {} } = options;
 
   const tracker = new PerformanceTracker('cpp');
   tracker.start();
@@ -312,16 +609,36 @@ export async function streamDiffWasm(options: WasmStreamDiffOptions): Promise<St
   // WASM 모듈 준비 확인
   if (!isWasmModuleReady()) {
     console.warn('WASM 모듈이 준비되지 않았습니다. JS 모드로 폴백합니다.');
-    return streamDiffJs(baseText, compareText, onProgress);
+    return streamDiffJs(baseText, compareText, onProgress, diffOptions);
   }
 
   // 최적화 모드 사용 가능 여부 확인
   const useOptimized = isOptimizedModeAvailable();
+  configureWasmThreads();
+  configureWasmBudget(diffOptions.budget);
   const optimizationStatus = getOptimizationStatus();
 
   console.log(`[WASM] 최적화 모드: ${useOptimized ? '활성화' : '비활성화'}`);
   console.log(`[WASM] 메모리 풀: ${optimizationStatus.memoryPoolActive ? '활성' : '비활성'}`);
   console.log(`[WASM] SharedArrayBuffer: ${optimizationStatus.sharedArrayBufferSupported ? '지원' : '미지원'}`);
+  console.log(`[WASM] diff 스레드: ${optimizationStatus.wasmThreads}`);
+
+  // 기준 파일 인덱스를 재사용하는 경우 청크로 나누지 않고 한 번에 비교 (C++ 에서 바로 접음)
+  if (options.reuseBaseIndex) configureWasmContext(diffOptions.context);
+  const baseIndex = options.reuseBaseIndex ? getWasmBaseIndex(baseText, diffOptions) : null;
+  if (baseIndex) {
+    tracker.setChunkCount(1);
+    onProgress?.({ current: 1, total: 1, percentage: 100 });
+
+    tracker.startPhase('diffProcess');
+    const chunkStart = performance.now();
+    const result = baseIndex.diff(compareText);
+    tracker.recordChunkTime(0, performance.now() - chunkStart, result.pureAlgorithmTime);
+    tracker.recordWasmOverhead(result.overhead);
+    tracker.endPhase('diffProcess');
+
+    return { response: result.response, metrics: tracker.finalize() };
+  }
 
   // 청크 분할 시작
   tracker.startPhase('chunkSplit');
@@ -338,26 +655,28 @@ export async function streamDiffWasm(options: WasmStreamDiffOptions): Promise<St
     }
 
     tracker.startPhase('diffProcess');
+    configureWasmContext(diffOptions.context);
     try {
       const chunkStart = performance.now();
 
       // 최적화된 버전 사용 (메모리 풀 + 직접 메모리 접근)
       const result = useOptimized
-        ? await processWasmChunkOptimized(baseText, compareText)
-        : await processWasmChunk(baseText, compareText);
+        ? await processWasmChunkOptimized(baseText, compareText, diffOptions)
+        : await processWasmChunk(baseText, compareText, diffOptions);
 
       const chunkDuration = performance.now() - chunkStart;
 
       // 순수 알고리즘 시간과 오버헤드 기록
       tracker.recordChunkTime(0, chunkDuration, result.pureAlgorithmTime);
       tracker.recordWasmOverhead(result.overhead);
+      if (result.engineStats) tracker.recordEngineStats(result.engineStats);
       tracker.endPhase('diffProcess');
 
       const metrics = tracker.finalize();
       return { response: result.response, metrics };
     } catch (error) {
       const chunkStart = performance.now();
-      const response = diffTextJs(baseText, compareText);
+      const response = diffTextJs(baseText, compareText, diffOptions);
       const chunkDuration = performance.now() - chunkStart;
       tracker.recordChunkTime(0, chunkDuration, chunkDuration);
       tracker.endPhase('diffProcess');
@@ -367,12 +686,53 @@ export async function streamDiffWasm(options: WasmStreamDiffOptions): Promise<St
     }
   }
 
+  // 청크별 결과는 C++ 에서 접지 않음 (skip 줄 번호가 청크 기준이 되므로 합친 뒤 접음)
+  configureWasmContext();
+
+  // cross-origin isolated 면 워커 풀에서 청크를 나눠 처리 (메인 스레드를 막지 않음)
+  const workerPool = options.useWorkers === false ? null : await getWasmWorkerPool();
+  if (workerPool) {
+    return streamDiffWasmWorkers(
+      workerPool,
+      baseText,
+      compareText,
+      baseLines,
+      compareLines,
+      diffOptions,
+      tracker,
+      onProgress,
+    );
+  }
+
+  // 스트리밍 세션을 지원하는 빌드면 C++ 쪽에서 앵커 기준으로 청크를 맞춤
+  const session = WasmStreamSession.create(diffOptions, CHUNK_SIZE_LINES);
+  if (session) {
+    tracker.endPhase('chunkSplit');
+    try {
+      return await streamDiffWasmSession(
+        session,
+        baseText,
+        compareText,
+        baseLines.length,
+        compareLines.length,
+        tracker,
+        onProgress,
+      );
+    } catch (error) {
+      console.debug('[WASM] 스트리밍 세션 처리 실패, JS로 폴백:', error);
+      return streamDiffJs(baseText, compareText, onProgress, diffOptions);
+    } finally {
+      session.destroy();
+    }
+  }
+
   // 청크 분할
-  const chunks = splitIntoChunks(baseLines, compareLines);
+  const chunks = splitIntoChunks(baseLines, compareLines, CHUNK_SIZE_LINES, lineNormalizer(diffOptions));
   tracker.endPhase('chunkSplit');
   tracker.setChunkCount(chunks.length);
 
   const allRows: WasmDiffItem[] = [];
+  const degraded = new Set<DegradedReason>();
 
   console.log(`[WASM] 총 ${chunks.length}개 청크로 분할하여 처리 시작`);
 
@@ -400,20 +760,22 @@ export async function streamDiffWasm(options: WasmStreamDiffOptions): Promise<St
 
       // 최적화된 버전 사용 (메모리 풀 재사용)
       const result = useOptimized
-        ? await processWasmChunkOptimized(chunkBaseText, chunkCompareText)
-        : await processWasmChunk(chunkBaseText, chunkCompareText);
+        ? await processWasmChunkOptimized(chunkBaseText, chunkCompareText, diffOptions)
+        : await processWasmChunk(chunkBaseText, chunkCompareText, diffOptions);
 
       const chunkDuration = performance.now() - chunkStart;
 
       // 순수 알고리즘 시간과 오버헤드 기록
       tracker.recordChunkTime(i, chunkDuration, result.pureAlgorithmTime);
       tracker.recordWasmOverhead(result.overhead);
+      if (result.engineStats) tracker.recordEngineStats(result.engineStats);
       allRows.push(...result.response.rows);
+      result.response.degraded?.forEach((reason) => degraded.add(reason));
     } catch (error) {
       // 실패한 청크는 JS로 처리
       console.debug(`청크 ${i + 1} WASM 처리 실패, JS로 폴백:`, error);
       const chunkStart = performance.now();
-      const fallbackResult = diffTextJs(chunkBaseText, chunkCompareText);
+      const fallbackResult = diffTextJs(chunkBaseText, chunkCompareText, diffOptions);
       const chunkDuration = performance.now() - chunkStart;
       tracker.recordChunkTime(i, chunkDuration, chunkDuration);
       allRows.push(...fallbackResult.rows);
@@ -427,8 +789,252 @@ export async function streamDiffWasm(options: WasmStreamDiffOptions): Promise<St
 
   console.log(`[WASM] 처리 완료: ${allRows.length}개 행`);
 
-  const response = { rows: allRows };
+  const response = mergeChunkRows(allRows, degraded);
   const metrics = tracker.finalize();
 
   return { response, metrics };
 }
+
+/**
+ * 기준 하나를 여러 비교 텍스트와 비교 (결과는 compareTexts 순서)
+ * - 기준 파일 인덱스가 있는 빌드면 기준을 한 번만 나누고, diff 스레드 수만큼 나눠 처리
+ *   (인덱스는 다음 호출에서도 같은 기준 / 옵션이면 재사용)
+ * - 없으면 비교 텍스트마다 streamDiffWasm 을 차례로 부름
+ */
+export async function streamDiffWasmBatch(
+  baseText: string,
+  compareTexts: string[],
+  onProgress?: ProgressCallback,
+  diffOptions: DiffOptions = {},
+): Promise<StreamDiffResult[]> {
+  if (isWasmModuleReady()) {
+    configureWasmThreads();
+    configureWasmBudget(diffOptions.budget);
+    configureWasmContext(diffOptions.context);
+  }
+  const baseIndex = isWasmModuleReady() ? getWasmBaseIndex(baseText, diffOptions) : null;
+
+  if (!baseIndex) {
+    const results: StreamDiffResult[] = [];
+    for (let i = 0; i < compareTexts.length; i++) {
+      results.push(await streamDiffWasm({ baseText, compareText: compareTexts[i], diffOptions }));
+      onProgress?.({
+        current: i + 1,
+        total: compareTexts.length,
+        percentage: Math.round(((i + 1) / compareTexts.length) * 100),
+      });
+    }
+    return results;
+  }
+
+  const batchStart = performance.now();
+  const batch = baseIndex.diffBatch(compareTexts);
+  const batchDuration = performance.now() - batchStart;
+  onProgress?.({ current: compareTexts.length, total: compareTexts.length, percentage: 100 });
+
+  return batch.map((result, i) => {
+    const tracker = new PerformanceTracker('cpp');
+    tracker.start();
+    tracker.setFileSizes(new Blob([baseText]).size, new Blob([compareTexts[i]]).size);
+    tracker.setChunkCount(1);
+    tracker.recordChunkTime(0, batchDuration / compareTexts.length, result.pureAlgorithmTime);
+    tracker.recordWasmOverhead(result.overhead);
+    return { response: foldDiffRows(result.response, diffOptions.context), metrics: tracker.finalize() };
+  });
+}
+
+/**
+ * 증분 diff 의 편집 하나: side 쪽 [lineStart, lineEnd) 줄을 text 의 줄로 바꿈
+ * - text 는 파일과 같은 규칙 (빈 문자열 = 줄 없음, 끝의 '\n' 하나는 줄 끝)
+ */
+export interface LineEdit {
+  side: DiffSide;
+  lineStart: number;
+  lineEnd: number;
+  text: string;
+}
+
+// JS 증분 diff 에서 창 경계로 인정하는 연속 equal row 수 (C++ IncrementalDiff::ANCHOR_RUN)
+const INCREMENTAL_ANCHOR_RUN = 2;
+
+// 한 번에 splice 로 펼쳐 넣을 최대 원소 수 (인자 개수 제한)
+const SPLICE_CHUNK_ROWS = 8192;
+
+/**
+ * text 를 LineEdit.text 규칙으로 줄 배열로 나눔
+ */
+function editLines(text: string): string[] {
+  if (!text) return [];
+  const lines = text.split('\n');
+  if (text.endsWith('\n')) lines.pop();
+  return lines;
+}
+
+/**
+ * array 의 [start, start + removed) 를 items 로 바꿈 (큰 배열도 splice 인자 개수 제한에 걸리지 않게 나눠 넣음)
+ */
+function spliceInChunks<T>(array: T[], start: number, removed: number, items: T[]): void {
+  array.splice(start, removed);
+  for (let i = 0; i < items.length; i += SPLICE_CHUNK_ROWS) {
+    array.splice(start + i, 0, ...items.slice(i, i + SPLICE_CHUNK_ROWS));
+  }
+}
+
+/**
+ * 한쪽 텍스트가 before -> after 로 바뀐 것을 편집 하나로 (앞뒤 공통 줄을 뺀 나머지, 같으면 null)
+ * - 편집기 변경 이벤트처럼 줄 범위를 이미 알면 이 함수 없이 LineEdit 를 바로 만들면 됨
+ */
+export function lineEditBetween(side: DiffSide, before: string, after: string): LineEdit | null {
+  if (before === after) return null;
+  const a = splitLines(before);
+  const b = splitLines(after);
+  let prefix = 0;
+  while (prefix < a.length && prefix < b.length && a[prefix] === b[prefix]) prefix++;
+  let suffix = 0;
+  while (
+    suffix < a.length - prefix &&
+    suffix < b.length - prefix &&
+    a[a.length - 1 - suffix] === b[b.length - 1 - suffix]
+  ) {
+    suffix++;
+  }
+
+  const lines = b.slice(prefix, b.length - suffix);
+  return {
+    side,
+    lineStart: prefix,
+    lineEnd: a.length - suffix,
+    text: lines.length > 0 ? joinLines(lines) + '\n' : '',
+  };
+}
+
+/**
+ * 같은 파일 쌍에 작은 편집이 이어질 때 (편집기) 쓰는 증분 diff
+ * - C++ 증분 diff(cpp/src/incremental_diff.hpp)를 내보낸 빌드면 WasmIncrementalDiff 로
+ *   편집한 줄 주변만 C++ 에서 다시 비교
+ * - 아니면 같은 규칙의 JS 버전: 편집한 줄을 가진 row 를 두 줄 연속 equal 앵커까지 넓혀
+ *   그 창만 diffLinesJs 로 다시 비교 (창을 찾을 때 row 를 앞에서부터 세므로 row 수에 비례)
+ * - rows 는 접지 않은 전체 row 로, edit() 가 돌려주는 patch 가 여기에도 반영됨
+ */
+export class IncrementalDiffSession {
+  readonly rows: WasmDiffItem[];
+  private readonly options: DiffOptions;
+  private readonly wasm: WasmIncrementalDiff | null;
+  private readonly lines: Record<DiffSide, string[]>;
+  private readonly degraded = new Set<DegradedReason>();
+
+  private constructor(
+    response: WasmDiffResponse,
+    options: DiffOptions,
+    wasm: WasmIncrementalDiff | null,
+    lines: Record<DiffSide, string[]>,
+  ) {
+    this.rows = response.rows;
+    this.options = options;
+    this.wasm = wasm;
+    this.lines = lines;
+    response.degraded?.forEach((reason) => this.degraded.add(reason));
+  }
+
+  static create(baseText: string, compareText: string, options: DiffOptions = {}): IncrementalDiffSession {
+    if (isWasmModuleReady() && WasmIncrementalDiff.isAvailable()) {
+      configureWasmThreads();
+      configureWasmBudget(options.budget);
+      const wasm = WasmIncrementalDiff.create(baseText, compareText, options);
+      if (wasm) {
+        return new IncrementalDiffSession(wasm.rows(), options, wasm, { base: [], compare: [] });
+      }
+    }
+
+    const lines = { base: splitLines(baseText), compare: splitLines(compareText) };
+    return new IncrementalDiffSession(diffLinesJs(lines.base, lines.compare, options), options, null, lines);
+  }
+
+  /**
+   * 편집 하나를 반영하고 바뀐 row 만 patch 로 반환 (rows 에도 반영됨)
+   */
+  edit(edit: LineEdit): DiffRowPatch {
+    const patch = this.wasm
+      ? this.wasm.edit(edit.side, edit.lineStart, edit.lineEnd, edit.text)
+      : this.editJs(edit);
+    patch.degraded?.forEach((reason) => this.degraded.add(reason));
+
+    spliceInChunks(this.rows, patch.row, patch.removed, patch.rows);
+    return patch;
+  }
+
+  /**
+   * 지금 전체 결과 (options.context 가 있으면 같은 줄 묶음을 접음)
+   */
+  response(): WasmDiffResponse {
+    const response = mergeChunkRows(this.rows, this.degraded);
+    return foldDiffRows(response, this.options.context);
+  }
+
+  destroy(): void {
+    this.wasm?.destroy();
+  }
+
+  private editJs(edit: LineEdit): DiffRowPatch {
+    const { side, lineStart, lineEnd } = edit;
+    const sideLines = this.lines[side];
+    if (lineStart < 0 || lineEnd < lineStart || lineEnd > sideLines.length) {
+      throw new Error(`잘못된 편집 범위입니다: ${side} [${lineStart}, ${lineEnd})`);
+    }
+    const rows = this.rows;
+    const holdsSide = (row: WasmDiffItem) => row.op !== (side === 'base' ? 'insert' : 'delete');
+    const isAnchor = (from: number) => {
+      if (from < 0 || from + INCREMENTAL_ANCHOR_RUN > rows.length) return false;
+      for (let i = from; i < from + INCREMENTAL_ANCHOR_RUN; i++) {
+        if (rows[i].op !== 'equal') return false;
+      }
+      return true;
+    };
+
+    // 1) 편집한 줄을 가진 row 구간 [first, last): 앞까지 나온 그쪽 줄 수가 lineStart / lineEnd 이상인 첫 row
+    let first = rows.length;
+    let last = rows.length;
+    let seen = 0;
+    for (let i = 0; i < rows.length; i++) {
+      if (first === rows.length && seen >= lineStart) first = i;
+      if (seen >= lineEnd) {
+        last = i;
+        break;
+      }
+      if (holdsSide(rows[i])) seen++;
+    }
+
+    // 2) 양쪽으로 앵커까지 넓힘 (파일 처음 / 끝도 앵커)
+    let lo = first;
+    let hi = last;
+    while (lo > 0 && !isAnchor(lo - INCREMENTAL_ANCHOR_RUN)) lo--;
+    while (hi < rows.length && !isAnchor(hi)) hi++;
+
+    let baseLo = 0;
+    let compareLo = 0;
+    for (let i = 0; i < lo; i++) {
+      if (rows[i].op !== 'insert') baseLo++;
+      if (rows[i].op !== 'delete') compareLo++;
+    }
+    let baseHi = baseLo;
+    let compareHi = compareLo;
+    for (let i = lo; i < hi; i++) {
+      if (rows[i].op !== 'insert') baseHi++;
+      if (rows[i].op !== 'delete') compareHi++;
+    }
+
+    // 3) 줄을 바꿔 끼우고 창 안만 다시 비교
+    const newLines = editLines(edit.text);
+    spliceInChunks(sideLines, lineStart, lineEnd - lineStart, newLines);
+    const shift = newLines.length - (lineEnd - lineStart);
+    if (side === 'base') baseHi += shift;
+    else compareHi += shift;
+
+    const window = diffLinesJs(
+      this.lines.base.slice(baseLo, baseHi),
+      this.lines.compare.slice(compareLo, compareHi),
+      this.options,
+    );
+    return { row: lo, removed: hi - lo, start: [baseLo, compareLo], rows: window.rows };
+  }
+}
@@ -1,9 +1,73 @@
-import type { WasmDiffResponse } from './diff';
-import type { WasmOverheadTiming } from './performance';
+import type { DegradedReason, DiffRowPatch, WasmDiffResponse, WasmDiffItem, WordToken } from './diff';
+import type { EngineStats, WasmOverheadTiming } from './performance';
+import { DIFF_ALGORITHM_CODES, toDiffFlags, type DiffBudget, type DiffOptions } from './algorithm';
 
 // WASM 모듈 타입 정의
 interface WasmModule {
   _diff_text: (basePtr: number, comparePtr: number) => number;
+  _diff_text_ex?: (basePtr: number, comparePtr: number, algorithm: number, flags: number) => number;
+  _diff_text_binary?: (basePtr: number, comparePtr: number, algorithm: number, flags: number) => number;
+  _diff_set_threads?: (threads: number) => void;
+  _diff_set_budget?: (maxCost: number, maxMemoryMb: number, timeLimitMs: number) => void;
+  _diff_set_context?: (lines: number) => void;
+  _diff_stream_create?: (algorithm: number, flags: number, chunkLines: number) => number;
+  _diff_stream_feed_base?: (session: number, dataPtr: number, length: number) => void;
+  _diff_stream_feed_compare?: (session: number, dataPtr: number, length: number) => void;
+  _diff_stream_finish?: (session: number) => void;
+  _diff_stream_drain?: (session: number) => number;
+  _diff_stream_destroy?: (session: number) => void;
+  _diff_get_stats?: () => number;
+  _diff_index_create?: (basePtr: number, baseLength: number, algorithm: number, flags: number) => number;
+  _diff_index_run?: (index: number, textPtr: number, length: number) => number;
+  _diff_index_run_batch?: (index: number, textsPtr: number, lengthsPtr: number, count: number) => number;
+  _diff_index_result_ptr?: (index: number, i: number) => number;
+  _diff_index_result_size?: (index: number, i: number) => number;
+  _diff_index_memo_hits?: (index: number) => number;
+  _diff_index_release?: (index: number) => void;
+  _diff_lazy_create?: (
+    basePtr: number,
+    baseLength: number,
+    comparePtr: number,
+    compareLength: number,
+    algorithm: number,
+    flags: number,
+  ) => number;
+  _diff_lazy_row_count?: (result: number) => number;
+  _diff_lazy_ops?: (result: number) => number;
+  _diff_lazy_rows?: (result: number, begin: number, end: number) => number;
+  _diff_lazy_rows_ptr?: (result: number) => number;
+  _diff_lazy_degraded?: (result: number) => number;
+  _diff_lazy_release?: (result: number) => void;
+  _diff_incremental_create?: (
+    basePtr: number,
+    baseLength: number,
+    comparePtr: number,
+    compareLength: number,
+    algorithm: number,
+    flags: number,
+  ) => number;
+  _diff_incremental_rows?: (diff: number) => number;
+  _diff_incremental_edit?: (
+    diff: number,
+    side: number,
+    lineStart: number,
+    lineEnd: number,
+    textPtr: number,
+    length: number,
+  ) => number;
+  _diff_incremental_result_ptr?: (diff: number) => number;
+  _diff_incremental_row_count?: (diff: number) => number;
+  _diff_incremental_release?: (diff: number) => void;
+  _diff_delta_encode?: (
+    basePtr: number,
+    baseLength: number,
+    targetPtr: number,
+    targetLength: number,
+    flags: number,
+  ) => number;
+  _diff_delta_ptr?: () => number;
+  _diff_delta_apply?: (basePtr: number, baseLength: number, deltaPtr: number, deltaLength: number) => number;
+  _diff_delta_target_ptr?: () => number;
   _malloc: (size: number) => number;
   _free: (ptr: number) => void;
   HEAPU8: Uint8Array;
@@ -21,6 +85,9 @@ interface MemoryPool {
 
 let memoryPool: MemoryPool | null = null;
 
+// 마지막으로 쓴 기준 파일 인덱스 (같은 기준 / 옵션이면 다음 실행에서도 재사용)
+let cachedBaseIndex: WasmBaseIndex | null = null;
+
 /**
  * WASM 모듈 가져오기
  */
@@ -62,6 +129,14 @@ function ensureMemoryPool(module: WasmModule, baseSize: number, compareSize: num
   return memoryPool;
 }
 
+/**
+ * 기준 파일 인덱스 해제 (스레드 수 / 예산이 바뀌면 새 설정으로 다시 만들어야 함)
+ */
+function releaseBaseIndex(): void {
+  cachedBaseIndex?.destroy();
+  cachedBaseIndex = null;
+}
+
 /**
  * WASM 메모리에서 직접 문자열 읽기 (UTF8ToString 대체)
  */
@@ -80,6 +155,156 @@ function readStringFromWasm(module: WasmModule, ptr: number): string {
   return decoder.decode(bytes);
 }
 
+/**
+ * 옵션에 맞는 diff 함수 호출
+ * - diff_text_ex 가 없는 이전 빌드에서는 기본 Myers(diff_text)로 처리
+ */
+export function callDiffText(
+  module: Pick<WasmModule, '_diff_text' | '_diff_text_ex'>,
+  basePtr: number,
+  comparePtr: number,
+  options: DiffOptions,
+): number {
+  const algorithm = DIFF_ALGORITHM_CODES[options.algorithm ?? 'myers'];
+  const flags = toDiffFlags(options);
+  if (module._diff_text_ex && (algorithm !== 0 || flags !== 0)) {
+    return module._diff_text_ex(basePtr, comparePtr, algorithm, flags);
+  }
+  return module._diff_text(basePtr, comparePtr);
+}
+
+// ------------------------------------------------------------
+// 바이너리 결과 형식 (cpp/src/binary_result.hpp 와 동일)
+// ------------------------------------------------------------
+const BINARY_RESULT_MAGIC = 0x31424644; // "DFB1"
+const BINARY_HEADER_WORDS = 8;
+const BINARY_ROW_WORDS = 7;
+const BINARY_TOKEN_WORDS = 5;
+const ROW_OPS: WasmDiffItem['op'][] = ['equal', 'delete', 'insert', 'replace'];
+const TOKEN_OPS: WordToken['op'][] = ['equal', 'delete', 'insert'];
+// 헤더 word 7 의 비트 (C++ DIFF_DEGRADED_*)
+const DEGRADED_REASONS: [number, DegradedReason][] = [
+  [1, 'cost'],
+  [2, 'memory'],
+  [4, 'time'],
+];
+
+/**
+ * 입력 버퍼의 (offset, length) 를 문자열로 바꾸는 함수 생성
+ * - ASCII 만 있는 텍스트는 바이트 위치 == 문자 위치이므로 substring 으로 바로 자름
+ * - SharedArrayBuffer 위의 바이트는 TextDecoder 가 받지 않는 브라우저가 있어 복사해서 디코딩
+ */
+function makeSpanReader(bytes: Uint8Array, text: string): (offset: number, length: number) => string {
+  if (bytes.length === text.length) {
+    return (offset, length) => (length === 0 ? '' : text.substring(offset, offset + length));
+  }
+  const decoder = new TextDecoder('utf-8');
+  if (typeof SharedArrayBuffer !== 'undefined' && bytes.buffer instanceof SharedArrayBuffer) {
+    return (offset, length) => (length === 0 ? '' : decoder.decode(bytes.slice(offset, offset + length)));
+  }
+  return (offset, length) => (length === 0 ? '' : decoder.decode(bytes.subarray(offset, offset + length)));
+}
+
+/**
+ * buffer[ptr] 부터의 바이너리 결과를 typed array 로 읽어 WasmDiffResponse 로 변환 (JSON 파싱 없음)
+ * - buffer 는 WASM 메모리 또는 워커가 넘겨준 결과 복사본 (ptr = 0)
+ */
+export function decodeBinaryResult(
+  buffer: ArrayBufferLike,
+  ptr: number,
+  baseBytes: Uint8Array,
+  baseText: string,
+  compareBytes: Uint8Array,
+  compareText: string,
+): WasmDiffResponse {
+  const header = new Uint32Array(buffer, ptr, BINARY_HEADER_WORDS);
+  if (header[0] !== BINARY_RESULT_MAGIC) {
+    throw new Error('diff_text_binary returned invalid buffer');
+  }
+
+  const rowCount = header[2];
+  const tokenCount = header[3];
+  const rowWords = new Uint32Array(buffer, ptr + header[4] * 4, rowCount * BINARY_ROW_WORDS);
+  const tokenWords = new Uint32Array(buffer, ptr + header[5] * 4, tokenCount * BINARY_TOKEN_WORDS);
+
+  const readLeft = makeSpanReader(baseBytes, baseText);
+  const readRight = makeSpanReader(compareBytes, compareText);
+
+  const rows: WasmDiffItem[] = new Array(rowCount);
+  for (let r = 0; r < rowCount; r++) {
+    const w = r * BINARY_ROW_WORDS;
+    const tokens: WordToken[] = [];
+    const tokenStart = rowWords[w + 5];
+    const tokenEnd = tokenStart + rowWords[w + 6];
+    for (let t = tokenStart; t < tokenEnd; t++) {
+      const tw = t * BINARY_TOKEN_WORDS;
+      tokens.push({
+        op: TOKEN_OPS[tokenWords[tw]],
+        left: readLeft(tokenWords[tw + 1], tokenWords[tw + 2]),
+        right: readRight(tokenWords[tw + 3], tokenWords[tw + 4]),
+      });
+    }
+
+    rows[r] = {
+      op: ROW_OPS[rowWords[w]],
+      left: readLeft(rowWords[w + 1], rowWords[w + 2]),
+      right: readRight(rowWords[w + 3], rowWords[w + 4]),
+      tokens,
+    };
+  }
+
+  const degradedBits = header[7];
+  if (degradedBits === 0) {
+    return { rows };
+  }
+  const degraded = DEGRADED_REASONS.filter(([bit]) => degradedBits & bit).map(([, reason]) => reason);
+  return { rows, degraded };
+}
+
+// ------------------------------------------------------------
+// 엔진 단계별 측정 값 (cpp/src/diff_stats.hpp 의 DiffStats, 모든 필드가 double)
+// ------------------------------------------------------------
+const DIFF_STATS_FIELDS: ('enabled' | keyof EngineStats)[] = [
+  'enabled',
+  'totalMs',
+  'splitMs',
+  'lineDiffMs',
+  'buildRowsMs',
+  'tokenDiffMs',
+  'serializeMs',
+  'editDistance',
+  'snakeCount',
+  'snakeLines',
+  'longestSnake',
+  'myersSteps',
+  'tokenRows',
+  'tokenCount',
+  'allocCount',
+  'allocBytes',
+];
+
+/**
+ * 마지막 diff 호출의 엔진 측정 값 읽기
+ * - diff_get_stats 가 없거나 DIFF_STATS 없이 빌드된 경우(enabled = 0) null
+ */
+export function readEngineStats(module: Pick<WasmModule, '_diff_get_stats' | 'HEAPU8'>): EngineStats | null {
+  const ptr = module._diff_get_stats?.();
+  if (!ptr) {
+    return null;
+  }
+  const values = new Float64Array(module.HEAPU8.buffer, ptr, DIFF_STATS_FIELDS.length);
+  if (values[0] === 0) {
+    return null;
+  }
+  const stats = {} as EngineStats;
+  DIFF_STATS_FIELDS.forEach((field, i) => {
+    if (field !== 'enabled') {
+      stats[field] = values[i];
+    }
+  });
+  return stats;
+}
+
 /**
  * 최적화된 WASM 청크 처리 결과
  */
@@ -87,6 +312,7 @@ export interface OptimizedWasmResult {
   response: WasmDiffResponse;
   pureAlgorithmTime: number;
   overhead: WasmOverheadTiming;
+  engineStats?: EngineStats | null; // 엔진 단계별 측정 (DIFF_STATS 빌드에서만)
 }
 
 /**
@@ -94,7 +320,11 @@ export interface OptimizedWasmResult {
  * - 메모리 풀 재사용으로 malloc/free 오버헤드 감소
  * - TextEncoder/TextDecoder로 직접 메모리 접근
  */
-export async function processWasmChunkOptimized(baseText: string, compareText: string): Promise<OptimizedWasmResult> {
+export async function processWasmChunkOptimized(
+  baseText: string,
+  compareText: string,
+  options: DiffOptions = {},
+): Promise<OptimizedWasmResult> {
   const module = getWasmModule();
 
   if (!module) {
@@ -125,13 +355,47 @@ export async function processWasmChunkOptimized(baseText: string, compareText: s
   const memAllocTime = performance.now() - memAllocStart;
 
   // 2. 순수 C++ 알고리즘 실행 시간 측정
+  // 바이너리 결과를 지원하는 빌드면 JSON 대신 바이너리로 받음
+  const algorithm = DIFF_ALGORITHM_CODES[options.algorithm ?? 'myers'];
+  const flags = toDiffFlags(options);
+  const useBinary = !!module._diff_text_binary;
+
   const algorithmStart = performance.now();
-  const resultPtr = module._diff_text(pool.baseBuffer, pool.compareBuffer);
+  const resultPtr = useBinary
+    ? module._diff_text_binary!(pool.baseBuffer, pool.compareBuffer, algorithm, flags)
+    : callDiffText(module, pool.baseBuffer, pool.compareBuffer, options);
   const pureAlgorithmTime = performance.now() - algorithmStart;
 
   if (!resultPtr) {
     throw new Error('diff_text returned null pointer');
   }
+  const engineStats = readEngineStats(module);
+
+  if (useBinary) {
+    // 3. 바이너리 결과 읽기 시간 측정 (문자열 변환 / JSON 파싱 없음)
+    const binaryDecodeStart = performance.now();
+    const response = decodeBinaryResult(
+      module.HEAPU8.buffer,
+      resultPtr,
+      baseBytes,
+      baseText,
+      compareBytes,
+      compareText,
+    );
+    const binaryDecodeTime = performance.now() - binaryDecodeStart;
+
+    return {
+      response,
+      pureAlgorithmTime,
+      overhead: {
+        memoryAlloc: memAllocTime,
+        stringConvert: 0,
+        jsonParse: 0,
+        binaryDecode: binaryDecodeTime,
+      },
+      engineStats,
+    };
+  }
 
   // 3. 문자열 변환 시간 측정
   const strConvertStart = performance.now();
@@ -150,16 +414,530 @@ export async function processWasmChunkOptimized(baseText: string, compareText: s
       memoryAlloc: memAllocTime,
       stringConvert: strConvertTime,
       jsonParse: jsonParseTime,
+      binaryDecode: 0,
     },
+    engineStats,
   };
 }
 
+/**
+ * C++ 스트리밍 세션 (diff_stream_* 를 내보낸 빌드에서만 사용 가능)
+ * - feed() 로 양쪽 텍스트 조각을 넣으면 그동안 확정된 row 를 돌려줌
+ * - 청크 경계는 C++ 쪽에서 양쪽의 같은 줄(앵커) 위로 맞춰지므로
+ *   호출자는 양쪽을 서로 다른 위치에서 잘라 넣어도 됨
+ */
+export class WasmStreamSession {
+  private readonly module: WasmModule;
+  private handle: number;
+  private readonly encoder = new TextEncoder();
+
+  private constructor(module: WasmModule, handle: number) {
+    this.module = module;
+    this.handle = handle;
+  }
+
+  static isAvailable(): boolean {
+    const module = getWasmModule();
+    return !!(module && module._diff_stream_create && module._diff_stream_drain);
+  }
+
+  /**
+   * 세션 생성 (chunkLines: 앵커를 찾을 최소 줄 수, 0 이면 C++ 기본값)
+   */
+  static create(options: DiffOptions = {}, chunkLines: number = 0): WasmStreamSession | null {
+    const module = getWasmModule();
+    if (!module || !WasmStreamSession.isAvailable()) {
+      return null;
+    }
+    const algorithm = DIFF_ALGORITHM_CODES[options.algorithm ?? 'myers'];
+    const handle = module._diff_stream_create!(algorithm, toDiffFlags(options), chunkLines);
+    return handle ? new WasmStreamSession(module, handle) : null;
+  }
+
+  /**
+   * 양쪽 텍스트 조각을 넣고 그동안 확정된 row 반환
+   */
+  feed(baseChunk: string, compareChunk: string): OptimizedWasmResult {
+    const module = this.module;
+
+    const memAllocStart = performance.now();
+    const baseBytes = this.encoder.encode(baseChunk);
+    const compareBytes = this.encoder.encode(compareChunk);
+    const pool = ensureMemoryPool(module, baseBytes.length + 1, compareBytes.length + 1);
+    module.HEAPU8.set(baseBytes, pool.baseBuffer);
+    module.HEAPU8.set(compareBytes, pool.compareBuffer);
+    const memAllocTime = performance.now() - memAllocStart;
+
+    const algorithmStart = performance.now();
+    module._diff_stream_feed_base!(this.handle, pool.baseBuffer, baseBytes.length);
+    module._diff_stream_feed_compare!(this.handle, pool.compareBuffer, compareBytes.length);
+    const pureAlgorithmTime = performance.now() - algorithmStart;
+
+    return this.drain(memAllocTime, pureAlgorithmTime);
+  }
+
+  /**
+   * 입력 끝: 남은 줄을 모두 처리하고 마지막 row 반환
+   */
+  finish(): OptimizedWasmResult {
+    const algorithmStart = performance.now();
+    this.module._diff_stream_finish!(this.handle);
+    const pureAlgorithmTime = performance.now() - algorithmStart;
+
+    return this.drain(0, pureAlgorithmTime);
+  }
+
+  destroy(): void {
+    if (this.handle) {
+      this.module._diff_stream_destroy!(this.handle);
+      this.handle = 0;
+    }
+  }
+
+  private drain(memAllocTime: number, pureAlgorithmTime: number): OptimizedWasmResult {
+    const strConvertStart = performance.now();
+    const resultStr = readStringFromWasm(this.module, this.module._diff_stream_drain!(this.handle));
+    const strConvertTime = performance.now() - strConvertStart;
+
+    const jsonParseStart = performance.now();
+    const response = JSON.parse(resultStr) as WasmDiffResponse;
+    const jsonParseTime = performance.now() - jsonParseStart;
+
+    return {
+      response,
+      pureAlgorithmTime,
+      overhead: {
+        memoryAlloc: memAllocTime,
+        stringConvert: strConvertTime,
+        jsonParse: jsonParseTime,
+        binaryDecode: 0,
+      },
+    };
+  }
+}
+
+/**
+ * C++ 기준 파일 인덱스 (diff_index_* 를 내보낸 빌드에서만 사용 가능, cpp/src/base_index.hpp)
+ * - 기준 텍스트를 한 번만 나누고 해시해 두고, 비교 텍스트만 넣어 diff
+ * - 같은 비교 텍스트가 다시 들어오면 C++ 쪽에 기억해 둔 결과를 그대로 돌려줌
+ * - 여러 비교 텍스트를 한 번에 넣으면 diff 스레드 수만큼 나눠 처리
+ */
+export class WasmBaseIndex {
+  private readonly module: WasmModule;
+  private handle: number;
+  private readonly encoder = new TextEncoder();
+  readonly baseText: string;
+  readonly optionsKey: string;
+
+  private constructor(module: WasmModule, handle: number, baseText: string, optionsKey: string) {
+    this.module = module;
+    this.handle = handle;
+    this.baseText = baseText;
+    this.optionsKey = optionsKey;
+  }
+
+  static isAvailable(): boolean {
+    const module = getWasmModule();
+    return !!(module && module._diff_index_create && module._diff_index_run_batch);
+  }
+
+  /**
+   * 인덱스 생성 (기준 텍스트는 C++ 쪽에 복사되므로 풀 버퍼를 그대로 재사용)
+   */
+  static create(baseText: string, options: DiffOptions = {}): WasmBaseIndex | null {
+    const module = getWasmModule();
+    if (!module || !WasmBaseIndex.isAvailable()) {
+      return null;
+    }
+    const algorithm = DIFF_ALGORITHM_CODES[options.algorithm ?? 'myers'];
+    const flags = toDiffFlags(options);
+    const baseBytes = new TextEncoder().encode(baseText);
+    const pool = ensureMemoryPool(module, baseBytes.length + 1, 1);
+    module.HEAPU8.set(baseBytes, pool.baseBuffer);
+    const handle = module._diff_index_create!(pool.baseBuffer, baseBytes.length, algorithm, flags);
+    return handle ? new WasmBaseIndex(module, handle, baseText, `${algorithm}:${flags}:${wasmContext}`) : null;
+  }
+
+  /**
+   * 비교 텍스트 하나를 기준과 비교
+   */
+  diff(compareText: string): OptimizedWasmResult {
+    const module = this.module;
+
+    const memAllocStart = performance.now();
+    const compareBytes = this.encoder.encode(compareText);
+    const pool = ensureMemoryPool(module, 1, compareBytes.length + 1);
+    module.HEAPU8.set(compareBytes, pool.compareBuffer);
+    const memAllocTime = performance.now() - memAllocStart;
+
+    const algorithmStart = performance.now();
+    module._diff_index_run!(this.handle, pool.compareBuffer, compareBytes.length);
+    const pureAlgorithmTime = performance.now() - algorithmStart;
+
+    return this.readResult(0, memAllocTime, pureAlgorithmTime);
+  }
+
+  /**
+   * 비교 텍스트 여러 개를 한 번에 비교 (결과는 입력 순서)
+   */
+  diffBatch(compareTexts: string[]): OptimizedWasmResult[] {
+    const module = this.module;
+    const count = compareTexts.length;
+    if (count === 0) {
+      return [];
+    }
+
+    // 텍스트마다 버퍼를 잡고, 포인터 / 길이 배열을 넘김 (wasm32 포인터는 4바이트)
+    const memAllocStart = performance.now();
+    const encoded = compareTexts.map((text) => this.encoder.encode(text));
+    const tablePtr = module._malloc(count * 8);
+    const textPtrs = encoded.map((bytes) => module._malloc(bytes.length + 1));
+    if (!tablePtr || textPtrs.some((ptr) => !ptr)) {
+      textPtrs.forEach((ptr) => ptr && module._free(ptr));
+      if (tablePtr) module._free(tablePtr);
+      throw new Error('메모리 할당 실패');
+    }
+    encoded.forEach((bytes, i) => module.HEAPU8.set(bytes, textPtrs[i]));
+    const table = new Int32Array(module.HEAPU8.buffer, tablePtr, count * 2);
+    table.set(textPtrs, 0);
+    table.set(encoded.map((bytes) => bytes.length), count);
+    const memAllocTime = performance.now() - memAllocStart;
+
+    try {
+      const algorithmStart = performance.now();
+      module._diff_index_run_batch!(this.handle, tablePtr, tablePtr + count * 4, count);
+      const pureAlgorithmTime = performance.now() - algorithmStart;
+
+      // 측정 시간은 결과 수로 나눠 기록
+      return compareTexts.map((_, i) => this.readResult(i, memAllocTime / count, pureAlgorithmTime / count));
+    } finally {
+      textPtrs.forEach((ptr) => module._free(ptr));
+      module._free(tablePtr);
+    }
+  }
+
+  /**
+   * 기억해 둔 결과로 diff 를 건너뛴 횟수 (누적)
+   */
+  memoHits(): number {
+    return this.module._diff_index_memo_hits?.(this.handle) ?? 0;
+  }
+
+  destroy(): void {
+    if (this.handle) {
+      this.module._diff_index_release!(this.handle);
+      this.handle = 0;
+    }
+  }
+
+  private readResult(i: number, memAllocTime: number, pureAlgorithmTime: number): OptimizedWasmResult {
+    const module = this.module;
+    const strConvertStart = performance.now();
+    const ptr = module._diff_index_result_ptr!(this.handle, i);
+    const size = module._diff_index_result_size!(this.handle, i);
+    if (!ptr) {
+      throw new Error('diff_index_run returned null pointer');
+    }
+    const resultStr = new TextDecoder('utf-8').decode(module.HEAPU8.subarray(ptr, ptr + size));
+    const strConvertTime = performance.now() - strConvertStart;
+
+    const jsonParseStart = performance.now();
+    const response = JSON.parse(resultStr) as WasmDiffResponse;
+    const jsonParseTime = performance.now() - jsonParseStart;
+
+    return {
+      response,
+      pureAlgorithmTime,
+      overhead: {
+        memoryAlloc: memAllocTime,
+        stringConvert: strConvertTime,
+        jsonParse: jsonParseTime,
+        binaryDecode: 0,
+      },
+    };
+  }
+}
+
+/**
+ * baseText 에 대한 인덱스 (같은 기준 / 옵션으로 만든 인덱스가 있으면 그대로 반환)
+ * - 스레드 수 / 예산이 바뀌면 releaseBaseIndex 에서 버려지고 다시 만들어짐
+ */
+export function getWasmBaseIndex(baseText: string, options: DiffOptions = {}): WasmBaseIndex | null {
+  const optionsKey = `${DIFF_ALGORITHM_CODES[options.algorithm ?? 'myers']}:${toDiffFlags(options)}:${wasmContext}`;
+  if (cachedBaseIndex && cachedBaseIndex.baseText === baseText && cachedBaseIndex.optionsKey === optionsKey) {
+    return cachedBaseIndex;
+  }
+  cachedBaseIndex?.destroy();
+  cachedBaseIndex = WasmBaseIndex.create(baseText, options);
+  return cachedBaseIndex;
+}
+
+/**
+ * 필요한 부분만 꺼내 보는 C++ diff 결과 (diff_lazy_* 를 내보낸 빌드에서만, cpp/src/lazy_result.hpp)
+ * - create 때는 줄 diff 와 row 별 op 만 계산하므로 큰 입력도 바로 끝남
+ * - rows(begin, end) 로 화면에 보이는 구간만 JSON 으로 받음
+ *   (replace row 의 토큰 diff 는 처음 요청될 때 계산되고 C++ 쪽에 기억됨)
+ * - 받은 응답의 start 로 parseDiffOutput 이 줄 번호를 이어서 매김
+ */
+export class WasmLazyResult {
+  private readonly module: WasmModule;
+  private handle: number;
+  readonly rowCount: number;
+
+  private constructor(module: WasmModule, handle: number) {
+    this.module = module;
+    this.handle = handle;
+    this.rowCount = module._diff_lazy_row_count!(handle);
+  }
+
+  static isAvailable(): boolean {
+    const module = getWasmModule();
+    return !!(module && module._diff_lazy_create && module._diff_lazy_rows);
+  }
+
+  static create(baseText: string, compareText: string, options: DiffOptions = {}): WasmLazyResult | null {
+    const module = getWasmModule();
+    if (!module || !WasmLazyResult.isAvailable()) {
+      return null;
+    }
+
+    // 두 입력은 C++ 쪽에 복사되므로 풀 버퍼를 그대로 재사용
+    const encoder = new TextEncoder();
+    const baseBytes = encoder.encode(baseText);
+    const compareBytes = encoder.encode(compareText);
+    const pool = ensureMemoryPool(module, baseBytes.length + 1, compareBytes.length + 1);
+    module.HEAPU8.set(baseBytes, pool.baseBuffer);
+    module.HEAPU8.set(compareBytes, pool.compareBuffer);
+
+    const algorithm = DIFF_ALGORITHM_CODES[options.algorithm ?? 'myers'];
+    const handle = module._diff_lazy_create!(
+      pool.baseBuffer,
+      baseBytes.length,
+      pool.compareBuffer,
+      compareBytes.length,
+      algorithm,
+      toDiffFlags(options),
+    );
+    return handle ? new WasmLazyResult(module, handle) : null;
+  }
+
+  /**
+   * row 별 op 복사본 (0 = equal, 1 = delete, 2 = insert, 3 = replace)
+   */
+  ops(): Uint8Array {
+    const ptr = this.module._diff_lazy_ops!(this.handle);
+    return this.module.HEAPU8.slice(ptr, ptr + this.rowCount);
+  }
+
+  /**
+   * 예산에 걸렸으면 그 이유들 (없으면 빈 배열)
+   */
+  degraded(): DegradedReason[] {
+    const bits = this.module._diff_lazy_degraded?.(this.handle) ?? 0;
+    return DEGRADED_REASONS.filter(([bit]) => bits & bit).map(([, reason]) => reason);
+  }
+
+  /**
+   * [begin, end) 번 row (범위는 rowCount 안으로 잘림)
+   */
+  rows(begin: number, end: number): WasmDiffResponse {
+    const module = this.module;
+    const size = module._diff_lazy_rows!(this.handle, begin, end);
+    if (size < 0) {
+      throw new Error('diff_lazy_rows failed');
+    }
+    const ptr = module._diff_lazy_rows_ptr!(this.handle);
+    return JSON.parse(new TextDecoder('utf-8').decode(module.HEAPU8.subarray(ptr, ptr + size))) as WasmDiffResponse;
+  }
+
+  destroy(): void {
+    if (this.handle) {
+      this.module._diff_lazy_release!(this.handle);
+      this.handle = 0;
+    }
+  }
+}
+
+/**
+ * 증분 diff 에서 편집하는 쪽 (C++ INCREMENTAL_SIDE_BASE / INCREMENTAL_SIDE_CHANGED)
+ */
+export type DiffSide = 'base' | 'compare';
+
+/**
+ * 작은 편집 뒤에 바뀐 곳만 다시 비교하는 C++ diff (diff_incremental_* 를 내보낸 빌드에서만,
+ * cpp/src/incremental_diff.hpp)
+ * - rows() 로 처음 전체 row 를 받고 (context 로 접지 않음)
+ * - edit() 마다 편집한 줄 주변 (두 줄 연속 equal 앵커 사이) 만 다시 비교한 patch 를 받음
+ */
+export class WasmIncrementalDiff {
+  private readonly module: WasmModule;
+  private handle: number;
+
+  private constructor(module: WasmModule, handle: number) {
+    this.module = module;
+    this.handle = handle;
+  }
+
+  static isAvailable(): boolean {
+    const module = getWasmModule();
+    return !!(module && module._diff_incremental_create && module._diff_incremental_edit);
+  }
+
+  static create(baseText: string, compareText: string, options: DiffOptions = {}): WasmIncrementalDiff | null {
+    const module = getWasmModule();
+    if (!module || !WasmIncrementalDiff.isAvailable()) {
+      return null;
+    }
+
+    // 두 입력은 C++ 쪽에 복사되므로 풀 버퍼를 그대로 재사용
+    const encoder = new TextEncoder();
+    const baseBytes = encoder.encode(baseText);
+    const compareBytes = encoder.encode(compareText);
+    const pool = ensureMemoryPool(module, baseBytes.length + 1, compareBytes.length + 1);
+    module.HEAPU8.set(baseBytes, pool.baseBuffer);
+    module.HEAPU8.set(compareBytes, pool.compareBuffer);
+
+    const algorithm = DIFF_ALGORITHM_CODES[options.algorithm ?? 'myers'];
+    const handle = module._diff_incremental_create!(
+      pool.baseBuffer,
+      baseBytes.length,
+      pool.compareBuffer,
+      compareBytes.length,
+      algorithm,
+      toDiffFlags(options),
+    );
+    return handle ? new WasmIncrementalDiff(module, handle) : null;
+  }
+
+  get rowCount(): number {
+    return this.module._diff_incremental_row_count!(this.handle);
+  }
+
+  /**
+   * 지금 전체 row (edit() 의 row 번호가 이 목록 기준)
+   */
+  rows(): WasmDiffResponse {
+    const size = this.module._diff_incremental_rows!(this.handle);
+    if (size < 0) {
+      throw new Error('diff_incremental_rows failed');
+    }
+    return this.readResult(size) as WasmDiffResponse;
+  }
+
+  /**
+   * side 쪽 [lineStart, lineEnd) 줄을 text 의 줄로 바꾸고 바뀐 row 만 받음
+   * - text 는 파일과 같은 규칙 (빈 문자열 = 줄 없음, 끝의 '\n' 하나는 줄 끝)
+   */
+  edit(side: DiffSide, lineStart: number, lineEnd: number, text: string): DiffRowPatch {
+    const module = this.module;
+    const bytes = new TextEncoder().encode(text);
+    const pool = ensureMemoryPool(module, 1, bytes.length + 1);
+    module.HEAPU8.set(bytes, pool.compareBuffer);
+
+    const size = module._diff_incremental_edit!(
+      this.handle,
+      side === 'base' ? 0 : 1,
+      lineStart,
+      lineEnd,
+      pool.compareBuffer,
+      bytes.length,
+    );
+    if (size < 0) {
+      throw new Error(`잘못된 편집 범위입니다: ${side} [${lineStart}, ${lineEnd})`);
+    }
+    return this.readResult(size) as DiffRowPatch;
+  }
+
+  destroy(): void {
+    if (this.handle) {
+      this.module._diff_incremental_release!(this.handle);
+      this.handle = 0;
+    }
+  }
+
+  private readResult(size: number): unknown {
+    const ptr = this.module._diff_incremental_result_ptr!(this.handle);
+    return JSON.parse(new TextDecoder('utf-8').decode(this.module.HEAPU8.subarray(ptr, ptr + size)));
+  }
+}
+
+// ------------------------------------------------------------
+// 바이너리 델타 (cpp/src/delta_patch.hpp 의 DFD1)
+// ------------------------------------------------------------
+const DELTA_FLAG_VARINT = 1;
+// diff_delta_apply 의 음수 반환값 (-DeltaStatus)
+const DELTA_ERRORS: Record<number, string> = {
+  [-1]: '델타 형식이 아닙니다',
+  [-2]: '델타를 만든 기준 텍스트와 다릅니다',
+  [-3]: '델타가 손상되었습니다',
+  [-4]: '복원 결과의 검사 값이 다릅니다',
+};
+
+/**
+ * 델타 API 를 내보낸 빌드인지
+ */
+export function isDeltaAvailable(): boolean {
+  const module = getWasmModule();
+  return !!(module && module._diff_delta_encode && module._diff_delta_apply);
+}
+
+/**
+ * baseText 에서 compareText 를 다시 만드는 델타 (같은 줄은 기준의 바이트 범위로만 적힘)
+ * - varint: op 를 varint 로 줄임 (false 면 고정 폭)
+ * - 델타 API 가 없는 빌드면 null
+ */
+export function encodeDeltaWasm(baseText: string, compareText: string, varint: boolean = true): Uint8Array | null {
+  const module = getWasmModule();
+  if (!module || !isDeltaAvailable()) {
+    return null;
+  }
+  const encoder = new TextEncoder();
+  const baseBytes = encoder.encode(baseText);
+  const compareBytes = encoder.encode(compareText);
+  const pool = ensureMemoryPool(module, baseBytes.length + 1, compareBytes.length + 1);
+  module.HEAPU8.set(baseBytes, pool.baseBuffer);
+  module.HEAPU8.set(compareBytes, pool.compareBuffer);
+
+  const size = module._diff_delta_encode!(
+    pool.baseBuffer,
+    baseBytes.length,
+    pool.compareBuffer,
+    compareBytes.length,
+    varint ? DELTA_FLAG_VARINT : 0,
+  );
+  const ptr = module._diff_delta_ptr!();
+  return module.HEAPU8.slice(ptr, ptr + size);
+}
+
+/**
+ * 저장해 둔 델타를 baseText 에 적용해 대상 텍스트 복원
+ * - 기준이 다르거나 델타가 손상되면 예외, 델타 API 가 없는 빌드면 null
+ */
+export function applyDeltaWasm(baseText: string, delta: Uint8Array): string | null {
+  const module = getWasmModule();
+  if (!module || !isDeltaAvailable()) {
+    return null;
+  }
+  const baseBytes = new TextEncoder().encode(baseText);
+  const pool = ensureMemoryPool(module, baseBytes.length + 1, delta.length + 1);
+  module.HEAPU8.set(baseBytes, pool.baseBuffer);
+  module.HEAPU8.set(delta, pool.compareBuffer);
+
+  const size = module._diff_delta_apply!(pool.baseBuffer, baseBytes.length, pool.compareBuffer, delta.length);
+  if (size < 0) {
+    throw new Error(DELTA_ERRORS[size] ?? 'diff_delta_apply failed');
+  }
+  const ptr = module._diff_delta_target_ptr!();
+  return new TextDecoder('utf-8').decode(module.HEAPU8.subarray(ptr, ptr + size));
+}
+
 /**
  * 메모리 풀 해제 (페이지 언로드 시 호출)
  */
 export function releaseMemoryPool(): void {
+  const module = getWasmModule();
+  releaseBaseIndex();
   if (memoryPool) {
-    const module = getWasmModule();
     if (module) {
       module._free(memoryPool.baseBuffer);
       module._free(memoryPool.compareBuffer);
@@ -182,6 +960,75 @@ export function isSharedArrayBufferSupported(): boolean {
   }
 }
 
+let wasmThreadCount = 1;
+
+/**
+ * C++ 병렬 diff 스레드 수 설정
+ * - cross-origin isolated 환경(SharedArrayBuffer 사용 가능)에서만 병렬 처리
+ * - diff_set_threads 가 없는 이전 빌드에서는 항상 1
+ */
+export function configureWasmThreads(): number {
+  const module = getWasmModule();
+  if (!module || !module._diff_set_threads) {
+    return 1;
+  }
+
+  const threads = isSharedArrayBufferSupported() ? Math.max(1, navigator.hardwareConcurrency || 1) : 1;
+  if (threads !== wasmThreadCount) {
+    module._diff_set_threads(threads);
+    wasmThreadCount = threads;
+    // 기준 파일 인덱스는 만들 때의 스레드 수를 쓰므로 다시 만들도록 버림
+    releaseBaseIndex();
+  }
+  return threads;
+}
+
+let wasmBudgetKey = '0:0:0';
+
+/**
+ * C++ 줄 diff 비용 상한 설정 (cpp/src/diff_budget.hpp)
+ * - 상한에 걸린 결과는 유효하지만 최소 diff 가 아닐 수 있고 response.degraded 에 이유가 붙음
+ * - diff_set_budget 이 없는 이전 빌드에서는 무시
+ */
+export function configureWasmBudget(budget: DiffBudget = {}): void {
+  const module = getWasmModule();
+  if (!module || !module._diff_set_budget) {
+    return;
+  }
+
+  const maxCost = budget.maxCost ?? 0;
+  const maxMemoryMb = budget.maxMemoryMb ?? 0;
+  const timeLimitMs = budget.timeLimitMs ?? 0;
+  const key = `${maxCost}:${maxMemoryMb}:${timeLimitMs}`;
+  if (key !== wasmBudgetKey) {
+    module._diff_set_budget(maxCost, maxMemoryMb, timeLimitMs);
+    wasmBudgetKey = key;
+    // 기준 파일 인덱스는 만들 때의 예산을 쓰므로 다시 만들도록 버림
+    releaseBaseIndex();
+  }
+}
+
+let wasmContext = -1;
+
+/**
+ * C++ JSON 결과의 같은 줄 접기 설정 (diff_set_context, 음수 / 없음 = 접지 않음)
+ * - 전체를 한 번에 비교하는 호출에서만 켬 (청크별로 접으면 skip 줄 번호가 청크 기준이 됨)
+ * - 바이너리 결과는 접히지 않으므로 streamDiff* 가 JS 쪽(foldDiffRows)에서 마저 접음
+ * - diff_set_context 가 없는 이전 빌드에서는 무시
+ */
+export function configureWasmContext(context?: number): void {
+  const module = getWasmModule();
+  if (!module || !module._diff_set_context) {
+    return;
+  }
+
+  const lines = context === undefined || context < 0 ? -1 : context;
+  if (lines !== wasmContext) {
+    module._diff_set_context(lines);
+    wasmContext = lines;
+  }
+}
+
 /**
  * 현재 최적화 상태 정보
  */
@@ -190,11 +1037,13 @@ export function getOptimizationStatus(): {
   poolBaseSize: number;
   poolCompareSize: number;
   sharedArrayBufferSupported: boolean;
+  wasmThreads: number;
 } {
   return {
     memoryPoolActive: memoryPool !== null,
     poolBaseSize: memoryPool?.baseBufferSize ?? 0,
     poolCompareSize: memoryPool?.compareBufferSize ?? 0,
     sharedArrayBufferSupported: isSharedArrayBufferSupported(),
+    wasmThreads: wasmThreadCount,
   };
 }
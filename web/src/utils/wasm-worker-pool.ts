@@ -0,0 +1,319 @@
+import type { WasmDiffResponse } from './diff';
+import type { WasmOverheadTiming } from './performance';
+import { DIFF_ALGORITHM_CODES, toDiffFlags, type DiffOptions } from './algorithm';
+import { decodeBinaryResult, isSharedArrayBufferSupported } from './wasm-optimized';
+
+// ------------------------------------------------------------
+// WASM 워커 풀 (메인 스레드 밖에서 청크 diff)
+// ------------------------------------------------------------
+// 워커(web/public/diff-worker.js)마다 WASM 인스턴스를 하나씩 올려 두고 청크를 나눠 맡긴다.
+//   - 입력: 양쪽 텍스트를 SharedArrayBuffer 하나에 UTF-8 로 한 번만 써 두고,
+//           워커에는 청크의 (위치, 길이) 만 보냄 (postMessage 로 텍스트를 복사하지 않음)
+//   - 결과: 워커가 결과 바이트를 ArrayBuffer 로 복사해 transferable 로 넘김
+//   - 남은 청크는 먼저 끝난 워커가 가져가므로 청크 크기가 달라도 고르게 나뉨
+//
+// cross-origin isolated 가 아니면 SharedArrayBuffer 를 쓸 수 없으므로 getWasmWorkerPool() 이
+// null 을 돌려주고, 호출자는 기존처럼 메인 스레드에서 처리한다. 워커가 하나라도 뜨지 않으면
+// 다시 시도하지 않는다.
+// ------------------------------------------------------------
+
+const WORKER_URL = '/diff-worker.js';
+
+// 워커가 WASM 을 올릴 때까지 기다리는 시간
+const WORKER_READY_TIMEOUT_MS = 10000;
+
+// 최대 워커 수 (워커마다 WASM 메모리를 따로 가짐)
+const MAX_WORKERS = 8;
+
+/**
+ * 공유 입력 버퍼 안의 청크 위치 (바이트)
+ */
+export interface WorkerChunkSpan {
+  baseOffset: number;
+  baseLength: number;
+  compareOffset: number;
+  compareLength: number;
+}
+
+/**
+ * 워커 한 번 실행 결과
+ */
+export interface WorkerChunkResult {
+  response: WasmDiffResponse;
+  pureAlgorithmTime: number; // 워커 안에서 잰 순수 C++ 실행 시간
+  overhead: WasmOverheadTiming;
+}
+
+/**
+ * 양쪽 텍스트를 UTF-8 로 담은 공유 버퍼
+ * - base 는 [0, baseLength), compare 는 [baseLength, baseLength + compareLength)
+ */
+export interface SharedDiffInput {
+  buffer: SharedArrayBuffer;
+  bytes: Uint8Array;
+  baseLength: number;
+  compareLength: number;
+}
+
+interface WorkerReply {
+  type: 'ready' | 'failed' | 'result' | 'error';
+  id?: number;
+  message?: string;
+  format?: 'binary' | 'json';
+  buffer?: ArrayBuffer;
+  pureAlgorithmTime?: number;
+  memoryAlloc?: number;
+}
+
+interface PendingJob {
+  id: number;
+  message: Record<string, unknown>;
+  decode: (reply: WorkerReply) => WorkerChunkResult;
+  resolve: (result: WorkerChunkResult) => void;
+  reject: (error: Error) => void;
+}
+
+/**
+ * UTF-8 로 인코딩했을 때의 바이트 수 (TextEncoder 와 같은 규칙, 짝 없는 서로게이트는 U+FFFD 3바이트)
+ */
+function utf8Length(text: string): number {
+  let length = 0;
+  for (let i = 0; i < text.length; i++) {
+    const code = text.charCodeAt(i);
+    if (code < 0x80) {
+      length += 1;
+    } else if (code < 0x800) {
+      length += 2;
+    } else if (code >= 0xd800 && code <= 0xdbff && i + 1 < text.length) {
+      const next = text.charCodeAt(i + 1);
+      if (next >= 0xdc00 && next <= 0xdfff) {
+        length += 4;
+        i++;
+      } else {
+        length += 3;
+      }
+    } else {
+      length += 3;
+    }
+  }
+  return length;
+}
+
+/**
+ * 양쪽 텍스트를 공유 버퍼 하나에 인코딩 (중간 복사본 없이 encodeInto 로 바로 씀)
+ */
+export function createSharedDiffInput(baseText: string, compareText: string): SharedDiffInput {
+  const baseLength = utf8Length(baseText);
+  const compareLength = utf8Length(compareText);
+  const buffer = new SharedArrayBuffer(Math.max(1, baseLength + compareLength));
+  const bytes = new Uint8Array(buffer);
+  const encoder = new TextEncoder();
+  encoder.encodeInto(baseText, bytes.subarray(0, baseLength));
+  encoder.encodeInto(compareText, bytes.subarray(baseLength));
+  return { buffer, bytes, baseLength, compareLength };
+}
+
+/**
+ * bytes[from, to) 안의 줄 시작 위치 (splitLines 와 같은 줄 수, 마지막 원소는 to + 1)
+ * - i 번째 줄은 [starts[i], starts[i + 1] - 1)
+ */
+export function lineByteStarts(bytes: Uint8Array, from: number, to: number): number[] {
+  if (from === to) {
+    return [];
+  }
+  const starts = [from];
+  for (let pos = bytes.indexOf(10, from); pos !== -1 && pos < to; pos = bytes.indexOf(10, pos + 1)) {
+    starts.push(pos + 1);
+  }
+  starts.push(to + 1);
+  return starts;
+}
+
+export class WasmWorkerPool {
+  private readonly workers: Worker[];
+  private readonly idle: Worker[];
+  private readonly queue: PendingJob[] = [];
+  private readonly running = new Map<Worker, PendingJob>();
+  private nextId = 1;
+
+  constructor(workers: Worker[]) {
+    this.workers = workers;
+    this.idle = [...workers];
+    for (const worker of workers) {
+      worker.onmessage = (event: MessageEvent<WorkerReply>) => this.onReply(worker, event.data);
+      worker.onerror = (event) => this.onReply(worker, { type: 'error', message: event.message });
+    }
+  }
+
+  get size(): number {
+    return this.workers.length;
+  }
+
+  /**
+   * 공유 버퍼의 청크 하나를 diff (바쁘면 큐에서 기다렸다가 먼저 빈 워커가 처리)
+   * - baseText / compareText 는 그 청크의 텍스트 (바이너리 결과의 span 을 문자열로 바꿀 때 사용)
+   */
+  diff(
+    input: SharedDiffInput,
+    span: WorkerChunkSpan,
+    baseText: string,
+    compareText: string,
+    options: DiffOptions = {},
+  ): Promise<WorkerChunkResult> {
+    const budget = options.budget ?? {};
+    const id = this.nextId++;
+    const message = {
+      type: 'diff',
+      id,
+      shared: input.buffer,
+      ...span,
+      algorithm: DIFF_ALGORITHM_CODES[options.algorithm ?? 'myers'],
+      flags: toDiffFlags(options),
+      budget: [budget.maxCost ?? 0, budget.maxMemoryMb ?? 0, budget.timeLimitMs ?? 0],
+    };
+    const decode = (reply: WorkerReply): WorkerChunkResult => {
+      const overhead: WasmOverheadTiming = {
+        memoryAlloc: reply.memoryAlloc ?? 0,
+        stringConvert: 0,
+        jsonParse: 0,
+        binaryDecode: 0,
+      };
+      let response: WasmDiffResponse;
+      if (reply.format === 'binary') {
+        const decodeStart = performance.now();
+        const baseBytes = input.bytes.subarray(span.baseOffset, span.baseOffset + span.baseLength);
+        const compareBytes = input.bytes.subarray(span.compareOffset, span.compareOffset + span.compareLength);
+        response = decodeBinaryResult(reply.buffer!, 0, baseBytes, baseText, compareBytes, compareText);
+        overhead.binaryDecode = performance.now() - decodeStart;
+      } else {
+        const strConvertStart = performance.now();
+        const resultStr = new TextDecoder('utf-8').decode(reply.buffer!);
+        overhead.stringConvert = performance.now() - strConvertStart;
+        const jsonParseStart = performance.now();
+        response = JSON.parse(resultStr) as WasmDiffResponse;
+        overhead.jsonParse = performance.now() - jsonParseStart;
+      }
+      return { response, pureAlgorithmTime: reply.pureAlgorithmTime ?? 0, overhead };
+    };
+
+    return new Promise((resolve, reject) => {
+      this.queue.push({ id, message, decode, resolve, reject });
+      this.dispatch();
+    });
+  }
+
+  terminate(): void {
+    for (const worker of this.workers) {
+      worker.terminate();
+    }
+    for (const job of [...this.running.values(), ...this.queue]) {
+      job.reject(new Error('워커 풀이 종료되었습니다'));
+    }
+    this.running.clear();
+    this.queue.length = 0;
+    this.idle.length = 0;
+  }
+
+  private dispatch(): void {
+    while (this.idle.length > 0 && this.queue.length > 0) {
+      const worker = this.idle.pop()!;
+      const job = this.queue.shift()!;
+      this.running.set(worker, job);
+      worker.postMessage(job.message);
+    }
+  }
+
+  private onReply(worker: Worker, reply: WorkerReply): void {
+    const job = this.running.get(worker);
+    if (!job || (reply.id !== undefined && reply.id !== job.id)) {
+      return;
+    }
+    this.running.delete(worker);
+    this.idle.push(worker);
+
+    if (reply.type === 'result') {
+      try {
+        job.resolve(job.decode(reply));
+      } catch (error) {
+        job.reject(error instanceof Error ? error : new Error(String(error)));
+      }
+    } else {
+      job.reject(new Error(reply.message ?? 'diff 워커 처리 실패'));
+    }
+    this.dispatch();
+  }
+}
+
+let poolPromise: Promise<WasmWorkerPool | null> | null = null;
+
+/**
+ * 워커 풀을 쓸 수 있는 환경인지 (cross-origin isolated + Worker)
+ */
+export function isWorkerPoolSupported(): boolean {
+  return typeof Worker !== 'undefined' && isSharedArrayBufferSupported();
+}
+
+/**
+ * 워커 하나를 띄우고 WASM 이 올라올 때까지 기다림 (실패하면 null)
+ */
+function startWorker(index: number): Promise<Worker | null> {
+  let worker: Worker;
+  try {
+    // pthread 워커 이름(em-pthread-*)과 겹치지 않게 이름을 붙임
+    worker = new Worker(WORKER_URL, { name: `diff-worker-${index}` });
+  } catch {
+    return Promise.resolve(null);
+  }
+  return new Promise((resolve) => {
+    const timeoutId = setTimeout(() => {
+      worker.terminate();
+      resolve(null);
+    }, WORKER_READY_TIMEOUT_MS);
+    worker.onmessage = (event: MessageEvent<WorkerReply>) => {
+      clearTimeout(timeoutId);
+      if (event.data.type === 'ready') {
+        resolve(worker);
+      } else {
+        console.debug(`[WASM] diff 워커 ${index} 시작 실패:`, event.data.message);
+        worker.terminate();
+        resolve(null);
+      }
+    };
+    worker.onerror = () => {
+      clearTimeout(timeoutId);
+      worker.terminate();
+      resolve(null);
+    };
+  });
+}
+
+/**
+ * 워커 풀 (처음 부를 때 띄우고 이후 재사용)
+ * - 워커 수: 하드웨어 스레드 수 - 1 (메인 스레드 몫), 1 ~ MAX_WORKERS
+ * - cross-origin isolated 가 아니거나 워커가 하나라도 뜨지 않으면 null
+ */
+export function getWasmWorkerPool(): Promise<WasmWorkerPool | null> {
+  if (!isWorkerPoolSupported()) {
+    return Promise.resolve(null);
+  }
+  if (!poolPromise) {
+    const count = Math.min(MAX_WORKERS, Math.max(1, (navigator.hardwareConcurrency || 2) - 1));
+    poolPromise = Promise.all(Array.from({ length: count }, (_, i) => startWorker(i))).then((workers) => {
+      if (workers.some((worker) => worker === null)) {
+        workers.forEach((worker) => worker?.terminate());
+        return null;
+      }
+      return new WasmWorkerPool(workers as Worker[]);
+    });
+  }
+  return poolPromise;
+}
+
+/**
+ * 워커 풀 종료 (페이지 언로드 시 호출, 다음 getWasmWorkerPool() 에서 다시 띄움)
+ */
+export function releaseWasmWorkerPool(): void {
+  const pending = poolPromise;
+  poolPromise = null;
+  pending?.then((pool) => pool?.terminate());
+}